@@ -0,0 +1,479 @@
+// ============================================================================
+// bench/bench_enforce.cpp
+// enforce() latency / throughput per mode, per outcome and per step size,
+// written as JSON for regression tracking (one record per case).
+//
+// Shapes (envelopes reused from the tests / internal demos):
+//   scalar     : scalar_demo, |S + dS| <= 1
+//   array128   : tests/test_learning_envelope.cpp, ||theta||2 <= 5, theta[0..8) >= 0
+//   adam256    : internal/learning_loop_adam_state_demo.cpp, EnvelopeSpec over
+//                {theta, m, v, ema} with the same radii, gap and step bound
+//   vector1M   : 1M-element std::vector, ||S + dS||2 <= 2, sign prefix 8,
+//                blocked checks (ase/vector_envelope.hpp), enforce_into
+//
+// Outcomes: pass_through, scaled (or projected) after n attempts, neutral.
+// The outcome and attempt count are measured with enforce_outcome before
+// timing, so a changed decision shows up in the JSON, not just a changed time.
+//
+// Usage: bench_enforce [--quick] [--out file.json]   (JSON to stdout by default)
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/envelope_spec.hpp"
+#include "ase/vector_envelope.hpp"
+
+namespace {
+
+volatile double g_sink = 0.0;
+
+// ----------------------------
+// scalar (scalar_demo)
+// ----------------------------
+namespace scalar {
+
+bool is_admissible(const double& S, const double& dS) {
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    const double next = S + dS;
+    return std::isfinite(next) && std::fabs(next) <= 1.0;
+}
+
+double neutral_step() { return 0.0; }
+
+bool scale_step(const double& in, double k, double& out) {
+    if (!std::isfinite(in) || !std::isfinite(k)) return false;
+    out = in * k;
+    return std::isfinite(out);
+}
+
+bool project_step(const double& S, const double& in, double& out) {
+    if (!std::isfinite(S) || !std::isfinite(in)) return false;
+    const double next = std::min(1.0, std::max(-1.0, S + in));
+    out = next - S;
+    return std::isfinite(out);
+}
+
+} // namespace scalar
+
+// ----------------------------
+// array128 (test_learning_envelope)
+// ----------------------------
+namespace array128 {
+
+constexpr std::size_t N = 128;
+constexpr double R = 5.0;
+constexpr std::size_t kSign = 8;
+constexpr double kEps = 1e-12;
+
+using Vec = std::array<double, N>;
+
+bool is_state_valid(const Vec& theta) {
+    return ase::vec::in_l2_ball(theta.data(), N, R + kEps) &&
+           ase::vec::sign_prefix_nonneg(theta.data(), kSign, kEps);
+}
+
+bool is_admissible(const Vec& S, const Vec& dS) {
+    if (!is_state_valid(S) || !ase::vec::all_finite(dS)) return false;
+    Vec next{};
+    return ase::vec::add_into(S, dS, next) && is_state_valid(next);
+}
+
+Vec neutral_step() { return Vec{}; }
+
+bool scale_step(const Vec& in, double k, Vec& out) {
+    return ase::vec::scale_into(in, k, out);
+}
+
+// sign clamp, then radial L2 projection of the next state
+bool project_step(const Vec& S, const Vec& in, Vec& out) {
+    if (!is_state_valid(S)) return false;
+    Vec next{};
+    if (!ase::vec::add_into(S, in, next)) return false;
+    for (std::size_t i = 0; i < kSign; ++i) next[i] = std::max(0.0, next[i]);
+
+    const double n = ase::vec::l2_norm(next);
+    if (!std::isfinite(n)) return false;
+    if (n > R) {
+        for (double& x : next) x *= R / n;
+    }
+    for (std::size_t i = 0; i < N; ++i) out[i] = next[i] - S[i];
+    return ase::vec::all_finite(out);
+}
+
+} // namespace array128
+
+// ----------------------------
+// adam256 (learning_loop_adam_state_demo)
+// ----------------------------
+namespace adam256 {
+
+constexpr std::size_t N = 256;
+
+using Vec = std::array<double, N>;
+
+struct State {
+    Vec theta{};
+    Vec m{};
+    Vec v{};
+    Vec ema{};
+};
+
+ase::EnvelopeSpec<4> make_spec() {
+    const double tol = 1e-12;
+    ase::EnvelopeSpec<4> spec;
+    spec.transition(0, 1.0, 1.0)
+        .transition(1, 0.9, 0.1)
+        .transition(2, 0.999, 0.0, 0.001).clamp_nonneg(2)
+        .transition(3, 0.98, 0.0).feed(3, 0, 0.02)
+        .l2_ball(0, 5.0 + tol)
+        .l2_ball(1, 10.0 + tol)
+        .l2_ball(2, 10.0 + tol)
+        .l2_ball(3, 5.0 + tol)
+        .l2_gap(3, 0, 2.0 + tol)
+        .lower_bound(0, -tol, 8)
+        .lower_bound(2, -tol)
+        .step_linf(0.25 + tol);
+    return spec;
+}
+
+const ase::EnvelopeSpec<4> g_spec = make_spec();
+
+ase::EnvelopeSpec<4>::Channels channels(const State& s) {
+    return {s.theta.data(), s.m.data(), s.v.data(), s.ema.data()};
+}
+
+bool is_admissible(const State& S, const Vec& dtheta) {
+    return g_spec.contains(channels(S), N) && g_spec.admits(channels(S), dtheta.data(), N);
+}
+
+Vec neutral_step() { return Vec{}; }
+
+bool scale_step(const Vec& in, double k, Vec& out) {
+    return ase::vec::scale_into(in, k, out);
+}
+
+// As in the demo: deterministic bisection for the largest admissible k in [0, 1]
+bool project_step(const State& S, const Vec& in, Vec& out) {
+    if (!g_spec.contains(channels(S), N) || !ase::vec::all_finite(in)) return false;
+    if (g_spec.admits(channels(S), in.data(), N)) { out = in; return true; }
+
+    double lo = 0.0, hi = 1.0;
+    Vec cand{};
+    for (int it = 0; it < 24; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        if (!ase::vec::scale_into(in, mid, cand)) return false;
+        (g_spec.admits(channels(S), cand.data(), N) ? lo : hi) = mid;
+    }
+    return ase::vec::scale_into(in, lo, out);
+}
+
+} // namespace adam256
+
+// ----------------------------
+// vector1M (blocked checks over a heap vector)
+// ----------------------------
+namespace vector1m {
+
+constexpr std::size_t N = std::size_t{1} << 20;
+constexpr double R = 2.0;
+
+using Vec = std::vector<double>;
+
+ase::vec::BlockLimits limits() {
+    ase::vec::BlockLimits lim;
+    lim.l2 = R;
+    lim.sign_prefix = 8;
+    return lim;
+}
+
+const ase::vec::BlockLimits g_lim = limits();
+
+bool is_admissible(const Vec& S, const Vec& dS) {
+    return dS.size() == S.size() && ase::vec::next_within_blocked(S.data(), dS.data(), S.size(), g_lim);
+}
+
+Vec neutral_step() { return Vec(N, 0.0); }
+
+bool scale_step(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    return ase::vec::scale_into(in.data(), k, out.data(), in.size());
+}
+
+bool project_step(const Vec& S, const Vec& in, Vec& out) {
+    if (in.size() != S.size()) return false;
+    out.resize(S.size());
+    if (!ase::vec::add_into(S.data(), in.data(), out.data(), S.size())) return false;
+    for (std::size_t i = 0; i < g_lim.sign_prefix; ++i) out[i] = std::max(0.0, out[i]);
+
+    const double n = ase::vec::l2_norm(out.data(), out.size());
+    if (!std::isfinite(n)) return false;
+    const double k = (n > R) ? (R / n) * (1.0 - 1e-12) : 1.0; // margin for rounding in out - S
+    for (std::size_t i = 0; i < S.size(); ++i) out[i] = out[i] * k - S[i];
+    return ase::vec::all_finite(out.data(), out.size());
+}
+
+} // namespace vector1m
+
+// ----------------------------
+// Measurement
+// ----------------------------
+struct Sizing {
+    std::size_t samples; // timed samples per case
+    std::size_t batch;   // enforce calls per sample
+};
+
+struct Timing {
+    double min_ns = 0.0;
+    double median_ns = 0.0;
+    double p90_ns = 0.0;
+    double p99_ns = 0.0;
+    double mean_ns = 0.0;
+    double calls_per_sec = 0.0;
+};
+
+template <class F>
+Timing measure(const F& call, const Sizing& sz) {
+    for (std::size_t i = 0; i < sz.batch; ++i) call(); // warm-up
+
+    std::vector<double> per_call(sz.samples);
+    double total_ns = 0.0;
+    for (std::size_t s = 0; s < sz.samples; ++s) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < sz.batch; ++i) call();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        total_ns += ns;
+        per_call[s] = ns / static_cast<double>(sz.batch);
+    }
+
+    std::sort(per_call.begin(), per_call.end());
+    const auto at = [&](double q) {
+        return per_call[static_cast<std::size_t>(q * static_cast<double>(per_call.size() - 1))];
+    };
+
+    Timing t;
+    t.min_ns = per_call.front();
+    t.median_ns = at(0.5);
+    t.p90_ns = at(0.9);
+    t.p99_ns = at(0.99);
+    t.mean_ns = total_ns / static_cast<double>(sz.samples * sz.batch);
+    t.calls_per_sec = 1e9 / t.mean_ns;
+    return t;
+}
+
+const char* mode_name(ase::Mode m) {
+    switch (m) {
+        case ase::Mode::Reject: return "reject";
+        case ase::Mode::Scale: return "scale";
+        case ase::Mode::Project: return "project";
+    }
+    return "?";
+}
+
+const char* outcome_name(ase::Outcome o) {
+    switch (o) {
+        case ase::Outcome::PassThrough: return "pass_through";
+        case ase::Outcome::Scaled: return "scaled";
+        case ase::Outcome::Projected: return "projected";
+        case ase::Outcome::Neutral: return "neutral";
+    }
+    return "?";
+}
+
+class Report {
+public:
+    explicit Report(std::FILE* out) : out_(out) {}
+
+    void begin(bool quick) {
+        std::fprintf(out_, "{\n  \"benchmark\": \"ase_enforce\",\n  \"vec_isa\": \"%s\",\n", ase::vec::kIsa);
+        std::fprintf(out_, "  \"quick\": %s,\n  \"results\": [", quick ? "true" : "false");
+    }
+
+    void add(const char* shape, std::size_t n, const char* api, ase::Mode mode, const char* input,
+             ase::Outcome kind, unsigned attempts, double k, const Timing& t) {
+        std::fprintf(out_, "%s\n    {\"shape\": \"%s\", \"n\": %zu, \"api\": \"%s\", \"mode\": \"%s\", "
+                           "\"input\": \"%s\", \"outcome\": \"%s\", \"attempts\": %u, \"k\": %.17g, "
+                           "\"ns_min\": %.3f, \"ns_median\": %.3f, \"ns_p90\": %.3f, \"ns_p99\": %.3f, "
+                           "\"ns_mean\": %.3f, \"calls_per_sec\": %.1f}",
+                     first_ ? "" : ",", shape, n, api, mode_name(mode), input, outcome_name(kind), attempts, k,
+                     t.min_ns, t.median_ns, t.p90_ns, t.p99_ns, t.mean_ns, t.calls_per_sec);
+        first_ = false;
+
+        std::fprintf(stderr, "%-9s %-8s %-12s %-12s attempts=%-2u median=%12.1f ns  p99=%12.1f ns\n",
+                     shape, mode_name(mode), input, outcome_name(kind), attempts, t.median_ns, t.p99_ns);
+    }
+
+    void end() { std::fprintf(out_, "\n  ]\n}\n"); }
+
+private:
+    std::FILE* out_;
+    bool first_ = true;
+};
+
+// Inputs: proposals that pass, need scaling (several attempts), or are non-finite
+template <class State, class Step>
+struct Input {
+    const char* name;
+    State S;
+    Step dS;
+};
+
+const ase::Mode kModes[] = {ase::Mode::Reject, ase::Mode::Scale, ase::Mode::Project};
+
+ase::Config config(ase::Mode mode) {
+    ase::Config cfg;
+    cfg.mode = mode;
+    cfg.max_scale_attempts = 16;
+    cfg.scale_factor = 0.5;
+    return cfg;
+}
+
+// enforce(): the value-returning API, for value-type steps
+template <class State, class Step, class Sink>
+void run_by_value(Report& rep, const char* shape, std::size_t n, const ase::Dependencies<State, Step>& deps,
+                  const std::vector<Input<State, Step>>& inputs, const Sizing& sz, const Sink& sink) {
+    for (ase::Mode mode : kModes) {
+        const ase::Engine<State, Step> eng(config(mode), deps);
+        for (const Input<State, Step>& in : inputs) {
+            const ase::EnforceOutcome<Step> o = eng.enforce_outcome(in.S, in.dS);
+            const Timing t = measure([&] { sink(eng.enforce(in.S, in.dS)); }, sz);
+            rep.add(shape, n, "enforce", mode, in.name, o.kind, o.attempts, o.k, t);
+        }
+    }
+}
+
+// enforce_into(): the allocation-free API, for large heap steps
+template <class State, class Step, class Sink>
+void run_into(Report& rep, const char* shape, std::size_t n, const ase::Dependencies<State, Step>& deps,
+              const std::vector<Input<State, Step>>& inputs, const Sizing& sz, const Sink& sink) {
+    for (ase::Mode mode : kModes) {
+        const ase::Engine<State, Step> eng(config(mode), deps);
+        for (const Input<State, Step>& in : inputs) {
+            ase::Scratch<Step> scratch;
+            Step out;
+            ase::Decision d;
+            eng.enforce_into(in.S, in.dS, out, scratch, d);
+
+            const Timing t = measure([&] {
+                eng.enforce_into(in.S, in.dS, out, scratch);
+                sink(out);
+            }, sz);
+            rep.add(shape, n, "enforce_into", mode, in.name, d.kind, d.attempts, d.k, t);
+        }
+    }
+}
+
+void bench_scalar(Report& rep, bool quick) {
+    const ase::Dependencies<double, double> deps{&scalar::is_admissible, &scalar::neutral_step,
+                                                 &scalar::scale_step, &scalar::project_step};
+    const std::vector<Input<double, double>> inputs = {
+        {"pass", 0.1, 0.2},
+        {"over_bound", 0.9, 0.5}, // k <= 0.2 => 0.125 after 4 attempts
+        {"non_finite", 0.0, std::numeric_limits<double>::infinity()},
+    };
+    run_by_value(rep, "scalar", 1, deps, inputs, quick ? Sizing{200, 256} : Sizing{2000, 1024},
+                 [](double x) { g_sink = x; });
+}
+
+void bench_array128(Report& rep, bool quick) {
+    using array128::N;
+    using array128::Vec;
+    const ase::Dependencies<Vec, Vec> deps{&array128::is_admissible, &array128::neutral_step,
+                                           &array128::scale_step, &array128::project_step};
+
+    Vec S{}, pass{}, over{}, bad{};
+    S.fill(0.2);     // ||S|| ≈ 2.26
+    pass.fill(0.01);
+    over.fill(0.5);  // k <= 0.48 => 0.25 after 3 attempts
+    bad.fill(0.01);
+    bad[1] = std::numeric_limits<double>::quiet_NaN();
+
+    const std::vector<Input<Vec, Vec>> inputs = {{"pass", S, pass}, {"over_bound", S, over}, {"non_finite", S, bad}};
+    run_by_value(rep, "array128", N, deps, inputs, quick ? Sizing{100, 64} : Sizing{1000, 256},
+                 [](const Vec& v) { g_sink = v[0]; });
+}
+
+void bench_adam256(Report& rep, bool quick) {
+    using adam256::N;
+    using adam256::State;
+    using adam256::Vec;
+    const ase::Dependencies<State, Vec> deps{&adam256::is_admissible, &adam256::neutral_step,
+                                             &adam256::scale_step, &adam256::project_step};
+
+    State S;
+    S.theta.fill(0.2); // ||theta|| = 3.2
+    S.ema = S.theta;
+    Vec pass{}, over{}, bad{};
+    pass.fill(0.01);
+    over.fill(1.0);    // step bound and theta ball => k = 0.0625 after 5 attempts
+    bad.fill(0.01);
+    bad[0] = std::numeric_limits<double>::infinity();
+
+    const std::vector<Input<State, Vec>> inputs = {{"pass", S, pass}, {"over_bound", S, over}, {"non_finite", S, bad}};
+    run_by_value(rep, "adam256", N, deps, inputs, quick ? Sizing{50, 32} : Sizing{500, 128},
+                 [](const Vec& v) { g_sink = v[0]; });
+}
+
+void bench_vector1m(Report& rep, bool quick) {
+    using vector1m::N;
+    using vector1m::Vec;
+    const ase::Dependencies<Vec, Vec> deps{&vector1m::is_admissible, &vector1m::neutral_step,
+                                           &vector1m::scale_step, &vector1m::project_step};
+
+    const Vec S(N, 0.001); // ||S|| = 1.024
+    Vec bad(N, 0.0005);
+    bad[N / 2] = std::numeric_limits<double>::quiet_NaN();
+
+    const std::vector<Input<Vec, Vec>> inputs = {
+        {"pass", S, Vec(N, 0.0005)},
+        {"over_bound", S, Vec(N, 0.004)}, // k <= 0.24 => 0.125 after 4 attempts
+        {"non_finite", S, bad},
+    };
+    run_into(rep, "vector1M", N, deps, inputs, quick ? Sizing{3, 1} : Sizing{25, 1},
+             [](const Vec& v) { g_sink = v[0]; });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--quick] [--out file.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::FILE* out = path ? std::fopen(path, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    Report rep(out);
+    rep.begin(quick);
+    bench_scalar(rep, quick);
+    bench_array128(rep, quick);
+    bench_adam256(rep, quick);
+    bench_vector1m(rep, quick);
+    rep.end();
+
+    if (path) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,117 @@
+// ============================================================================
+// bench/bench_static_engine.cpp
+// Engine (function-pointer hooks) vs StaticEngine (compile-time hooks)
+// using the scalar_demo hooks: |S + dS| <= 1, neutral = 0, scale = k * dS.
+//
+// Cases:
+//   pass_through : every proposal admissible (1 predicate call)
+//   scale        : every proposal needs scaling (several attempts)
+//   exhausted    : non-finite proposals, Scale falls back to neutral
+// ============================================================================
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/static_engine.hpp"
+
+namespace {
+
+bool is_admissible(const double& S, const double& dS) {
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    constexpr double LIMIT = 1.0;
+    const double next = S + dS;
+    if (!std::isfinite(next)) return false;
+    return std::fabs(next) <= LIMIT;
+}
+
+double neutral_step() { return 0.0; }
+
+bool scale_step(const double& in, double k, double& out) {
+    if (!std::isfinite(in) || !std::isfinite(k)) return false;
+    out = in * k;
+    return std::isfinite(out);
+}
+
+struct ScalarDemoPolicy {
+    static bool is_admissible(const double& S, const double& dS) { return ::is_admissible(S, dS); }
+    static double neutral_step() { return ::neutral_step(); }
+    static bool scale_step(const double& in, double k, double& out) { return ::scale_step(in, k, out); }
+};
+
+constexpr std::size_t kInputs = 4096;
+constexpr std::size_t kRounds = 2000;
+
+template <class Eng>
+double run_ns_per_call(const Eng& eng,
+                       const std::vector<double>& S,
+                       const std::vector<double>& dS,
+                       double& sink)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    double acc = 0.0;
+    for (std::size_t r = 0; r < kRounds; ++r) {
+        for (std::size_t i = 0; i < kInputs; ++i) {
+            acc += eng.enforce(S[i], dS[i]);
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    sink += acc;
+
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / static_cast<double>(kRounds * kInputs);
+}
+
+} // namespace
+
+int main() {
+    ase::Config cfg;
+    cfg.mode = ase::Mode::Scale;
+    cfg.max_scale_attempts = 16;
+    cfg.scale_factor = 0.5;
+
+    ase::Dependencies<double, double> deps;
+    deps.is_admissible = &is_admissible;
+    deps.neutral_step  = &neutral_step;
+    deps.scale_step    = &scale_step;
+
+    const ase::Engine<double, double> dynamic_engine(cfg, deps);
+    const ase::StaticEngine<double, double, ScalarDemoPolicy> static_engine(cfg);
+
+    struct Case {
+        const char* name;
+        double S_base;
+        double dS_base;
+    };
+    const Case cases[] = {
+        {"pass_through", 0.1, 0.2},
+        {"scale",        0.9, 0.5},
+        {"exhausted",    0.0, std::numeric_limits<double>::infinity()},
+    };
+
+    double sink = 0.0;
+    std::printf("%-14s %14s %14s %8s\n", "case", "engine ns/call", "static ns/call", "speedup");
+
+    for (const Case& c : cases) {
+        // Small input-dependent jitter so the calls cannot be hoisted out of the loop.
+        std::vector<double> S(kInputs), dS(kInputs);
+        for (std::size_t i = 0; i < kInputs; ++i) {
+            const double j = 1e-6 * static_cast<double>(i % 97);
+            S[i]  = c.S_base - j;
+            dS[i] = c.dS_base + j;
+        }
+
+        const double t_dyn = run_ns_per_call(dynamic_engine, S, dS, sink);
+        const double t_sta = run_ns_per_call(static_engine, S, dS, sink);
+
+        std::printf("%-14s %14.2f %14.2f %7.2fx\n", c.name, t_dyn, t_sta, t_dyn / t_sta);
+    }
+
+    // Keep results observable
+    std::printf("checksum=%.6f\n", sink);
+    return 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace ase {
 
@@ -11,23 +13,159 @@ enum class Mode : std::uint8_t {
     Project = 2
 };
 
+// Scale-mode search strategy over k in (0, 1] (Specification §6.3)
+enum class ScaleSearch : std::uint8_t {
+    // k = 1, f, f^2, ... ; first admissible candidate wins
+    Geometric = 0,
+    // Bisection of [0, 1]; largest admissible k found within scale_tolerance
+    Bisection = 1
+};
+
+// Outcome of one enforcement (Specification §5.2–§5.5)
+enum class Outcome : std::uint8_t {
+    PassThrough = 0, // proposed step was admissible
+    Scaled      = 1, // Scale mode produced an admissible k·ΔS
+    Projected   = 2, // Project mode produced an admissible projection
+    Neutral     = 3  // fail-closed / rejected: neutral step emitted
+};
+
+// Integrator hook failure observed during an enforcement (Specification §11.1)
+enum class HookFailure : std::uint8_t {
+    Missing   = 0, // critical hook not provided
+    Exception = 1, // hook threw; contained at the boundary (Specification §11.3)
+    Transform = 2, // scale_step / project_step reported no output
+    Evaluation = 3, // host reported a failed evaluation (Engine::resume, is_admissible_batch)
+    Unsupported = 4 // Config the entry point cannot run (enforce_async above kMaxAsyncScaleAttempts)
+};
+
+// Integrator hook as reported to a tracer (see NullTracer, ase/trace.hpp)
+enum class Hook : std::uint8_t {
+    IsAdmissible       = 0, // is_admissible or is_admissible_ctx
+    IsAdmissibleBatch  = 1,
+    Prepare            = 2,
+    SolveScale         = 3,
+    ScaleStep          = 4,
+    IsAdmissibleScaled = 5,
+    ProjectStep        = 6,
+    NeutralStep        = 7, // once, when the Engine is constructed
+    AdmissibleStage    = 8, // one stage of Dependencies::stages
+    IsAdmissibleCandidates = 9 // speculative scale candidates (Config::speculative_scale)
+};
+
+// Default statistics sink: every notification is an empty inline function
+// and Engine skips them entirely, so stats-free builds are unchanged.
+// A sink type provides the same two members (see ase/stats.hpp).
+struct NullStats final {
+    void on_enforce(Outcome, std::size_t /*scale_attempts*/) noexcept {}
+    void on_hook_failure(HookFailure) noexcept {}
+};
+
+// Default tracer: brackets every integrator hook call with begin / end.
+// attempt is the number of scale candidates built so far (0 for the
+// proposal itself, i while building / checking the i-th candidate). Like
+// NullStats, Engine skips it entirely, so trace-free builds are unchanged.
+// A tracer type provides the same two members (see ase/trace.hpp).
+struct NullTracer final {
+    void on_hook_begin(Hook, std::size_t /*attempt*/) noexcept {}
+    void on_hook_end(Hook, std::size_t /*attempt*/) noexcept {}
+};
+
+// What one enforcement did, so hosts can branch without scanning the step.
+// Observability only: the effective Step remains the single value the host
+// applies (Integration Constraints §2.1).
+//   k        : 1 for PassThrough / Projected, the accepted factor for Scaled,
+//              0 for Neutral
+//   attempts : scale candidates built (saturates at 255)
+//   is_neutral() : the step is the Engine's neutral step; a host whose
+//              neutral step is a no-op may skip applying it
+struct Decision final {
+    Outcome kind = Outcome::Neutral;
+    double k = 0.0;
+    std::uint8_t attempts = 0;
+
+    bool is_neutral() const noexcept { return kind == Outcome::Neutral; }
+};
+
+template <class Step>
+struct EnforceOutcome final {
+    Step step;
+    Outcome kind = Outcome::Neutral;
+    double k = 0.0;
+    std::uint8_t attempts = 0;
+
+    bool is_neutral() const noexcept { return kind == Outcome::Neutral; }
+};
+
 // Fixed configuration (Specification §6.1, Design §6)
 struct Config final {
     Mode mode = Mode::Reject;
 
     // Scale-mode bounds (Specification §9 bounded execution)
-    std::size_t max_scale_attempts = 16; // explicit bound
-    double scale_factor = 0.5;           // monotonic toward 0
+    std::size_t max_scale_attempts = 16; // explicit bound (both strategies)
+    double scale_factor = 0.5;           // monotonic toward 0 (Geometric)
+
+    ScaleSearch scale_search = ScaleSearch::Geometric;
+    double scale_tolerance = 1e-3;       // bracket width that ends Bisection
+
+    // Speculative geometric search (cold starts only, needs
+    // Dependencies::is_admissible_candidates): the grid k = 1, f, f^2, ...
+    // is fixed, so candidates are built speculative_chunk<Step>() at a time
+    // and checked together; the first admissible in grid order wins. Same
+    // step and k as the sequential search; attempts counts every candidate
+    // built. Steps too large for a chunk of two run the sequential search.
+    bool speculative_scale = false;
+};
+
+// Candidates built and checked together by a speculative search: at most
+// kSpeculativeChunk, and at most kSpeculativeStackBytes of Step storage on
+// the stack (bounded stack, Specification §9.4)
+constexpr std::size_t kSpeculativeChunk = 16;
+constexpr std::size_t kSpeculativeStackBytes = 4096;
+
+template <class Step>
+constexpr std::size_t speculative_chunk() noexcept {
+    return kSpeculativeStackBytes / sizeof(Step) < kSpeculativeChunk ? kSpeculativeStackBytes / sizeof(Step)
+                                                                      : kSpeculativeChunk;
+}
+
+// Host-owned warm start for Scale mode: typically the k accepted for the
+// previous proposal (Decision::k). The engine keeps no state between calls
+// (Specification §4.5); the output is a deterministic function of
+// (S, ΔS, hint). A hint outside (0, 1) (or NaN) means a cold search.
+struct ScaleHint final {
+    double k = 1.0;
+};
+
+// One stage of a staged admissibility predicate (Dependencies::stages).
+//   cost          : relative evaluation cost; stages run cheapest first
+//                   (ties keep their listed order)
+//   monotone_in_k : check(S, dS) implies check(S, k·dS) for every k in [0, 1]
+//                   (finiteness, L∞ / L2 bounds around 0, ...). Within one
+//                   Scale-mode enforcement such a stage is not re-run for a
+//                   candidate whose k is at most one it already held at.
+template <class State, class Step>
+struct AdmissibilityStage final {
+    bool (*check)(const State& S, const Step& dS) = nullptr;
+    double cost = 1.0;
+    bool monotone_in_k = false;
 };
 
+// Bounded stage list (Specification §9.4)
+constexpr std::size_t kMaxAdmissibilityStages = 8;
+
+// Default per-call context type: no split-phase admissibility.
+struct NoContext final {};
+
 // Domain dependencies are injected (Design §5.4, Implementation Notes §4–6)
 // IMPORTANT: API boundary returns ONLY Step (Integration Constraints §2.1)
-template <class State, class Step>
+template <class State, class Step, class Context = NoContext>
 struct Dependencies final {
     // Admissibility predicate: deterministic, stateless, local (Specification §7)
+    // May be null only when the split-phase pair below is provided.
     bool (*is_admissible)(const State&, const Step&) = nullptr;
 
-    // Neutral step provider: deterministic no-op (Specification §10)
+    // Neutral step provider: deterministic no-op (Specification §10).
+    // Constant by contract, so Engine calls it once, at construction.
     Step (*neutral_step)() = nullptr;
 
     // Step scaling: deterministic, side-effect free (used only in Scale mode)
@@ -37,129 +175,1291 @@ struct Dependencies final {
     // Step projection: deterministic, at most once (used only in Project mode)
     // Returns true if out is produced, false => treated fail-closed.
     bool (*project_step)(const State& S, const Step& in, Step& out) = nullptr;
+
+    // Optional batched admissibility predicate (used only by enforce_batch).
+    // Writes admissible(S[i], dS[i]) into out[i] for i < n; MUST agree with
+    // the full predicate (stages, then is_admissible / is_admissible_ctx)
+    // element by element. The stages are re-run on every pair it admits, so
+    // a hook that skips them never passes through a step a stage rejects.
+    // Returns false => every pair in the batch is treated as an evaluation
+    // failure (fail-closed).
+    bool (*is_admissible_batch)(const State* S, const Step* dS, bool* out, std::size_t n) = nullptr;
+
+    // Optional split-phase admissibility (Specification §7.1, §7.3).
+    // prepare(S, ctx) runs once per enforcement and may cache invariants of S
+    // (norms, validity); is_admissible_ctx(S, ctx, dS) then replaces
+    // is_admissible for every candidate of that enforcement. The context is
+    // default-constructed per call and discarded on return, so no information
+    // crosses calls. prepare returning false => fail-closed (neutral); it MUST
+    // only do so when no step is admissible at S. Both hooks or neither.
+    bool (*prepare)(const State& S, Context& ctx) = nullptr;
+    bool (*is_admissible_ctx)(const State& S, const Context& ctx, const Step& dS) = nullptr;
+
+    // Optional closed-form scale solver (used only in Scale mode).
+    // Writes a candidate k_max in (0, 1) (e.g. the analytic boundary of a
+    // norm-ball envelope). The engine verifies scale_step(proposed, k_max)
+    // with one admissibility evaluation and falls back to the configured
+    // search only if that fails; a wrong solver costs one extra evaluation,
+    // never an inadmissible step. Returns false => no candidate (fallback).
+    bool (*solve_scale)(const State& S, const Step& proposed, double& k_max) = nullptr;
+
+    // Optional lazy scaled admissibility (used only in Scale mode).
+    // is_admissible_scaled(S, base, k) MUST equal the admissibility of the
+    // step scale_step(base, k) builds, for every k where scale_step succeeds.
+    // With it, scale candidates are evaluated without being built: only the
+    // accepted k is materialized (one scale_step) and verified (one
+    // evaluation with the regular predicate). A hook that disagrees with the
+    // materialized step is treated fail-closed (neutral), never as an
+    // inadmissible output.
+    bool (*is_admissible_scaled)(const State& S, const Step& base, double k) = nullptr;
+
+    // Optional staged admissibility (Specification §7): an array of at most
+    // kMaxAdmissibilityStages stages, owned by the host and alive as long as
+    // the Engine. A step is admissible iff every stage holds AND the regular
+    // predicate (is_admissible / is_admissible_ctx, if set) holds; that
+    // predicate runs last, after all stages. Evaluation stops at the first
+    // failing stage. With stages, is_admissible may be null. A malformed
+    // list (too long, null check) makes every enforcement fail closed.
+    const AdmissibilityStage<State, Step>* stages = nullptr;
+    std::size_t stage_count = 0;
+
+    // Optional admissibility of n candidate steps at one S (used only by
+    // Config::speculative_scale). Writes admissible(S, dS[i]) into out[i]
+    // for i < n; MUST agree with the full predicate (stages, then
+    // is_admissible / is_admissible_ctx) candidate by candidate. May spread
+    // the candidates over a thread team or SIMD lanes. Returns false =>
+    // every candidate is treated as an evaluation failure (fail-closed).
+    bool (*is_admissible_candidates)(const State& S, const Step* dS, bool* out, std::size_t n) = nullptr;
+
+    // Optional certified projection (used only in Project mode; replaces
+    // project_step when set). Writes the projection of in into out and sets
+    // certified when out is admissible at S by construction, e.g. an exact
+    // kernel of ase/projection.hpp whose set is the admissible set. A
+    // certified output is returned without the post-projection evaluation,
+    // so certified MUST imply the full predicate; certified == false => out
+    // is evaluated like a project_step output. Returns false => no output
+    // (fail-closed).
+    bool (*project_step_certified)(const State& S, const Step& in, Step& out, bool& certified) = nullptr;
 };
 
-// ASE core engine: stateless per call, bounded, deterministic (Specification §4, §9)
+// Caller-owned working storage for Engine::enforce_into (Specification §9.4).
+// Reused across attempts and across calls; holds no information between calls
+// that can influence any output (Specification §4.5).
+template <class Step>
+struct Scratch final {
+    Step candidate{}; // per-attempt scaled / projected candidate
+    Step probe{};     // Bisection probe (untouched by Geometric / Project)
+};
+
+namespace detail {
+
+enum class Eval : std::uint8_t { Failed, Admissible, Inadmissible };
+
+// Per-call bookkeeping (observability only; never influences the output)
+struct Tally {
+    std::size_t attempts = 0;  // scale candidates built
+    double candidate_k = 1.0;  // k of the step being evaluated; <= 0 => not a scaled candidate
+    double stage_k[kMaxAdmissibilityStages] = {}; // largest k each monotone stage held at (0 => none)
+    double k = 1.0;            // scale factor of the accepted candidate
+    bool failed = false;       // a hook failure ended the enforcement
+    HookFailure failure = HookFailure::Missing;
+
+    void fail(HookFailure kind) noexcept {
+        failed = true;
+        failure = kind;
+    }
+};
+
+// Move an accepted candidate into caller storage. Trivially copyable steps are
+// copied; others are swapped so buffers (e.g. std::vector capacity) stay with
+// the scratch and are reused by the next call.
+template <class Step>
+void commit_candidate(Step& out, Step& candidate) noexcept {
+    if constexpr (std::is_trivially_copyable<Step>::value) {
+        out = candidate;
+    } else {
+        using std::swap;
+        swap(out, candidate);
+    }
+}
+
+// A hint inside (0, 1) changes where a search starts; anything else is cold
+inline bool usable_hint(double hint) noexcept {
+    return hint > 0.0 && hint < 1.0;
+}
+
+// Geometric scale search: k = 1, f, f^2, ... (Specification §6.3, §9).
+// scale(k, out) -> bool builds a candidate, eval(candidate) -> Eval checks it.
+// Returns true with the first admissible candidate in result.
+// k_accepted receives the scale factor of the returned candidate.
+template <class Step, class ScaleFn, class EvalFn>
+bool search_geometric(const Config& cfg, Step& result, double& k_accepted, ScaleFn&& scale, EvalFn&& eval) {
+    double k = 1.0; // start from 1.0 (Specification §6.3)
+    for (std::size_t i = 0; i < cfg.max_scale_attempts; ++i) {
+        if (!scale(k, result)) {
+            // Transform failure => neutral (fail-closed)
+            return false;
+        }
+
+        switch (eval(result)) {
+            case Eval::Admissible:   k_accepted = k; return true;
+            case Eval::Failed:       return false;
+            case Eval::Inadmissible: break;
+        }
+
+        // monotonic toward 0 (Specification §6.3)
+        k *= cfg.scale_factor;
+    }
+
+    // Bounded attempts exhausted => neutral (Specification §5.4)
+    return false;
+}
+
+// Warm-started geometric search on the same grid k = f^j (same values,
+// bit for bit, as the cold search). Starts at the largest grid point <= hint:
+// if admissible, climbs toward 1 while candidates stay admissible (so k can
+// recover after a spike), otherwise descends as the cold search does.
+// At most max_scale_attempts candidates in total, over the same k range as
+// the cold search; k = 1 is never rebuilt.
+// probe holds the climbing candidate while result keeps the accepted one.
+template <class Step, class ScaleFn, class EvalFn>
+bool search_geometric_warm(const Config& cfg, Step& result, Step& probe, double& k_accepted, double hint,
+                           ScaleFn&& scale, EvalFn&& eval) {
+    const double f = cfg.scale_factor;
+    const auto grid = [f](std::size_t j) {
+        double k = 1.0;
+        for (std::size_t i = 0; i < j; ++i) k *= f;
+        return k;
+    };
+
+    std::size_t j = 0;
+    if (f > 0.0 && f < 1.0) {
+        for (double k = 1.0; j + 1 < cfg.max_scale_attempts && k > hint; ++j) k *= f;
+    }
+    if (j == 0) return search_geometric(cfg, result, k_accepted, scale, eval);
+
+    std::size_t attempts = 1;
+    double k = grid(j);
+    if (!scale(k, result)) return false;
+
+    switch (eval(result)) {
+        case Eval::Failed:
+            return false;
+
+        case Eval::Admissible:
+            k_accepted = k;
+            for (; j > 1 && attempts < cfg.max_scale_attempts; ++attempts) {
+                const double up = grid(j - 1);
+                if (!scale(up, probe)) return false;
+                switch (eval(probe)) {
+                    case Eval::Admissible:   break;
+                    case Eval::Inadmissible: return true;
+                    case Eval::Failed:       return false;
+                }
+                commit_candidate(result, probe);
+                k_accepted = up;
+                --j;
+            }
+            return true;
+
+        case Eval::Inadmissible:
+            break;
+    }
+
+    // Never below the cold search's smallest k = f^(max_scale_attempts - 1)
+    for (; attempts < cfg.max_scale_attempts && j + 1 < cfg.max_scale_attempts; ++attempts, ++j) {
+        k *= f;
+        if (!scale(k, result)) return false;
+        switch (eval(result)) {
+            case Eval::Admissible:   k_accepted = k; return true;
+            case Eval::Failed:       return false;
+            case Eval::Inadmissible: break;
+        }
+    }
+    return false;
+}
+
+// Bisection scale search over [0, 1] (k = 1 is already known inadmissible).
+// At most max_scale_attempts candidates; stops once the bracket is narrower
+// than scale_tolerance. Returns true with the largest admissible probe in
+// result; every returned candidate has been verified admissible, so a
+// predicate that is not monotone in k still cannot yield an inadmissible step.
+// A usable hint is probed first, in place of the first midpoint.
+template <class Step, class ScaleFn, class EvalFn>
+bool search_bisection(const Config& cfg, Step& result, Step& probe, double& k_accepted,
+                      ScaleFn&& scale, EvalFn&& eval, double hint = 1.0) {
+    double lo = 0.0;
+    double hi = 1.0;
+    bool found = false;
+
+    for (std::size_t i = 0; i < cfg.max_scale_attempts && (hi - lo) > cfg.scale_tolerance; ++i) {
+        const double mid = (i == 0 && usable_hint(hint)) ? hint : lo + 0.5 * (hi - lo);
+        if (!scale(mid, probe)) return false;
+
+        switch (eval(probe)) {
+            case Eval::Admissible:
+                lo = mid;
+                found = true;
+                commit_candidate(result, probe);
+                break;
+            case Eval::Inadmissible:
+                hi = mid;
+                break;
+            case Eval::Failed:
+                return false;
+        }
+    }
+
+    if (found) k_accepted = lo;
+    return found;
+}
+
+// Tracer pointer held by Engine; empty for NullTracer, so a trace-free
+// Engine keeps its layout and code generation.
+template <class Tracer>
+struct TracerSlot {
+    explicit TracerSlot(Tracer* tracer) noexcept : tracer_(tracer) {}
+    Tracer* tracer_;
+};
+
+template <>
+struct TracerSlot<NullTracer> {
+    explicit TracerSlot(NullTracer*) noexcept {}
+};
+
+} // namespace detail
+
+// Verdict a host reports for the pending candidate of an asynchronous
+// enforcement (Engine::resume): what is_admissible would return for it, or
+// Failed if the evaluation itself failed (fail-closed, Specification §11).
+enum class Verdict : std::uint8_t { Admissible, Inadmissible, Failed };
+
+// Largest max_scale_attempts the asynchronous path supports: it keeps the
+// verdicts of one enforcement in a fixed bitset (Specification §9.4).
+// A Scale-mode Config above it fails closed on that path (neutral, recorded
+// as HookFailure::Unsupported), where enforce would search normally.
+constexpr std::size_t kMaxAsyncScaleAttempts = 256;
+
+// Caller-owned state of one asynchronous enforcement (Engine::enforce_async).
+// Holds the pending candidate and the verdicts reported so far; reusable
+// across calls, like Scratch. Until done(), the S and proposal given to
+// enforce_async must stay alive and unchanged, and so must the Engine.
 template <class State, class Step>
-class Engine final {
+class AsyncEnforcement final {
+public:
+    // true once the outcome is known (also before the first enforce_async)
+    bool done() const noexcept { return phase_ == Phase::Done; }
+
+    // The pair awaiting a verdict (while !done())
+    const State& state() const noexcept { return *S_; }
+    const Step& candidate() const noexcept { return phase_ == Phase::Proposal ? *proposed_ : candidate_; }
+
+    // ΔS' and its record, once done()
+    const Step& step() const noexcept { return *result_; }
+    const Decision& decision() const noexcept { return decision_; }
+
+private:
+    template <class, class, class, class, class>
+    friend class Engine;
+
+    enum class Phase : std::uint8_t { Done, Proposal, Solved, Search, Project };
+
+    bool logged(std::size_t i) const noexcept { return (log_[i / 64] >> (i % 64)) & 1u; }
+
+    void log(bool admissible) noexcept {
+        const std::uint64_t bit = std::uint64_t{1} << (verdicts_ % 64);
+        if (admissible) log_[verdicts_ / 64] |= bit;
+        else log_[verdicts_ / 64] &= ~bit;
+        ++verdicts_;
+    }
+
+    const State* S_ = nullptr;
+    const Step* proposed_ = nullptr;
+    const Step* result_ = nullptr;
+    Phase phase_ = Phase::Done;
+    double hint_ = 1.0;
+    double k_ = 0.0;          // scale factor of candidate_
+    double accepted_k_ = 0.0; // scale factor of accepted_
+    std::size_t verdicts_ = 0; // search verdicts in log_
+    std::uint64_t log_[kMaxAsyncScaleAttempts / 64] = {};
+    detail::Tally tally_;
+    Decision decision_;
+    Step candidate_{};
+    Step accepted_{}; // last admissible search candidate
+};
+
+// ASE core engine: stateless per call, bounded, deterministic (Specification §4, §9)
+//
+// Stats: optional observability sink (NullStats => compiled out). The sink
+// only receives notifications; it is never read by the engine, so outputs
+// are identical with and without it (Specification §4.5, §12.1).
+// Tracer: optional hook-call tracer (NullTracer => compiled out), same
+// observability-only contract as Stats.
+template <class State, class Step, class Context = NoContext, class Stats = NullStats,
+          class Tracer = NullTracer>
+class Engine final : private detail::TracerSlot<Tracer> {
 public:
-    Engine(const Config& cfg, const Dependencies<State, Step>& deps) noexcept
-        : cfg_(cfg), deps_(deps) {}
+    Engine(const Config& cfg, const Dependencies<State, Step, Context>& deps,
+           Stats* stats = nullptr, Tracer* tracer = nullptr) noexcept
+        : detail::TracerSlot<Tracer>(tracer), cfg_(cfg), deps_(deps), stats_(stats) {
+        order_stages();
+        cache_neutral();
+    }
+
+    // The neutral step every fail-closed outcome emits, built once at
+    // construction (Specification §10). Step{} if neutral_step is missing
+    // or threw; the Engine then fails closed on every call.
+    const Step& neutral() const noexcept { return neutral_; }
 
     // Canonical enforcement entry point:
     // Input: (S, ΔS)  Output: ΔS' only (Integration Constraints §2.1)
     Step enforce(const State& S, const Step& proposed) const noexcept {
+        Decision decision;
+        return run(S, proposed, decision);
+    }
+
+    // Warm-started enforcement: in Scale mode the search starts near hint.k
+    // (see ScaleHint) instead of at k = 1, still within max_scale_attempts.
+    // Other modes ignore the hint.
+    Step enforce(const State& S, const Step& proposed, ScaleHint hint) const noexcept {
+        Decision decision;
+        return run(S, proposed, decision, hint.k);
+    }
+
+    // Enforcement with its decision record (outcome kind, k, attempts).
+    // step is exactly enforce(S, proposed).
+    EnforceOutcome<Step> enforce_outcome(const State& S, const Step& proposed) const noexcept {
+        return enforce_outcome(S, proposed, ScaleHint{});
+    }
+
+    // As above, warm-started; pass result.k back as the next hint.
+    EnforceOutcome<Step> enforce_outcome(const State& S, const Step& proposed, ScaleHint hint) const noexcept {
+        Decision decision;
+        EnforceOutcome<Step> result{run(S, proposed, decision, hint.k)};
+        result.kind = decision.kind;
+        result.k = decision.k;
+        result.attempts = decision.attempts;
+        return result;
+    }
+
+    // In-place enforcement into caller storage: out receives exactly
+    // enforce(S, proposed). Attempts are built in scratch.candidate, so no Step
+    // is constructed on the hot path. out may alias proposed.
+    // Returns true if out is derived from the proposal (pass-through, scaled or
+    // projected), false if the neutral step was emitted.
+    bool enforce_into(const State& S, const Step& proposed, Step& out, Scratch<Step>& scratch) const noexcept {
+        Decision decision;
+        return enforce_into(S, proposed, out, scratch, decision);
+    }
+
+    // As above, also writing the decision record alongside the step.
+    bool enforce_into(const State& S, const Step& proposed, Step& out, Scratch<Step>& scratch,
+                      Decision& decision, ScaleHint hint = {}) const noexcept {
+        detail::Tally tally;
+
+        if (!has_critical_hooks()) {
+            tally.fail(HookFailure::Missing);
+            out = neutral_out(tally, decision);
+            return false;
+        }
+
+        Context ctx{};
+        const Frame f{S, uses_context() ? &ctx : nullptr, tally, hint.k};
+        if (!prepare_frame(f, ctx)) {
+            out = neutral_out(tally, decision);
+            return false;
+        }
+
+        switch (evaluate(f, proposed)) {
+            case Eval::Admissible:
+                if (&out != &proposed) out = proposed;
+                decision = finish(Outcome::PassThrough, tally);
+                return true;
+
+            case Eval::Failed:
+                out = neutral_out(tally, decision);
+                return false;
+
+            case Eval::Inadmissible:
+                break;
+        }
+
+        if (!enforce_inadmissible(f, proposed, scratch.candidate, &scratch.probe)) {
+            out = neutral_out(tally, decision);
+            return false;
+        }
+        detail::commit_candidate(out, scratch.candidate);
+        decision = finish(modified_outcome(), tally);
+        return true;
+    }
+
+    // Batched enforcement over n independent (S[i], ΔS[i]) pairs.
+    // out[i] is exactly enforce(S[i], proposed[i]); hook checks and mode
+    // dispatch happen once per batch. out may alias proposed.
+    // decisions, if non-null, receives n decision records; hints, if
+    // non-null, holds one ScaleHint per element.
+    void enforce_batch(const State* S, const Step* proposed, Step* out, std::size_t n,
+                       Decision* decisions = nullptr, const ScaleHint* hints = nullptr) const noexcept {
+        if (n == 0) return;
+
         // Fail-closed if critical hooks missing
-        if (!deps_.is_admissible || !deps_.neutral_step) {
-            return neutral_safe();
+        if (!has_critical_hooks()) {
+            for (std::size_t i = 0; i < n; ++i) {
+                detail::Tally tally;
+                tally.fail(HookFailure::Missing);
+                Decision d;
+                out[i] = neutral_out(tally, d);
+                if (decisions) decisions[i] = d;
+            }
+            return;
         }
 
-        // 1) Evaluate admissibility of proposed step (Implementation Notes §3.3)
-        bool admissible = false;
-        if (!safe_is_admissible(S, proposed, admissible)) {
-            // Evaluation failure => fail-closed => neutral (Specification §3.5, §11)
-            return neutral_safe();
+        switch (cfg_.mode) {
+            case Mode::Reject:
+                enforce_batch_mode<Mode::Reject>(S, proposed, out, n, decisions, hints);
+                return;
+
+            case Mode::Scale:
+                enforce_batch_mode<Mode::Scale>(S, proposed, out, n, decisions, hints);
+                return;
+
+            case Mode::Project:
+                enforce_batch_mode<Mode::Project>(S, proposed, out, n, decisions, hints);
+                return;
+        }
+
+        // Defensive fail-closed (should not happen)
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = neutral_;
+            if (decisions) decisions[i] = Decision{};
+        }
+    }
+
+    // Asynchronous enforcement, for predicates evaluated elsewhere (an
+    // accelerator queue, a worker pool). The engine never waits: while
+    // !op.done(), the host evaluates (op.state(), op.candidate()) as it likes
+    // and reports the result with resume(op, verdict), which builds the next
+    // candidate or completes op. One thread can keep many enforcements in
+    // flight. Candidates, their order, the attempt bound and every
+    // fail-closed outcome are those of enforce_outcome(S, proposed, hint)
+    // with is_admissible answering (sequential searches: speculative_scale
+    // does not apply). scale_step, project_step / project_step_certified and
+    // solve_scale run inside these calls (a certified projection completes
+    // op without a verdict); Engine's own admissibility hooks (is_admissible,
+    // stages, split-phase, lazy scaled) are not used on this path.
+    void enforce_async(const State& S, const Step& proposed, AsyncEnforcement<State, Step>& op,
+                       ScaleHint hint = {}) const noexcept {
+        op.S_ = &S;
+        op.proposed_ = &proposed;
+        op.result_ = nullptr;
+        op.hint_ = hint.k;
+        op.verdicts_ = 0;
+        op.tally_ = detail::Tally{};
+
+        if (!neutral_ok_) {
+            op.tally_.fail(HookFailure::Missing);
+            return async_neutral(op);
+        }
+        if (cfg_.mode == Mode::Scale && cfg_.max_scale_attempts > kMaxAsyncScaleAttempts) {
+            op.tally_.fail(HookFailure::Unsupported);
+            return async_neutral(op);
+        }
+        op.phase_ = AsyncEnforcement<State, Step>::Phase::Proposal;
+    }
+
+    // Reports the verdict for op.candidate(). No effect once op is done.
+    void resume(AsyncEnforcement<State, Step>& op, Verdict verdict) const noexcept {
+        using Phase = typename AsyncEnforcement<State, Step>::Phase;
+        if (op.done()) return;
+        if (verdict == Verdict::Failed) {
+            op.tally_.fail(HookFailure::Evaluation);
+            return async_neutral(op);
+        }
+        const bool admissible = verdict == Verdict::Admissible;
+
+        switch (op.phase_) {
+            case Phase::Proposal:
+                if (admissible) {
+                    op.result_ = op.proposed_;
+                    return async_finish(op, Outcome::PassThrough);
+                }
+                return async_inadmissible(op);
+
+            case Phase::Solved:
+                if (!admissible) return async_search(op);
+                op.tally_.k = op.k_;
+                op.result_ = &op.candidate_;
+                return async_finish(op, Outcome::Scaled);
+
+            case Phase::Search:
+                op.log(admissible);
+                if (admissible) {
+                    detail::commit_candidate(op.accepted_, op.candidate_);
+                    op.accepted_k_ = op.k_;
+                }
+                return async_search(op);
+
+            case Phase::Project:
+                if (!admissible) return async_neutral(op);
+                op.result_ = &op.candidate_;
+                return async_finish(op, Outcome::Projected);
+
+            case Phase::Done:
+                return;
+        }
+    }
+
+private:
+    // Fixed chunk for batched admissibility results (bounded stack, Specification §9.4)
+    static constexpr std::size_t kBatchChunk = 64;
+
+    static constexpr bool kStats = !std::is_same<Stats, NullStats>::value;
+    static constexpr bool kTrace = !std::is_same<Tracer, NullTracer>::value;
+
+    using Eval = detail::Eval;
+
+    // Inputs of one enforcement; ctx is non-null when the split-phase
+    // predicate is in use, hint is the host's ScaleHint::k. Lives only for
+    // the duration of the call.
+    struct Frame {
+        const State& S;
+        const Context* ctx;
+        detail::Tally& tally;
+        double hint = 1.0;
+    };
+
+    // Ends a traced hook call on every exit, including a throwing hook
+    struct TraceSpan {
+        Tracer* tracer;
+        Hook hook;
+        std::size_t attempt;
+        ~TraceSpan() { tracer->on_hook_end(hook, attempt); }
+    };
+
+    // Every integrator hook is invoked through here. Not noexcept: hook
+    // exceptions propagate to the caller's containment.
+    template <class Fn, class... Args>
+    auto call_hook(Hook hook, std::size_t attempt, Fn fn, Args&&... args) const
+        -> decltype(fn(std::forward<Args>(args)...)) {
+        if constexpr (kTrace) {
+            if (Tracer* const tracer = this->tracer_) {
+                tracer->on_hook_begin(hook, attempt);
+                const TraceSpan span{tracer, hook, attempt};
+                return fn(std::forward<Args>(args)...);
+            }
+        }
+        (void)hook;
+        (void)attempt;
+        return fn(std::forward<Args>(args)...);
+    }
+
+    bool has_critical_hooks() const noexcept {
+        return stages_ok_ && (deps_.is_admissible || uses_context() || stage_count_ > 0) && neutral_ok_;
+    }
+
+    // The neutral step is constant (Specification §10.2): build it once
+    void cache_neutral() noexcept {
+        if (!deps_.neutral_step) return;
+#if defined(__cpp_exceptions)
+        try {
+            neutral_ = call_hook(Hook::NeutralStep, 0, deps_.neutral_step);
+            neutral_ok_ = true;
+        } catch (...) {
+            neutral_ = Step{};
+        }
+#else
+        neutral_ = call_hook(Hook::NeutralStep, 0, deps_.neutral_step);
+        neutral_ok_ = true;
+#endif
+    }
+
+    // Stable insertion sort of the stage list by cost, once per Engine
+    void order_stages() noexcept {
+        stages_ok_ = deps_.stage_count <= kMaxAdmissibilityStages && (deps_.stages || deps_.stage_count == 0);
+        if (!stages_ok_) return;
+
+        stage_count_ = static_cast<std::uint8_t>(deps_.stage_count);
+        for (std::uint8_t i = 0; i < stage_count_; ++i) {
+            if (!deps_.stages[i].check) stages_ok_ = false;
+
+            std::uint8_t j = i;
+            while (j > 0 && deps_.stages[i].cost < deps_.stages[stage_order_[j - 1]].cost) {
+                stage_order_[j] = stage_order_[j - 1];
+                --j;
+            }
+            stage_order_[j] = i;
+        }
+    }
+
+    bool uses_context() const noexcept {
+        return deps_.prepare && deps_.is_admissible_ctx;
+    }
+
+    Outcome modified_outcome() const noexcept {
+        return cfg_.mode == Mode::Project ? Outcome::Projected : Outcome::Scaled;
+    }
+
+    // Single-entry core of enforce() / enforce_outcome()
+    Step run(const State& S, const Step& proposed, Decision& decision, double hint = 1.0) const noexcept {
+        detail::Tally tally;
+
+        // Fail-closed if critical hooks missing
+        if (!has_critical_hooks()) {
+            tally.fail(HookFailure::Missing);
+            return neutral_out(tally, decision);
         }
 
-        if (admissible) {
-            // Pass-through (Specification §5.2)
-            return proposed;
+        Context ctx{};
+        const Frame f{S, uses_context() ? &ctx : nullptr, tally, hint};
+        if (!prepare_frame(f, ctx)) {
+            return neutral_out(tally, decision);
+        }
+
+        // 1) Evaluate admissibility of proposed step (Implementation Notes §3.3)
+        switch (evaluate(f, proposed)) {
+            case Eval::Admissible:
+                // Pass-through (Specification §5.2)
+                decision = finish(Outcome::PassThrough, tally);
+                return proposed;
+
+            case Eval::Failed:
+                // Evaluation failure => fail-closed => neutral (Specification §3.5, §11)
+                return neutral_out(tally, decision);
+
+            case Eval::Inadmissible:
+                break;
         }
 
         // 2) Inadmissible => enforce according to fixed mode (Specification §6.1)
+        Step candidate{};
+        if (!enforce_inadmissible(f, proposed, candidate, nullptr)) {
+            return neutral_out(tally, decision);
+        }
+        decision = finish(modified_outcome(), tally);
+        return candidate;
+    }
+
+    // Closes one enforcement: notifies the stats sink, builds the record.
+    Decision finish(Outcome kind, const detail::Tally& tally) const noexcept {
+        if constexpr (kStats) {
+            if (stats_) {
+                if (tally.failed) stats_->on_hook_failure(tally.failure);
+                stats_->on_enforce(kind, tally.attempts);
+            }
+        }
+
+        Decision d;
+        d.kind = kind;
+        d.k = (kind == Outcome::Scaled) ? tally.k : (kind == Outcome::Neutral ? 0.0 : 1.0);
+        d.attempts = static_cast<std::uint8_t>(tally.attempts < 255 ? tally.attempts : 255);
+        return d;
+    }
+
+    // Assigning from the returned reference reuses the caller's buffers
+    const Step& neutral_out(const detail::Tally& tally, Decision& decision) const noexcept {
+        decision = finish(Outcome::Neutral, tally);
+        return neutral_;
+    }
+
+    void async_finish(AsyncEnforcement<State, Step>& op, Outcome kind) const noexcept {
+        op.decision_ = finish(kind, op.tally_);
+        op.phase_ = AsyncEnforcement<State, Step>::Phase::Done;
+    }
+
+    void async_neutral(AsyncEnforcement<State, Step>& op) const noexcept {
+        op.result_ = &neutral_;
+        async_finish(op, Outcome::Neutral);
+    }
+
+    // Inadmissible proposal => first candidate of the fixed mode
+    void async_inadmissible(AsyncEnforcement<State, Step>& op) const noexcept {
+        using Phase = typename AsyncEnforcement<State, Step>::Phase;
+        switch (cfg_.mode) {
+            case Mode::Reject:
+                return async_neutral(op);
+
+            case Mode::Scale: {
+                if (!deps_.scale_step) {
+                    op.tally_.fail(HookFailure::Missing);
+                    return async_neutral(op);
+                }
+                if (deps_.solve_scale) {
+                    const Frame f{*op.S_, nullptr, op.tally_, op.hint_};
+                    double k = 0.0;
+                    switch (solve_scale_safe(f, *op.proposed_, k)) {
+                        case Eval::Failed:
+                            return async_neutral(op);
+                        case Eval::Admissible:
+                            if (!async_build(op, k)) return async_neutral(op);
+                            op.phase_ = Phase::Solved;
+                            return;
+                        case Eval::Inadmissible:
+                            break;
+                    }
+                }
+                return async_search(op);
+            }
+
+            case Mode::Project: {
+                bool certified = false;
+                if (!project(*op.S_, *op.proposed_, op.candidate_, op.tally_, certified)) return async_neutral(op);
+                if (certified) {
+                    op.result_ = &op.candidate_;
+                    return async_finish(op, Outcome::Projected);
+                }
+                op.tally_.candidate_k = 0.0;
+                op.phase_ = Phase::Project;
+                return;
+            }
+        }
+        async_neutral(op);
+    }
+
+    // Builds the scale candidate for k (one attempt, as in enforce_scale)
+    bool async_build(AsyncEnforcement<State, Step>& op, double k) const noexcept {
+        ++op.tally_.attempts;
+        op.tally_.candidate_k = k;
+        op.k_ = k;
+        if (call_hook(Hook::ScaleStep, op.tally_.attempts, deps_.scale_step, *op.proposed_, k, op.candidate_)) {
+            return true;
+        }
+        op.tally_.fail(HookFailure::Transform);
+        return false;
+    }
+
+    // Replays the configured search over k with the verdicts logged so far;
+    // it stops at the first k without one, which becomes the next candidate.
+    // The searches are deterministic in their verdicts, so the replay takes
+    // the same path as the blocking search.
+    void async_search(AsyncEnforcement<State, Step>& op) const noexcept {
+        std::size_t seen = 0;
+        bool suspended = false;
+        double next = 0.0;
+        const auto scale = [](double k, double& out) {
+            out = k;
+            return true;
+        };
+        const auto eval = [&](const double& k) {
+            if (seen < op.verdicts_) return op.logged(seen++) ? Eval::Admissible : Eval::Inadmissible;
+            suspended = true;
+            next = k;
+            return Eval::Failed;
+        };
+
+        double k = 0.0;
+        double candidate = 0.0;
+        double probe = 0.0;
+        bool found = false;
+        switch (cfg_.scale_search) {
+            case ScaleSearch::Geometric:
+                found = detail::usable_hint(op.hint_)
+                      ? detail::search_geometric_warm(cfg_, candidate, probe, k, op.hint_, scale, eval)
+                      : detail::search_geometric(cfg_, candidate, k, scale, eval);
+                break;
+
+            case ScaleSearch::Bisection:
+                found = detail::search_bisection(cfg_, candidate, probe, k, scale, eval, op.hint_);
+                break;
+        }
+
+        if (suspended) {
+            if (!async_build(op, next)) return async_neutral(op);
+            op.phase_ = AsyncEnforcement<State, Step>::Phase::Search;
+            return;
+        }
+        // Every search returns its most recent admissible candidate
+        if (!found || k != op.accepted_k_) return async_neutral(op);
+        op.tally_.k = k;
+        op.result_ = &op.accepted_;
+        async_finish(op, Outcome::Scaled);
+    }
+
+    // Split-phase prepare (once per enforcement). false => fail-closed.
+    bool prepare_frame(const Frame& f, Context& ctx) const noexcept {
+        if (!f.ctx) return true;
+#if defined(__cpp_exceptions)
+        try {
+            return call_hook(Hook::Prepare, 0, deps_.prepare, f.S, ctx);
+        } catch (...) {
+            f.tally.fail(HookFailure::Exception);
+            return false;
+        }
+#else
+        return call_hook(Hook::Prepare, 0, deps_.prepare, f.S, ctx);
+#endif
+    }
+
+    template <Mode M>
+    void enforce_batch_mode(const State* S, const Step* proposed, Step* out, std::size_t n,
+                            Decision* decisions, const ScaleHint* hints) const noexcept {
+        const bool batched = deps_.is_admissible_batch != nullptr;
+
+        Eval eval[kBatchChunk];
+        bool batch_failed = false;
+        HookFailure batch_failure = HookFailure::Evaluation;
+        // Working buffers per batch, reused by every element
+        Step candidate{};
+        Step probe{};
+
+        for (std::size_t base = 0; base < n; base += kBatchChunk) {
+            const std::size_t m = (n - base < kBatchChunk) ? (n - base) : kBatchChunk;
+
+            // 1) Admissibility of all proposed steps in the chunk
+            if (batched) batch_failed = !evaluate_batch(S + base, proposed + base, eval, m, batch_failure);
+
+            // 2) Per-element outcome under the fixed mode
+            for (std::size_t j = 0; j < m; ++j) {
+                const std::size_t i = base + j;
+
+                detail::Tally tally;
+                Context ctx{};
+                const Frame f{S[i], uses_context() ? &ctx : nullptr, tally, hints ? hints[i].k : 1.0};
+                bool prepared = false;
+
+                Eval e = Eval::Failed;
+                if (batched) {
+                    e = eval[j];
+                    if (batch_failed) tally.fail(batch_failure);
+                    // The pass-through needs the full predicate: stages too
+                    if (e == Eval::Admissible && stage_count_ > 0) e = evaluate_stages(f, proposed[i]);
+                } else if (prepare_frame(f, ctx)) {
+                    prepared = true;
+                    e = evaluate(f, proposed[i]);
+                }
+
+                Decision d;
+                if (e == Eval::Admissible) {
+                    if (&out[i] != &proposed[i]) out[i] = proposed[i];
+                    d = finish(Outcome::PassThrough, tally);
+                } else if (e == Eval::Failed || M == Mode::Reject ||
+                           (!prepared && !prepare_frame(f, ctx)) ||
+                           !enforce_mode<M>(f, proposed[i], candidate, &probe)) {
+                    out[i] = neutral_out(tally, d);
+                } else {
+                    detail::commit_candidate(out[i], candidate);
+                    d = finish(M == Mode::Project ? Outcome::Projected : Outcome::Scaled, tally);
+                }
+                if (decisions) decisions[i] = d;
+            }
+        }
+    }
+
+    // Returns false if the batched predicate failed (every eval[j] is then
+    // Failed); failure receives why: it threw, or it returned false.
+    bool evaluate_batch(const State* S, const Step* dS, Eval* eval, std::size_t m,
+                        HookFailure& failure) const noexcept {
+        bool admissible[kBatchChunk];
+        bool ok = false;
+        failure = HookFailure::Evaluation;
+#if defined(__cpp_exceptions)
+        try {
+            ok = call_hook(Hook::IsAdmissibleBatch, 0, deps_.is_admissible_batch, S, dS, admissible, m);
+        } catch (...) {
+            ok = false;
+            failure = HookFailure::Exception;
+        }
+#else
+        ok = call_hook(Hook::IsAdmissibleBatch, 0, deps_.is_admissible_batch, S, dS, admissible, m);
+#endif
+        for (std::size_t j = 0; j < m; ++j) {
+            eval[j] = !ok ? Eval::Failed
+                    : (admissible[j] ? Eval::Admissible : Eval::Inadmissible);
+        }
+        return ok;
+    }
+
+    Eval evaluate(const Frame& f, const Step& dS) const noexcept {
+        bool admissible = false;
+        if (!safe_is_admissible(f, dS, admissible)) return Eval::Failed;
+        return admissible ? Eval::Admissible : Eval::Inadmissible;
+    }
+
+    // The stages alone (a batch hook already answered the regular predicate)
+    Eval evaluate_stages(const Frame& f, const Step& dS) const noexcept {
+#if defined(__cpp_exceptions)
+        try {
+            return stages_hold(f, dS) ? Eval::Admissible : Eval::Inadmissible;
+        } catch (...) {
+            f.tally.fail(HookFailure::Exception);
+            return Eval::Failed;
+        }
+#else
+        return stages_hold(f, dS) ? Eval::Admissible : Eval::Inadmissible;
+#endif
+    }
+
+    // Inadmissible proposal => fixed-mode enforcement into candidate.
+    // Returns false => caller emits neutral (fail-closed).
+    // probe: Bisection working buffer, nullptr => a local one is used.
+    bool enforce_inadmissible(const Frame& f, const Step& proposed, Step& candidate, Step* probe) const noexcept {
         switch (cfg_.mode) {
             case Mode::Reject:
                 // Reject => neutral (Specification §6.2)
-                return neutral_safe();
+                return enforce_mode<Mode::Reject>(f, proposed, candidate, probe);
 
             case Mode::Scale:
                 // Scale => bounded attempts then neutral (Specification §6.3, §9)
-                return enforce_scale(S, proposed);
+                return enforce_mode<Mode::Scale>(f, proposed, candidate, probe);
 
             case Mode::Project:
                 // Project once then neutral (Specification §6.4)
-                return enforce_project(S, proposed);
+                return enforce_mode<Mode::Project>(f, proposed, candidate, probe);
         }
 
         // Defensive fail-closed (should not happen)
-        return neutral_safe();
+        return false;
     }
 
-private:
-    Step enforce_scale(const State& S, const Step& proposed) const noexcept {
-        if (!deps_.scale_step) return neutral_safe();
+    template <Mode M>
+    bool enforce_mode(const Frame& f, const Step& proposed, Step& candidate, Step* probe) const noexcept {
+        if constexpr (M == Mode::Scale) {
+            return enforce_scale(f, proposed, candidate, probe);
+        } else if constexpr (M == Mode::Project) {
+            (void)probe;
+            return enforce_project(f, proposed, candidate);
+        } else {
+            (void)f;
+            (void)proposed;
+            (void)candidate;
+            (void)probe;
+            return false;
+        }
+    }
+
+    bool enforce_scale(const Frame& f, const Step& proposed, Step& scaled, Step* probe) const noexcept {
+        if (!deps_.scale_step) {
+            f.tally.fail(HookFailure::Missing);
+            return false;
+        }
+
+        if (deps_.is_admissible_scaled) return enforce_scale_lazy(f, proposed, scaled);
 
-        double k = 1.0; // start from 1.0 (Specification §6.3)
-        for (std::size_t i = 0; i < cfg_.max_scale_attempts; ++i) {
-            Step scaled{};
-            if (!deps_.scale_step(proposed, k, scaled)) {
-                // Transform failure => neutral (fail-closed)
-                return neutral_safe();
+        const auto scale = [&](double k, Step& out) {
+            ++f.tally.attempts;
+            f.tally.candidate_k = k;
+            if (call_hook(Hook::ScaleStep, f.tally.attempts, deps_.scale_step, proposed, k, out)) {
+                return true;
             }
+            f.tally.fail(HookFailure::Transform);
+            return false;
+        };
+        const auto eval = [&](const Step& cand) { return evaluate(f, cand); };
+
+        // Closed-form candidate first: one scale + one evaluation
+        if (deps_.solve_scale) {
+            double k = 0.0;
+            switch (solve_scale_safe(f, proposed, k)) {
+                case Eval::Failed:
+                    return false;
+
+                case Eval::Admissible:
+                    if (!scale(k, scaled)) return false;
+                    switch (eval(scaled)) {
+                        case Eval::Admissible:   f.tally.k = k; return true;
+                        case Eval::Failed:       return false;
+                        case Eval::Inadmissible: break; // fall back to the search
+                    }
+                    break;
 
-            bool admissible = false;
-            if (!safe_is_admissible(S, scaled, admissible)) {
-                return neutral_safe();
+                case Eval::Inadmissible:
+                    break; // no usable candidate
             }
+        }
+
+        switch (cfg_.scale_search) {
+            case ScaleSearch::Geometric:
+                if (!detail::usable_hint(f.hint)) {
+                    // A chunk of one would only add a hook call per candidate
+                    if constexpr (speculative_chunk<Step>() >= 2) {
+                        if (cfg_.speculative_scale && deps_.is_admissible_candidates) {
+                            return search_speculative(f, proposed, scaled);
+                        }
+                    }
+                    return detail::search_geometric(cfg_, scaled, f.tally.k, scale, eval);
+                }
+                if (probe) return detail::search_geometric_warm(cfg_, scaled, *probe, f.tally.k, f.hint, scale, eval);
+                {
+                    Step local{};
+                    return detail::search_geometric_warm(cfg_, scaled, local, f.tally.k, f.hint, scale, eval);
+                }
+
+            case ScaleSearch::Bisection:
+                if (probe) return detail::search_bisection(cfg_, scaled, *probe, f.tally.k, scale, eval, f.hint);
+                {
+                    Step local{};
+                    return detail::search_bisection(cfg_, scaled, local, f.tally.k, scale, eval, f.hint);
+                }
+        }
+
+        // Defensive fail-closed (should not happen)
+        return false;
+    }
+
+    // Speculative cold geometric search (Config::speculative_scale). The
+    // sequential search returns the first admissible grid candidate and stops
+    // at a transform or evaluation failure; so does this, chunk by chunk.
+    bool search_speculative(const Frame& f, const Step& proposed, Step& scaled) const noexcept {
+        constexpr std::size_t kChunk = speculative_chunk<Step>();
+        static_assert(kChunk >= 2 && kChunk * sizeof(Step) <= kSpeculativeStackBytes,
+                      "speculative candidates exceed the stack budget");
+        Step cand[kChunk];
+        double ks[kChunk];
+        bool ok[kChunk];
 
-            if (admissible) {
-                return scaled;
+        double k = 1.0;
+        for (std::size_t base = 0; base < cfg_.max_scale_attempts; base += kChunk) {
+            const std::size_t rest = cfg_.max_scale_attempts - base;
+            const std::size_t m = rest < kChunk ? rest : kChunk;
+
+            bool transform_failed = false;
+            std::size_t built = 0;
+            for (; built < m; ++built) {
+                ++f.tally.attempts;
+                f.tally.candidate_k = k;
+                if (!call_hook(Hook::ScaleStep, f.tally.attempts, deps_.scale_step, proposed, k, cand[built])) {
+                    transform_failed = true;
+                    break;
+                }
+                ks[built] = k;
+                k *= cfg_.scale_factor;
             }
 
-            // monotonic toward 0 (Specification §6.3)
-            k *= cfg_.scale_factor;
+            if (built > 0 && !evaluate_candidates(f, cand, ok, built)) return false;
+            for (std::size_t j = 0; j < built; ++j) {
+                if (!ok[j]) continue;
+                f.tally.k = ks[j];
+                detail::commit_candidate(scaled, cand[j]);
+                return true;
+            }
+            if (transform_failed) {
+                f.tally.fail(HookFailure::Transform);
+                return false;
+            }
         }
+        return false;
+    }
 
-        // Bounded attempts exhausted => neutral (Specification §5.4)
-        return neutral_safe();
+    // false => the candidates hook reported failure or threw (fail-closed)
+    bool evaluate_candidates(const Frame& f, const Step* dS, bool* ok, std::size_t m) const noexcept {
+#if defined(__cpp_exceptions)
+        try {
+            return call_hook(Hook::IsAdmissibleCandidates, f.tally.attempts, deps_.is_admissible_candidates,
+                             f.S, dS, ok, m);
+        } catch (...) {
+            f.tally.fail(HookFailure::Exception);
+            return false;
+        }
+#else
+        return call_hook(Hook::IsAdmissibleCandidates, f.tally.attempts, deps_.is_admissible_candidates,
+                         f.S, dS, ok, m);
+#endif
     }
 
-    Step enforce_project(const State& S, const Step& proposed) const noexcept {
-        if (!deps_.project_step) return neutral_safe();
+    // Scale mode over k alone: the searches run on the scale factor (the
+    // "candidate" is k itself), candidates are evaluated through
+    // is_admissible_scaled, and only the accepted k is materialized.
+    bool enforce_scale_lazy(const Frame& f, const Step& proposed, Step& scaled) const noexcept {
+        const auto scale = [&](double k, double& out) {
+            ++f.tally.attempts;
+            out = k;
+            return true;
+        };
+        const auto eval = [&](const double& k) { return evaluate_scaled(f, proposed, k); };
+
+        double k = 0.0;
+        bool found = false;
+
+        if (deps_.solve_scale) {
+            switch (solve_scale_safe(f, proposed, k)) {
+                case Eval::Failed:
+                    return false;
 
-        Step projected{};
-        if (!deps_.project_step(S, proposed, projected)) {
-            return neutral_safe();
+                case Eval::Admissible:
+                    ++f.tally.attempts;
+                    switch (eval(k)) {
+                        case Eval::Admissible:   found = true; break;
+                        case Eval::Failed:       return false;
+                        case Eval::Inadmissible: break; // fall back to the search
+                    }
+                    break;
+
+                case Eval::Inadmissible:
+                    break;
+            }
         }
 
+        if (!found) {
+            double candidate = 0.0;
+            double probe = 0.0;
+            switch (cfg_.scale_search) {
+                case ScaleSearch::Geometric:
+                    found = detail::usable_hint(f.hint)
+                          ? detail::search_geometric_warm(cfg_, candidate, probe, k, f.hint, scale, eval)
+                          : detail::search_geometric(cfg_, candidate, k, scale, eval);
+                    break;
+
+                case ScaleSearch::Bisection:
+                    found = detail::search_bisection(cfg_, candidate, probe, k, scale, eval, f.hint);
+                    break;
+            }
+            if (!found) return false;
+        }
+
+        // Materialize once, verify once
+        f.tally.candidate_k = k;
+        if (!call_hook(Hook::ScaleStep, f.tally.attempts, deps_.scale_step, proposed, k, scaled)) {
+            f.tally.fail(HookFailure::Transform);
+            return false;
+        }
+        switch (evaluate(f, scaled)) {
+            case Eval::Admissible:
+                f.tally.k = k;
+                return true;
+            case Eval::Inadmissible:
+                f.tally.fail(HookFailure::Transform); // hook disagrees with the built step
+                return false;
+            case Eval::Failed:
+                return false;
+        }
+        return false;
+    }
+
+    Eval evaluate_scaled(const Frame& f, const Step& base, double k) const noexcept {
         bool admissible = false;
-        if (!safe_is_admissible(S, projected, admissible)) {
-            return neutral_safe();
+#if defined(__cpp_exceptions)
+        try {
+            admissible = call_hook(Hook::IsAdmissibleScaled, f.tally.attempts,
+                               deps_.is_admissible_scaled, f.S, base, k);
+        } catch (...) {
+            f.tally.fail(HookFailure::Exception);
+            return Eval::Failed;
         }
+#else
+        admissible = call_hook(Hook::IsAdmissibleScaled, f.tally.attempts,
+                               deps_.is_admissible_scaled, f.S, base, k);
+#endif
+        return admissible ? Eval::Admissible : Eval::Inadmissible;
+    }
 
-        if (!admissible) {
-            // Project applied at most once; inadmissible => neutral (Specification §6.4)
-            return neutral_safe();
+    // One projection (project_step_certified if set, else project_step).
+    // Returns false => no output (fail-closed).
+    bool project(const State& S, const Step& proposed, Step& projected, detail::Tally& tally,
+                 bool& certified) const noexcept {
+        certified = false;
+        if (deps_.project_step_certified) {
+            if (call_hook(Hook::ProjectStep, 0, deps_.project_step_certified, S, proposed, projected, certified)) {
+                return true;
+            }
+        } else if (!deps_.project_step) {
+            tally.fail(HookFailure::Missing);
+            return false;
+        } else if (call_hook(Hook::ProjectStep, 0, deps_.project_step, S, proposed, projected)) {
+            return true;
         }
+        tally.fail(HookFailure::Transform);
+        return false;
+    }
+
+    bool enforce_project(const Frame& f, const Step& proposed, Step& projected) const noexcept {
+        bool certified = false;
+        if (!project(f.S, proposed, projected, f.tally, certified)) return false;
+        if (certified) return true;
 
-        return projected;
+        // Project applied at most once; inadmissible => neutral (Specification §6.4)
+        f.tally.candidate_k = 0.0; // not a scaled proposal: no stage is skipped
+        return evaluate(f, projected) == Eval::Admissible;
+    }
+
+    // Admissible => k is a usable candidate in (0, 1); Inadmissible => none;
+    // Failed => solver threw (fail-closed).
+    Eval solve_scale_safe(const Frame& f, const Step& proposed, double& k) const noexcept {
+        bool ok = false;
+#if defined(__cpp_exceptions)
+        try {
+            ok = call_hook(Hook::SolveScale, f.tally.attempts, deps_.solve_scale, f.S, proposed, k);
+        } catch (...) {
+            f.tally.fail(HookFailure::Exception);
+            return Eval::Failed;
+        }
+#else
+        ok = call_hook(Hook::SolveScale, f.tally.attempts, deps_.solve_scale, f.S, proposed, k);
+#endif
+        // Rejects NaN as well: k = 1 is already known inadmissible
+        if (!ok || !(k > 0.0 && k < 1.0)) return Eval::Inadmissible;
+        return Eval::Admissible;
+    }
+
+    // Staged predicate: fail-closed AND of the stages (cheapest first), then
+    // the regular predicate. May throw (contained by safe_is_admissible).
+    bool admissible(const Frame& f, const Step& dS) const {
+        if (!stages_hold(f, dS)) return false;
+        if (f.ctx) return call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible_ctx, f.S, *f.ctx, dS);
+        if (deps_.is_admissible) return call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible, f.S, dS);
+        return true;
+    }
+
+    // AND of the stages, cheapest first. May throw.
+    bool stages_hold(const Frame& f, const Step& dS) const {
+        const double k = f.tally.candidate_k;
+        for (std::uint8_t i = 0; i < stage_count_; ++i) {
+            const AdmissibilityStage<State, Step>& st = deps_.stages[stage_order_[i]];
+            double& held = f.tally.stage_k[i];
+
+            // Monotone in k: already holds at some k' >= k of this proposal
+            if (st.monotone_in_k && k > 0.0 && k <= held) continue;
+
+            if (!call_hook(Hook::AdmissibleStage, f.tally.attempts, st.check, f.S, dS)) return false;
+            if (st.monotone_in_k && k > held) held = k;
+        }
+        return true;
     }
 
     // MUST NOT allow exceptions to escape enforcement boundary (Specification §11.3)
-    bool safe_is_admissible(const State& S, const Step& dS, bool& out) const noexcept {
+    bool safe_is_admissible(const Frame& f, const Step& dS, bool& out) const noexcept {
+        if (stage_count_ > 0) {
+#if defined(__cpp_exceptions)
+            try {
+                out = admissible(f, dS);
+                return true;
+            } catch (...) {
+                out = false;
+                f.tally.fail(HookFailure::Exception);
+                return false;
+            }
+#else
+            out = admissible(f, dS);
+            return true;
+#endif
+        }
+
 #if defined(__cpp_exceptions)
         try {
-            out = deps_.is_admissible(S, dS);
+            out = f.ctx ? call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible_ctx, f.S, *f.ctx, dS)
+                        : call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible, f.S, dS);
             return true;
         } catch (...) {
             out = false;
+            f.tally.fail(HookFailure::Exception);
             return false;
         }
 #else
-        out = deps_.is_admissible(S, dS);
+        out = f.ctx ? call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible_ctx, f.S, *f.ctx, dS)
+                    : call_hook(Hook::IsAdmissible, f.tally.attempts, deps_.is_admissible, f.S, dS);
         return true;
 #endif
     }
 
-    Step neutral_safe() const noexcept {
-        // Neutral step MUST be provided by integrator (Specification §10.3)
-        if (deps_.neutral_step) return deps_.neutral_step();
-        return Step{}; // last-resort fallback (still no I/O, fail-closed intent)
-    }
-
 private:
     Config cfg_;
-    Dependencies<State, Step> deps_;
+    Dependencies<State, Step, Context> deps_;
+    Stats* stats_;
+    std::uint8_t stage_order_[kMaxAdmissibilityStages] = {};
+    std::uint8_t stage_count_ = 0;
+    bool stages_ok_ = true;
+    // Neutral step MUST be provided by integrator (Specification §10.3);
+    // Step{} is the last-resort fallback (still no I/O, fail-closed intent)
+    bool neutral_ok_ = false;
+    Step neutral_{};
 };
 
 } // namespace ase
@@ -0,0 +1,267 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/vector_envelope.hpp"
+
+// Element-level pieces are shared with device code (ase/device_cuda.cuh)
+#if defined(__CUDACC__)
+    #define ASE_HOST_DEVICE __host__ __device__
+#else
+    #define ASE_HOST_DEVICE
+#endif
+
+namespace ase {
+
+// Enforcement over buffers that stay where they are (accelerator memory).
+//
+// DeviceEnforcer<Backend> runs the standard vector envelope
+// (vec::BlockLimits) and the Reject / Scale / Project decision on the
+// backend's buffers. ΔS is rewritten in place to ΔS', and only the Decision
+// (a few bytes per evaluated candidate) crosses to the host:
+//
+//   ase::DeviceEnforcer<ase::CudaBackend> enforcer(cfg, lim);   // ase/device_cuda.cuh
+//   ase::Decision d = enforcer.enforce(S_dev, dS_dev, n);       // dS_dev := ΔS'
+//
+// The host drives the same bounded search as Engine (max_scale_attempts
+// candidates, each one backend pass). Each pass is one fused reduction over
+// S + k·ΔS. The candidate is never stored; only the accepted k is written.
+// The neutral step is the zero step.
+//
+// Determinism: every backend reduces in the fixed order described at
+// device::reduce_host, and never contracts a·b + c (the CUDA backend is
+// compiled with -fmad=false). Summaries, and so decisions, are bit-identical
+// across backends. HostBackend is the reference and runs on plain host memory.
+
+namespace device {
+
+// Threads per block / elements per first-level group of the reduction tree
+constexpr std::size_t kBlock = 256;
+
+// One fused pass over S + k·ΔS (d = k·ΔS[i] rounded once, x = S[i] + d)
+struct Summary final {
+    double next_sq = 0.0;   // Σ x^2
+    double step_sq = 0.0;   // Σ d^2
+    double cross = 0.0;     // Σ S[i]·d
+    double state_sq = 0.0;  // Σ S[i]^2
+    double violation = -HUGE_VAL; // max of |x| - linf, |d| - step_linf, sign_floor - x (prefix)
+};
+
+// Per-element terms; padding elements contribute the identity
+ASE_HOST_DEVICE inline Summary element_terms(const double* S, const double* dS, double k, std::size_t i,
+                             const vec::BlockLimits& lim) noexcept {
+    const double s = S[i];
+    const double d = k * dS[i];
+    const double x = s + d;
+
+    double v = std::fmax(std::fabs(x) - lim.linf, std::fabs(d) - lim.step_linf);
+    if (i < lim.sign_prefix) v = std::fmax(v, lim.sign_floor - x);
+    return {x * x, d * d, s * d, s * s, v};
+}
+
+ASE_HOST_DEVICE inline void accumulate(Summary& a, const Summary& b) noexcept {
+    a.next_sq = a.next_sq + b.next_sq;
+    a.step_sq = a.step_sq + b.step_sq;
+    a.cross = a.cross + b.cross;
+    a.state_sq = a.state_sq + b.state_sq;
+    a.violation = std::fmax(a.violation, b.violation);
+}
+
+// Fixed reduction tree of one group of kBlock slots (padded with identities):
+// for stride = kBlock/2, ..., 1: slot[j] += slot[j + stride] for j < stride
+inline Summary reduce_group(Summary* slot) noexcept {
+    for (std::size_t stride = kBlock / 2; stride > 0; stride /= 2) {
+        for (std::size_t j = 0; j < stride; ++j) accumulate(slot[j], slot[j + stride]);
+    }
+    return slot[0];
+}
+
+// Reference order: elements are reduced in consecutive groups of kBlock
+// slots; the group results form the next level, reduced the same way,
+// until one value is left. partials receives ceil(n / kBlock) entries.
+inline Summary reduce_host(const double* S, const double* dS, double k, std::size_t n,
+                           const vec::BlockLimits& lim, std::vector<Summary>& partials) {
+    const std::size_t groups = (n + kBlock - 1) / kBlock;
+    partials.resize(groups);
+
+    Summary slot[kBlock];
+    for (std::size_t g = 0; g < groups; ++g) {
+        for (std::size_t t = 0; t < kBlock; ++t) {
+            const std::size_t i = g * kBlock + t;
+            slot[t] = (i < n) ? element_terms(S, dS, k, i, lim) : Summary{};
+        }
+        partials[g] = reduce_group(slot);
+    }
+
+    std::size_t m = groups;
+    while (m > 1) {
+        const std::size_t next = (m + kBlock - 1) / kBlock;
+        for (std::size_t g = 0; g < next; ++g) {
+            for (std::size_t t = 0; t < kBlock; ++t) {
+                const std::size_t i = g * kBlock + t;
+                slot[t] = (i < m) ? partials[i] : Summary{};
+            }
+            partials[g] = reduce_group(slot);
+        }
+        m = next;
+    }
+    return (groups == 0) ? Summary{} : partials[0];
+}
+
+// Projection of one element (every backend clips with exactly this)
+ASE_HOST_DEVICE inline double clip_element(double s, double d, std::size_t i, const vec::BlockLimits& lim) noexcept {
+    d = std::fmin(lim.step_linf, std::fmax(-lim.step_linf, d));
+    double x = std::fmin(lim.linf, std::fmax(-lim.linf, s + d));
+    if (i < lim.sign_prefix) x = std::fmax(lim.sign_floor, x);
+    return x - s;
+}
+
+// Verdict of the envelope from one summary
+inline bool admits(const Summary& s, const vec::BlockLimits& lim) noexcept {
+    return std::isfinite(s.next_sq) && std::isfinite(s.step_sq) && std::isfinite(s.cross) &&
+           std::isfinite(s.state_sq) && s.violation <= 0.0 && std::sqrt(s.next_sq) <= lim.l2;
+}
+
+} // namespace device
+
+// Reference backend on host memory (also the Backend interface):
+//   summarize(S, dS, k, n, lim, out) one fused pass; false on a backend error
+//   scale(dS, k, n)                  dS[i] = k·dS[i] in place (k = 0 writes zeros)
+//   clip(S, dS, n, lim)              dS[i] clipped to the step bound, then
+//                                    S[i] + dS[i] to the L∞ box / sign floor
+// One backend instance serves one thread (or stream) at a time.
+class HostBackend final {
+public:
+    bool summarize(const double* S, const double* dS, double k, std::size_t n, const vec::BlockLimits& lim,
+                   device::Summary& out) {
+        out = device::reduce_host(S, dS, k, n, lim, partials_);
+        return true;
+    }
+
+    bool scale(double* dS, double k, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) dS[i] = (k == 0.0) ? 0.0 : k * dS[i];
+        return true;
+    }
+
+    bool clip(const double* S, double* dS, std::size_t n, const vec::BlockLimits& lim) noexcept {
+        for (std::size_t i = 0; i < n; ++i) dS[i] = device::clip_element(S[i], dS[i], i, lim);
+        return true;
+    }
+
+private:
+    std::vector<device::Summary> partials_;
+};
+
+template <class Backend>
+class DeviceEnforcer final {
+public:
+    DeviceEnforcer(const Config& cfg, const vec::BlockLimits& lim, Backend backend = Backend{})
+        : cfg_(cfg), lim_(lim), backend_(std::move(backend)) {}
+
+    // S and dS are backend buffers of n doubles. On return dS holds ΔS'
+    // (the proposal itself, k·ΔS, its projection, or zeros for Neutral).
+    // Same decision as Engine with the equivalent envelope hooks, including
+    // attempt counts and warm starts (Scale mode).
+    Decision enforce(const double* S, double* dS, std::size_t n, ScaleHint hint = {}) {
+        detail::Tally tally;
+
+        device::Summary proposal;
+        if (!backend_.summarize(S, dS, 1.0, n, lim_, proposal)) return neutral(dS, n, tally);
+        if (device::admits(proposal, lim_)) return finish(Outcome::PassThrough, tally);
+
+        switch (cfg_.mode) {
+            case Mode::Reject:
+                return neutral(dS, n, tally);
+
+            case Mode::Scale:
+                if (!search(S, dS, n, hint.k, tally) || (tally.k != 1.0 && !backend_.scale(dS, tally.k, n))) {
+                    return neutral(dS, n, tally);
+                }
+                return finish(Outcome::Scaled, tally);
+
+            case Mode::Project:
+                // A non-finite proposal is not clipped into range: fail closed
+                if (!std::isfinite(proposal.step_sq) || !project(S, dS, n)) return neutral(dS, n, tally);
+                return finish(Outcome::Projected, tally);
+        }
+        return neutral(dS, n, tally);
+    }
+
+    Backend& backend() noexcept { return backend_; }
+
+private:
+    using Eval = detail::Eval;
+
+    Eval evaluate(const double* S, const double* dS, double k, std::size_t n) {
+        device::Summary s;
+        if (!backend_.summarize(S, dS, k, n, lim_, s)) return Eval::Failed;
+        return device::admits(s, lim_) ? Eval::Admissible : Eval::Inadmissible;
+    }
+
+    // Engine's bounded searches over k alone (as with is_admissible_scaled)
+    bool search(const double* S, const double* dS, std::size_t n, double hint, detail::Tally& tally) {
+        const auto scale = [&](double k, double& out) {
+            ++tally.attempts;
+            out = k;
+            return true;
+        };
+        // k = 1 is the proposal, already known inadmissible: no second pass
+        const auto eval = [&](const double& k) { return (k == 1.0) ? Eval::Inadmissible : evaluate(S, dS, k, n); };
+
+        double candidate = 0.0;
+        double probe = 0.0;
+        switch (cfg_.scale_search) {
+            case ScaleSearch::Geometric:
+                return detail::usable_hint(hint)
+                     ? detail::search_geometric_warm(cfg_, candidate, probe, tally.k, hint, scale, eval)
+                     : detail::search_geometric(cfg_, candidate, tally.k, scale, eval);
+            case ScaleSearch::Bisection:
+                return detail::search_bisection(cfg_, candidate, probe, tally.k, scale, eval, hint);
+        }
+        return false;
+    }
+
+    // Clip once; if the L2 ball is still violated, scale the clipped step
+    // toward S (closed form, slightly inside the boundary). Verified once
+    // (Specification §6.4).
+    bool project(const double* S, double* dS, std::size_t n) {
+        device::Summary s;
+        if (!backend_.clip(S, dS, n, lim_) || !backend_.summarize(S, dS, 1.0, n, lim_, s)) return false;
+        if (device::admits(s, lim_)) return true;
+
+        // ||S + k·p||^2 = state_sq + 2k·cross + k^2·step_sq <= l2^2
+        const double a = s.step_sq;
+        const double b = s.cross;
+        const double c = s.state_sq - lim_.l2 * lim_.l2;
+        if (!(a > 0.0) || !(c <= 0.0) || !std::isfinite(b)) return false;
+        const double disc = std::sqrt(b * b - a * c);
+        double k = (b > 0.0) ? -c / (b + disc) : (disc - b) / a;
+        if (!(k >= 0.0 && k < 1.0)) return false;
+        k *= 1.0 - 1e-12;
+
+        return backend_.scale(dS, k, n) && evaluate(S, dS, 1.0, n) == Eval::Admissible;
+    }
+
+    Decision neutral(double* dS, std::size_t n, const detail::Tally& tally) {
+        backend_.scale(dS, 0.0, n); // best effort: the Decision says Neutral either way
+        return finish(Outcome::Neutral, tally);
+    }
+
+    static Decision finish(Outcome kind, const detail::Tally& tally) noexcept {
+        Decision d;
+        d.kind = kind;
+        d.k = (kind == Outcome::Scaled) ? tally.k : (kind == Outcome::Neutral ? 0.0 : 1.0);
+        d.attempts = static_cast<std::uint8_t>(tally.attempts < 255 ? tally.attempts : 255);
+        return d;
+    }
+
+    Config cfg_;
+    vec::BlockLimits lim_;
+    Backend backend_;
+};
+
+} // namespace ase
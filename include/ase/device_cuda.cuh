@@ -0,0 +1,153 @@
+#pragma once
+// CUDA backend for ase::DeviceEnforcer (ase/device.hpp).
+// Compile with nvcc and -fmad=false, so results stay bit-identical to
+// HostBackend. Linking the ase_cuda CMake target (-DASE_WITH_CUDA=ON) adds
+// the flag to every CUDA source of the consumer; plain ase does not.
+#if !defined(__CUDACC__)
+    #error "ase/device_cuda.cuh must be compiled by nvcc"
+#endif
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+
+#include "ase/device.hpp"
+
+namespace ase {
+namespace device {
+namespace cuda {
+
+// Kernels are templates over the block size (always device::kBlock), so
+// the header can be included by several translation units without
+// duplicate __global__ symbols at link time.
+//
+// One group of Block slots per thread block, reduced by the tree of
+// device::reduce_group (same pairings, same order). The slots are raw
+// __shared__ storage: Summary has default member initializers, and
+// __shared__ variables admit no dynamic initialization. Every slot is
+// assigned before the reduction reads it.
+template <std::size_t Block>
+__device__ void reduce_block(Summary* slot) {
+    const unsigned t = threadIdx.x;
+    for (unsigned stride = Block / 2; stride > 0; stride /= 2) {
+        __syncthreads();
+        if (t < stride) accumulate(slot[t], slot[t + stride]);
+    }
+    __syncthreads();
+}
+
+template <std::size_t Block>
+__global__ void summarize_kernel(const double* S, const double* dS, double k, std::size_t n,
+                                 vec::BlockLimits lim, Summary* out) {
+    __shared__ alignas(Summary) unsigned char storage[Block * sizeof(Summary)];
+    Summary* const slot = reinterpret_cast<Summary*>(storage);
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * Block + threadIdx.x;
+    slot[threadIdx.x] = (i < n) ? element_terms(S, dS, k, i, lim) : Summary{};
+    reduce_block<Block>(slot);
+    if (threadIdx.x == 0) out[blockIdx.x] = slot[0];
+}
+
+template <std::size_t Block>
+__global__ void combine_kernel(const Summary* in, std::size_t m, Summary* out) {
+    __shared__ alignas(Summary) unsigned char storage[Block * sizeof(Summary)];
+    Summary* const slot = reinterpret_cast<Summary*>(storage);
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * Block + threadIdx.x;
+    slot[threadIdx.x] = (i < m) ? in[i] : Summary{};
+    reduce_block<Block>(slot);
+    if (threadIdx.x == 0) out[blockIdx.x] = slot[0];
+}
+
+template <std::size_t Block>
+__global__ void scale_kernel(double* dS, double k, std::size_t n) {
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * Block + threadIdx.x;
+    if (i < n) dS[i] = (k == 0.0) ? 0.0 : k * dS[i];
+}
+
+template <std::size_t Block>
+__global__ void clip_kernel(const double* S, double* dS, std::size_t n, vec::BlockLimits lim) {
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * Block + threadIdx.x;
+    if (i < n) dS[i] = clip_element(S[i], dS[i], i, lim);
+}
+
+inline unsigned groups(std::size_t n) {
+    return static_cast<unsigned>((n + kBlock - 1) / kBlock);
+}
+
+} // namespace cuda
+} // namespace device
+
+// Backend over device pointers on one CUDA stream. Every call synchronizes
+// the stream before returning; only the final Summary is copied to the host.
+// Scratch for the partial results grows on demand and is reused.
+class CudaBackend final {
+public:
+    explicit CudaBackend(cudaStream_t stream = nullptr) noexcept : stream_(stream) {}
+
+    CudaBackend(CudaBackend&& o) noexcept : stream_(o.stream_), scratch_(o.scratch_), capacity_(o.capacity_) {
+        o.scratch_ = nullptr;
+        o.capacity_ = 0;
+    }
+    CudaBackend(const CudaBackend&) = delete;
+    CudaBackend& operator=(const CudaBackend&) = delete;
+    CudaBackend& operator=(CudaBackend&&) = delete;
+
+    ~CudaBackend() {
+        if (scratch_) cudaFree(scratch_);
+    }
+
+    bool summarize(const double* S, const double* dS, double k, std::size_t n, const vec::BlockLimits& lim,
+                   device::Summary& out) {
+        if (n == 0) {
+            out = device::Summary{};
+            return true;
+        }
+
+        // Two ping-pong halves: level L reads one, writes the other
+        std::size_t m = device::cuda::groups(n);
+        if (!reserve(2 * m)) return false;
+        device::Summary* a = scratch_;
+        device::Summary* b = scratch_ + m;
+
+        device::cuda::summarize_kernel<device::kBlock><<<static_cast<unsigned>(m), device::kBlock, 0, stream_>>>(S, dS, k, n, lim, a);
+        while (m > 1) {
+            const std::size_t next = device::cuda::groups(m);
+            device::cuda::combine_kernel<device::kBlock><<<static_cast<unsigned>(next), device::kBlock, 0, stream_>>>(a, m, b);
+            const auto t = a;
+            a = b;
+            b = t;
+            m = next;
+        }
+
+        return cudaMemcpyAsync(&out, a, sizeof out, cudaMemcpyDeviceToHost, stream_) == cudaSuccess &&
+               cudaStreamSynchronize(stream_) == cudaSuccess && cudaGetLastError() == cudaSuccess;
+    }
+
+    bool scale(double* dS, double k, std::size_t n) {
+        if (n == 0) return true;
+        device::cuda::scale_kernel<device::kBlock><<<device::cuda::groups(n), device::kBlock, 0, stream_>>>(dS, k, n);
+        return cudaStreamSynchronize(stream_) == cudaSuccess && cudaGetLastError() == cudaSuccess;
+    }
+
+    bool clip(const double* S, double* dS, std::size_t n, const vec::BlockLimits& lim) {
+        if (n == 0) return true;
+        device::cuda::clip_kernel<device::kBlock><<<device::cuda::groups(n), device::kBlock, 0, stream_>>>(S, dS, n, lim);
+        return cudaStreamSynchronize(stream_) == cudaSuccess && cudaGetLastError() == cudaSuccess;
+    }
+
+private:
+    bool reserve(std::size_t count) {
+        if (count <= capacity_) return true;
+        if (scratch_) cudaFree(scratch_);
+        scratch_ = nullptr;
+        capacity_ = 0;
+        if (cudaMalloc(&scratch_, count * sizeof(device::Summary)) != cudaSuccess) return false;
+        capacity_ = count;
+        return true;
+    }
+
+    cudaStream_t stream_;
+    device::Summary* scratch_ = nullptr;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace ase
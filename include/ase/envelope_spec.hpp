@@ -0,0 +1,218 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "ase/vector_envelope.hpp"
+
+namespace ase {
+
+// Declarative envelope over an elementwise linear next-state transition.
+//
+// The State is described as C channels of n doubles (e.g. theta, m, v, ema).
+// For a step ΔS (n doubles) the next state is, per element i and channel c
+// in increasing order:
+//
+//   next_c[i] = a_c * S_c[i] + b_c * ΔS[i] + q_c * ΔS[i]^2 + g_c * next_src[i]
+//   (optionally clamped to >= 0)
+//
+// where src < c is an earlier channel (e.g. ema_next fed by theta_next).
+// Constraints on the next state are declared once:
+//
+//   l2_ball(c, R)               ||next_c||2 <= R
+//   l2_gap(c, other, R)         ||next_c - next_other||2 <= R
+//   lower_bound(c, lo, prefix)  next_c[i] >= lo for i < prefix
+//   step_linf(R)                |ΔS[i]| <= R
+//   (always)                    ΔS and every next_c finite
+//
+// admits(S, ΔS) evaluates all of them in one streaming pass over the inputs
+// without materializing the next state, so it can be called directly from
+// Dependencies::is_admissible and costs the same for every scale/bisection
+// attempt. contains(S) checks the same constraints on S itself (no
+// transition, no step bound), e.g. for Dependencies::prepare.
+//
+// Norm reductions follow the fixed lane order of ase/vector_envelope.hpp,
+// so results are deterministic (Specification §4.6). A malformed spec
+// (channel index out of range, src >= c) admits nothing (fail-closed).
+template <std::size_t C>
+class EnvelopeSpec final {
+    static_assert(C > 0, "EnvelopeSpec needs at least one channel");
+
+public:
+    using Channels = std::array<const double*, C>;
+
+    static constexpr std::size_t kAll = static_cast<std::size_t>(-1);
+
+    // -------- transition --------
+
+    // next_c = a * S_c + b * ΔS + q * ΔS^2 (identity for channels never set)
+    EnvelopeSpec& transition(std::size_t c, double a, double b, double q = 0.0) noexcept {
+        if (!check(c < C)) return *this;
+        ch_[c].a = a;
+        ch_[c].b = b;
+        ch_[c].q = q;
+        return *this;
+    }
+
+    // next_c += g * next_src (src must be an earlier channel)
+    EnvelopeSpec& feed(std::size_t c, std::size_t src, double g) noexcept {
+        if (!check(c < C && src < c)) return *this;
+        ch_[c].src = src;
+        ch_[c].g = g;
+        return *this;
+    }
+
+    // next_c = max(next_c, 0) after the transition
+    EnvelopeSpec& clamp_nonneg(std::size_t c) noexcept {
+        if (!check(c < C)) return *this;
+        ch_[c].clamp = true;
+        return *this;
+    }
+
+    // -------- constraints --------
+
+    EnvelopeSpec& l2_ball(std::size_t c, double R) noexcept {
+        if (!check(c < C)) return *this;
+        ch_[c].l2 = R;
+        return *this;
+    }
+
+    EnvelopeSpec& l2_gap(std::size_t c, std::size_t other, double R) noexcept {
+        if (!check(c < C && other < C && gaps_ < C)) return *this;
+        gap_[gaps_++] = Gap{c, other, R};
+        return *this;
+    }
+
+    EnvelopeSpec& lower_bound(std::size_t c, double lo, std::size_t prefix = kAll) noexcept {
+        if (!check(c < C)) return *this;
+        ch_[c].lo = lo;
+        ch_[c].lo_prefix = prefix;
+        return *this;
+    }
+
+    EnvelopeSpec& step_linf(double R) noexcept {
+        step_linf_ = R;
+        return *this;
+    }
+
+    bool valid() const noexcept { return valid_; }
+
+    // -------- evaluation --------
+
+    // Is the next state derived from (S, ΔS) inside the envelope?
+    bool admits(const Channels& S, const double* dS, std::size_t n) const noexcept {
+        return evaluate<true>(S, dS, n);
+    }
+
+    // Is S itself inside the envelope?
+    bool contains(const Channels& S, std::size_t n) const noexcept {
+        return evaluate<false>(S, nullptr, n);
+    }
+
+private:
+    struct Channel {
+        double a = 1.0;
+        double b = 0.0;
+        double q = 0.0;
+        double g = 0.0;
+        std::size_t src = C; // none
+        bool clamp = false;
+
+        double l2 = HUGE_VAL;
+        double lo = -HUGE_VAL;
+        std::size_t lo_prefix = 0;
+    };
+
+    struct Gap {
+        std::size_t c = 0;
+        std::size_t other = 0;
+        double R = HUGE_VAL;
+    };
+
+    bool check(bool ok) noexcept {
+        if (!ok) valid_ = false;
+        return ok;
+    }
+
+    static double combine(const double* lanes) noexcept {
+        return vec::detail::combine_sum(lanes);
+    }
+
+    template <bool WithStep>
+    bool evaluate(const Channels& S, const double* dS, std::size_t n) const noexcept {
+        if (!valid_) return false;
+
+        constexpr std::size_t L = vec::detail::kLanes;
+
+        double sq[C][L] = {};
+        double gsq[C][L] = {};
+        double guard = 0.0;           // Σ v * 0: NaN iff some value is non-finite
+        double violation = -HUGE_VAL; // max over (lo - v) and (|ΔS| - R)
+
+        const auto element = [&](std::size_t i, std::size_t lane) {
+            double next[C] = {};
+
+            if constexpr (WithStep) {
+                const double d = dS[i];
+                guard += d * 0.0;
+                const double over = std::fabs(d) - step_linf_;
+                violation = (violation < over) ? over : violation;
+
+                for (std::size_t c = 0; c < C; ++c) {
+                    const Channel& k = ch_[c];
+                    double v = k.a * S[c][i];
+                    v = v + k.b * d;
+                    v = v + k.q * (d * d);
+                    if (k.src < C) v = v + k.g * next[k.src];
+                    if (k.clamp && v < 0.0) v = 0.0;
+                    next[c] = v;
+                }
+            } else {
+                for (std::size_t c = 0; c < C; ++c) next[c] = S[c][i];
+            }
+
+            for (std::size_t c = 0; c < C; ++c) {
+                const double v = next[c];
+                guard += v * 0.0;
+                sq[c][lane] = sq[c][lane] + v * v;
+                if (i < ch_[c].lo_prefix) {
+                    const double under = ch_[c].lo - v;
+                    violation = (violation < under) ? under : violation;
+                }
+            }
+
+            for (std::size_t g = 0; g < gaps_; ++g) {
+                const double diff = next[gap_[g].c] - next[gap_[g].other];
+                gsq[g][lane] = gsq[g][lane] + diff * diff;
+            }
+        };
+
+        std::size_t i = 0;
+        for (; i + L <= n; i += L) {
+            for (std::size_t j = 0; j < L; ++j) element(i + j, j);
+        }
+        for (std::size_t j = 0; i + j < n; ++j) element(i + j, j);
+
+        if (guard != 0.0 || violation > 0.0) return false;
+
+        for (std::size_t c = 0; c < C; ++c) {
+            if (ch_[c].l2 == HUGE_VAL) continue;
+            const double nrm = std::sqrt(combine(sq[c]));
+            if (!(nrm <= ch_[c].l2)) return false;
+        }
+        for (std::size_t g = 0; g < gaps_; ++g) {
+            const double nrm = std::sqrt(combine(gsq[g]));
+            if (!(nrm <= gap_[g].R)) return false;
+        }
+        return true;
+    }
+
+private:
+    std::array<Channel, C> ch_{};
+    std::array<Gap, C> gap_{};
+    std::size_t gaps_ = 0;
+    double step_linf_ = HUGE_VAL;
+    bool valid_ = true;
+};
+
+} // namespace ase
@@ -0,0 +1,220 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "ase/ase.hpp"
+
+namespace ase {
+
+// Host loop S_{t+1} = S_t ⊕ ASE(S_t, ΔS_t) without per-tick State copies.
+//
+// HostLoop owns two State buffers and the step buffers of one tick. Each
+// tick enforces into a reused buffer, and apply writes S_t ⊕ ΔS' into the
+// other state buffer; the buffers then swap. Buffers keep their capacity,
+// so a tick of the loop allocates nothing the hooks do not.
+//
+//   ase::HostLoop<ase::Engine<Vec, Vec>, Vec, Vec> loop(engine, theta0);
+//   loop.run(T, propose, apply);
+//
+// Host hooks (callables; they run on the calling thread unless noted):
+//   propose(const State& S, std::size_t t, Step& out)   ΔS_t into out
+//   apply(const State& S, const Step& eff, State& next) next := S ⊕ eff
+//     (next holds an older state of the same shape: overwrite it in place)
+//   apply_propose(const State& S, const Step& eff, State& next, Step& out)
+//     apply fused with propose(next, t + 1, out), for hosts whose ⊕ and
+//     next proposal share one pass over the state (run_fused)
+//
+// The neutral step goes through apply like any other step: the engine's
+// output remains the single value the host applies (Integration
+// Constraints §2.1), and the loop adds no state between ticks beyond S.
+template <class EngineT, class State, class Step>
+class HostLoop final {
+public:
+    HostLoop(const EngineT& engine, State initial)
+        : engine_(engine), state_{initial, std::move(initial)} {}
+
+    ~HostLoop() {
+        if (!worker_.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+    }
+
+    HostLoop(const HostLoop&) = delete;
+    HostLoop& operator=(const HostLoop&) = delete;
+
+    const State& state() const noexcept { return state_[cur_]; }
+    // Mutable access between runs (e.g. to reset or checkpoint)
+    State& state() noexcept { return state_[cur_]; }
+
+    std::size_t ticks() const noexcept { return ticks_; }
+    const Decision& last_decision() const noexcept { return decision_; }
+
+    // Strict sequence per tick: propose -> enforce -> apply
+    template <class Propose, class Apply>
+    void run(std::size_t ticks, Propose&& propose, Apply&& apply) {
+        for (std::size_t i = 0; i < ticks; ++i) {
+            propose(state_[cur_], ticks_, proposal_);
+            enforce_current(proposal_);
+            apply(state_[cur_], effective_, state_[1 - cur_]);
+            advance();
+        }
+    }
+
+    // ⊕ fused with the next proposal: one apply_propose per tick (the
+    // first proposal comes from propose)
+    template <class Propose, class ApplyPropose>
+    void run_fused(std::size_t ticks, Propose&& propose, ApplyPropose&& apply_propose) {
+        if (ticks == 0) return;
+        propose(state_[cur_], ticks_, proposal_);
+        for (std::size_t i = 0; i < ticks; ++i) {
+            enforce_current(proposal_);
+            apply_propose(state_[cur_], effective_, state_[1 - cur_], pending_);
+            advance();
+            using std::swap;
+            swap(proposal_, pending_);
+        }
+    }
+
+    // Overlapped: ΔS_{t+1} is generated on a worker thread from S_t while
+    // tick t is enforced and applied on the calling thread. Only valid when
+    // the host's next proposal does not need S_{t+1} (stale-by-one gradients,
+    // streamed data); propose(S, t, out) receives S_{t-1} for t > 0 of this
+    // run. The sequence is deterministic: the same as run with that propose.
+    // propose must not throw (it runs on the worker thread).
+    template <class Propose, class Apply>
+    void run_overlapped(std::size_t ticks, Propose&& propose, Apply&& apply) {
+        if (ticks == 0) return;
+
+        using P = typename std::remove_reference<Propose>::type;
+        struct Job {
+            P& propose;
+            const State* S;
+            std::size_t t;
+            Step* out;
+            static void invoke(void* self) {
+                Job& j = *static_cast<Job*>(self);
+                j.propose(*j.S, j.t, *j.out);
+            }
+        };
+
+        propose(state_[cur_], ticks_, proposal_);
+        for (std::size_t i = 0; i < ticks; ++i) {
+            const bool ahead = i + 1 < ticks;
+            Job job{propose, &state_[cur_], ticks_ + 1, &pending_};
+            {
+                if (ahead) submit(&Job::invoke, &job);
+                const Join join{this, ahead}; // job outlives the worker's use, even on a throw
+
+                // Both sides only read S_t; apply writes the other buffer
+                enforce_current(proposal_);
+                apply(state_[cur_], effective_, state_[1 - cur_]);
+            }
+            advance();
+            using std::swap;
+            swap(proposal_, pending_);
+        }
+    }
+
+private:
+    using JobFn = void (*)(void*);
+
+    struct Join {
+        HostLoop* loop;
+        bool active;
+        ~Join() {
+            if (active) loop->wait();
+        }
+    };
+
+    void enforce_current(const Step& proposed) {
+        enforce_into(engine_, state_[cur_], proposed, 0);
+    }
+
+    // Engine: in place, with its decision record
+    template <class E>
+    auto enforce_into(const E& engine, const State& S, const Step& proposed, int)
+        -> decltype(engine.enforce_into(S, proposed, std::declval<Step&>(), std::declval<Scratch<Step>&>(),
+                                        std::declval<Decision&>()), void()) {
+        engine.enforce_into(S, proposed, effective_, scratch_, decision_);
+    }
+
+    // Any other engine (e.g. StaticEngine): returns the step
+    template <class E>
+    void enforce_into(const E& engine, const State& S, const Step& proposed, long) {
+        effective_ = engine.enforce(S, proposed);
+    }
+
+    void advance() noexcept {
+        cur_ = 1 - cur_;
+        ++ticks_;
+    }
+
+    void submit(JobFn fn, void* job) {
+        if (!worker_.joinable()) worker_ = std::thread([this] { worker_main(); });
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn_ = fn;
+            job_ = job;
+            busy_ = true;
+        }
+        wake_.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return !busy_; });
+    }
+
+    void worker_main() {
+        for (;;) {
+            JobFn fn = nullptr;
+            void* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stop_ || fn_ != nullptr; });
+                if (stop_) return;
+                fn = fn_;
+                job = job_;
+                fn_ = nullptr;
+            }
+
+            fn(job);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                busy_ = false;
+            }
+            done_.notify_one();
+        }
+    }
+
+    const EngineT& engine_;
+    State state_[2];
+    std::size_t cur_ = 0;
+    std::size_t ticks_ = 0;
+
+    Step proposal_{};
+    Step pending_{};   // next proposal (fused / overlapped runs)
+    Step effective_{};
+    Scratch<Step> scratch_;
+    Decision decision_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    bool busy_ = false;
+    JobFn fn_ = nullptr;
+    void* job_ = nullptr;
+};
+
+} // namespace ase
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "ase/views.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define ASE_HAS_MMAP 1
+#endif
+
+namespace ase {
+
+// Memory-mapped file of doubles (host-side, POSIX), e.g. a parameter file
+// or a proposed-step dump, exposed as StateView / StepView without copying.
+//
+//   ase::MappedFile params;
+//   if (!params.open("theta.f64")) { ... }
+//   ase::StateView S = params.state_view();
+//
+// open() returns false on any failure (no exceptions); an unopened
+// MappedFile yields empty views. Pages are loaded lazily by the OS.
+class MappedFile final {
+public:
+    enum class Access { ReadOnly, ReadWrite };
+
+    MappedFile() noexcept = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the whole file; its size must be a non-zero multiple of sizeof(double).
+    // ReadWrite maps MAP_SHARED, so writes through data() reach the file.
+    bool open(const char* path, Access access = Access::ReadOnly) noexcept {
+        close();
+#if defined(ASE_HAS_MMAP)
+        const bool rw = (access == Access::ReadWrite);
+        const int fd = ::open(path, rw ? O_RDWR : O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0 ||
+            static_cast<std::uint64_t>(st.st_size) % sizeof(double) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, bytes, rw ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (p == MAP_FAILED) return false;
+
+        addr_ = p;
+        bytes_ = bytes;
+        writable_ = rw;
+        return true;
+#else
+        (void)path;
+        (void)access;
+        return false;
+#endif
+    }
+
+    void close() noexcept {
+#if defined(ASE_HAS_MMAP)
+        if (addr_) ::munmap(addr_, bytes_);
+#endif
+        addr_ = nullptr;
+        bytes_ = 0;
+        writable_ = false;
+    }
+
+    bool is_open() const noexcept { return addr_ != nullptr; }
+    std::size_t size() const noexcept { return bytes_ / sizeof(double); }
+
+    const double* data() const noexcept { return static_cast<const double*>(addr_); }
+
+    // nullptr unless opened ReadWrite
+    double* mutable_data() noexcept { return writable_ ? static_cast<double*>(addr_) : nullptr; }
+
+    StateView state_view() const noexcept { return {data(), size()}; }
+    StepView step_view() const noexcept { return {data(), size()}; }
+
+private:
+    void swap(MappedFile& other) noexcept {
+        std::swap(addr_, other.addr_);
+        std::swap(bytes_, other.bytes_);
+        std::swap(writable_, other.writable_);
+    }
+
+    void* addr_ = nullptr;
+    std::size_t bytes_ = 0;
+    bool writable_ = false;
+};
+
+} // namespace ase
@@ -0,0 +1,369 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #define ASE_HAS_AFFINITY 1
+#endif
+
+namespace ase {
+
+// NUMA-aware placement for sharded enforcement (host-side, next to
+// ase/parallel.hpp).
+//
+// ParallelEnforcer balances load by stealing chunks, so any thread may
+// read any state. For large per-shard states (an adam-state {theta, m, v,
+// ema} per shard) on multi-socket machines, locality matters more: every
+// shard should be allocated, initialized and enforced by one thread on one
+// node. ShardPool provides exactly that:
+//
+//   ase::numa::ShardPool pool;                       // one pinned worker per CPU
+//   auto shards = pool.make_shards(count, [&](std::size_t s) {
+//       return std::make_unique<Shard>(n);           // runs on the owner: first touch
+//   });
+//   pool.for_each_shard(count, [&](std::size_t s) {  // same owner every time
+//       engine.enforce_into(shards[s]->state, proposed[s], out[s], scratch[pool.owner(s)]);
+//   });
+//
+// Pages are placed by the kernel's default first-touch policy: memory lands
+// on the node of the thread that first writes it, so shard memory and the
+// owner's scratch must be created inside make_shards / run. No libnuma
+// dependency; topology comes from /sys on Linux. Elsewhere (or when
+// pinning is not permitted) the pool still runs with fixed owners, unpinned.
+//
+// SoaShard<C> lays a C-field state out as structure-of-arrays in one
+// page-aligned block (each field 64-byte aligned), directly usable as
+// EnvelopeSpec<C>::Channels.
+
+namespace numa {
+
+// CPUs of each NUMA node, restricted to the CPUs this process may run on
+struct Topology final {
+    std::vector<std::vector<unsigned>> nodes;
+
+    std::size_t node_count() const noexcept { return nodes.size(); }
+
+    std::size_t cpu_count() const noexcept {
+        std::size_t n = 0;
+        for (const auto& cpus : nodes) n += cpus.size();
+        return n;
+    }
+
+    // Node of cpu, or node_count() if unknown
+    std::size_t node_of_cpu(unsigned cpu) const noexcept {
+        for (std::size_t node = 0; node < nodes.size(); ++node) {
+            for (unsigned c : nodes[node]) {
+                if (c == cpu) return node;
+            }
+        }
+        return nodes.size();
+    }
+
+    // Interleaved over nodes (node 0 cpu 0, node 1 cpu 0, node 0 cpu 1, ...),
+    // so that the first workers spread over every node
+    std::vector<unsigned> interleaved_cpus() const {
+        std::vector<unsigned> out;
+        for (std::size_t i = 0; out.size() < cpu_count(); ++i) {
+            for (const auto& cpus : nodes) {
+                if (i < cpus.size()) out.push_back(cpus[i]);
+            }
+        }
+        return out;
+    }
+
+    static Topology detect() {
+        Topology t;
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool have_mask = ::sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        std::vector<unsigned> online;
+        if (read_cpulist("/sys/devices/system/node/online", online)) { // same list format
+            for (unsigned node : online) {
+                char path[64];
+                std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+                std::vector<unsigned> cpus;
+                if (!read_cpulist(path, cpus)) continue;
+
+                std::vector<unsigned> usable;
+                for (unsigned c : cpus) {
+                    if (!have_mask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed))) usable.push_back(c);
+                }
+                if (!usable.empty()) t.nodes.push_back(std::move(usable)); // memory-only nodes drop out
+            }
+        }
+
+        if (t.nodes.empty() && have_mask) {
+            std::vector<unsigned> cpus;
+            for (unsigned c = 0; c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+            }
+            if (!cpus.empty()) t.nodes.push_back(std::move(cpus));
+        }
+#endif
+        if (t.nodes.empty()) {
+            unsigned n = std::thread::hardware_concurrency();
+            if (n == 0) n = 1;
+            t.nodes.emplace_back();
+            for (unsigned c = 0; c < n; ++c) t.nodes.back().push_back(c);
+        }
+        return t;
+    }
+
+    // "0-3,8,10-11" => {0, 1, 2, 3, 8, 10, 11}; false if unreadable
+    static bool parse_cpulist(const char* s, std::vector<unsigned>& out) {
+        out.clear();
+        while (*s && *s != '\n') {
+            char* end = nullptr;
+            const unsigned long lo = std::strtoul(s, &end, 10);
+            if (end == s) return false;
+            unsigned long hi = lo;
+            s = end;
+            if (*s == '-') {
+                hi = std::strtoul(s + 1, &end, 10);
+                if (end == s + 1 || hi < lo) return false;
+                s = end;
+            }
+            for (unsigned long c = lo; c <= hi; ++c) out.push_back(static_cast<unsigned>(c));
+            if (*s == ',') ++s;
+        }
+        return true;
+    }
+
+private:
+    static bool read_cpulist(const char* path, std::vector<unsigned>& out) {
+        std::FILE* f = std::fopen(path, "r");
+        if (!f) return false;
+        char buf[4096];
+        const bool ok = std::fgets(buf, sizeof(buf), f) != nullptr;
+        std::fclose(f);
+        return ok && parse_cpulist(buf, out);
+    }
+};
+
+// Pins the calling thread to one CPU. Returns false if unsupported or denied.
+inline bool pin_current_thread(unsigned cpu) noexcept {
+#if defined(ASE_HAS_AFFINITY)
+    if (cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// CPU the calling thread runs on, or -1 if unknown
+inline int current_cpu() noexcept {
+#if defined(ASE_HAS_AFFINITY)
+    return ::sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// C fields of n doubles each, structure-of-arrays in one block: the block
+// is page-aligned and every field starts on a 64-byte boundary, so a
+// streaming pass over one field touches only its own lines. The fields are
+// zeroed by the constructor: construct the shard on the thread that will
+// enforce it (ShardPool::make_shards) so first touch places it on that
+// thread's node.
+template <std::size_t C>
+class SoaShard final {
+    static_assert(C > 0, "SoaShard needs at least one field");
+
+public:
+    using Channels = std::array<const double*, C>; // == EnvelopeSpec<C>::Channels
+
+    static constexpr std::size_t kPage = 4096;
+
+    explicit SoaShard(std::size_t n) : n_(n), stride_((n + 7) / 8 * 8) {
+        const std::size_t bytes = (C * stride_ * sizeof(double) + kPage - 1) / kPage * kPage;
+        data_ = static_cast<double*>(::operator new(bytes ? bytes : kPage, std::align_val_t{kPage}));
+        std::memset(data_, 0, bytes); // first touch
+    }
+
+    ~SoaShard() {
+        if (data_) ::operator delete(data_, std::align_val_t{kPage});
+    }
+
+    SoaShard(const SoaShard&) = delete;
+    SoaShard& operator=(const SoaShard&) = delete;
+
+    SoaShard(SoaShard&& o) noexcept : n_(o.n_), stride_(o.stride_), data_(o.data_) { o.data_ = nullptr; }
+    SoaShard& operator=(SoaShard&&) = delete;
+
+    std::size_t size() const noexcept { return n_; }
+
+    double* field(std::size_t c) noexcept { return data_ + c * stride_; }
+    const double* field(std::size_t c) const noexcept { return data_ + c * stride_; }
+
+    Channels channels() const noexcept {
+        Channels ch{};
+        for (std::size_t c = 0; c < C; ++c) ch[c] = field(c);
+        return ch;
+    }
+
+private:
+    std::size_t n_;
+    std::size_t stride_; // doubles per field (n rounded up to 8)
+    double* data_ = nullptr;
+};
+
+// Persistent workers with fixed ownership: shard s always runs on worker
+// owner(s) = s % worker_count(), in increasing s per worker. No stealing:
+// a slow shard delays its owner rather than moving to a remote node.
+// Results depend only on the shards, never on the worker count
+// (Specification §4.6). One job at a time; calls block until it is done.
+class ShardPool final {
+public:
+    // workers == 0 => one per usable CPU. With pin, worker w is pinned to
+    // topology().interleaved_cpus()[w % cpus].
+    explicit ShardPool(std::size_t workers = 0, bool pin = true, Topology topology = Topology::detect())
+        : topology_(std::move(topology)), cpus_(topology_.interleaved_cpus())
+    {
+        std::size_t n = workers ? workers : cpus_.size();
+        if (n == 0) n = 1;
+        cpu_of_.resize(n, -1);
+        pinned_.reset(new std::atomic<bool>[n]);
+        for (std::size_t w = 0; w < n; ++w) pinned_[w].store(false, std::memory_order_relaxed);
+
+        threads_.reserve(n);
+        for (std::size_t w = 0; w < n; ++w) {
+            if (!cpus_.empty()) cpu_of_[w] = static_cast<int>(cpus_[w % cpus_.size()]);
+            threads_.emplace_back([this, w, pin] { worker_main(w, pin); });
+        }
+        run([](std::size_t) {}); // every worker has pinned (or failed to)
+    }
+
+    ~ShardPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : threads_) t.join();
+    }
+
+    ShardPool(const ShardPool&) = delete;
+    ShardPool& operator=(const ShardPool&) = delete;
+
+    const Topology& topology() const noexcept { return topology_; }
+    std::size_t worker_count() const noexcept { return threads_.size(); }
+    std::size_t owner(std::size_t shard) const noexcept { return shard % threads_.size(); }
+
+    // CPU worker w is assigned to (-1 if none) and whether pinning succeeded
+    int cpu_of(std::size_t w) const noexcept { return cpu_of_[w]; }
+    bool pinned(std::size_t w) const noexcept { return pinned_[w].load(std::memory_order_acquire); }
+
+    // Node of worker w's CPU (topology().node_count() if unknown)
+    std::size_t node_of(std::size_t w) const noexcept {
+        return cpu_of_[w] < 0 ? topology_.node_count() : topology_.node_of_cpu(static_cast<unsigned>(cpu_of_[w]));
+    }
+
+    // fn(w) once on every worker w, concurrently (e.g. per-worker scratch).
+    // fn must not throw.
+    template <class Fn>
+    void run(Fn&& fn) {
+        using F = typename std::remove_reference<Fn>::type;
+        dispatch([](void* f, std::size_t w) { (*static_cast<F*>(f))(w); }, &fn);
+    }
+
+    // fn(s) for every s < count, each on worker owner(s). fn must not throw.
+    template <class Fn>
+    void for_each_shard(std::size_t count, Fn&& fn) {
+        const std::size_t workers = threads_.size();
+        run([&](std::size_t w) {
+            for (std::size_t s = w; s < count; s += workers) fn(s);
+        });
+    }
+
+    // shards[s] = make(s), each called on owner(s) so the shard's memory is
+    // first touched there. make returns a std::unique_ptr<T> and must not throw.
+    template <class Make>
+    auto make_shards(std::size_t count, Make&& make) -> std::vector<decltype(make(std::size_t{}))> {
+        std::vector<decltype(make(std::size_t{}))> shards(count);
+        for_each_shard(count, [&](std::size_t s) { shards[s] = make(s); });
+        return shards;
+    }
+
+private:
+    using JobFn = void (*)(void* job, std::size_t worker);
+
+    void dispatch(JobFn fn, void* job) {
+        std::lock_guard<std::mutex> serial(run_mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        fn_ = fn;
+        job_ = job;
+        pending_ = threads_.size();
+        ++generation_;
+        wake_.notify_all();
+        done_.wait(lock, [this] { return pending_ == 0; });
+        fn_ = nullptr;
+        job_ = nullptr;
+    }
+
+    void worker_main(std::size_t self, bool pin) {
+        if (pin && cpu_of_[self] >= 0) {
+            pinned_[self].store(pin_current_thread(static_cast<unsigned>(cpu_of_[self])), std::memory_order_release);
+        }
+
+        std::uint64_t seen = 0;
+        for (;;) {
+            JobFn fn = nullptr;
+            void* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                fn = fn_;
+                job = job_;
+            }
+
+            fn(job, self);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) done_.notify_one();
+            }
+        }
+    }
+
+    Topology topology_;
+    std::vector<unsigned> cpus_;
+    std::vector<int> cpu_of_;
+    std::unique_ptr<std::atomic<bool>[]> pinned_;
+    std::vector<std::thread> threads_;
+
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    std::uint64_t generation_ = 0;
+    std::size_t pending_ = 0;
+    JobFn fn_ = nullptr;
+    void* job_ = nullptr;
+};
+
+} // namespace numa
+} // namespace ase
@@ -0,0 +1,254 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ase/ase.hpp"
+
+namespace ase {
+
+// Thread-parallel driver for many independent enforcements (host-side).
+//
+// Engine is const and stateless per call (Specification §4.5), so independent
+// (S[i], ΔS[i]) pairs can be enforced concurrently. ParallelEnforcer fans a
+// range of pairs out over a persistent pool:
+//
+//   - the range is cut into fixed chunks of `chunk` pairs;
+//   - each worker owns a contiguous run of chunks and takes them from the
+//     front; an idle worker steals single chunks from the back of the others;
+//   - every chunk writes only its own preallocated output slots.
+//
+// out[i] is enforce(S[i], proposed[i]) whatever the thread count, chunk size
+// or scheduling order, which preserves the determinism guarantee
+// (Specification §4.6). The calling thread participates as worker 0.
+// Chunk indices are packed into 32 bits, so one scheduling run covers at
+// most kMaxChunksPerRun chunks; enforce splits larger ranges into
+// consecutive runs (same outputs, one extra barrier per run).
+// For large per-shard states on multi-socket machines, where one owner per
+// shard matters more than balance, see ase/numa.hpp (ShardPool).
+class ParallelEnforcer final {
+public:
+    // threads == 0 => std::thread::hardware_concurrency()
+    explicit ParallelEnforcer(std::size_t threads = 0, std::size_t chunk = 64)
+        : chunk_(chunk ? chunk : 1)
+    {
+        std::size_t n = threads ? threads : std::thread::hardware_concurrency();
+        if (n == 0) n = 1;
+
+        queues_ = std::vector<Queue>(n);
+        workers_.reserve(n - 1);
+        for (std::size_t w = 1; w < n; ++w) {
+            workers_.emplace_back([this, w] { worker_main(w); });
+        }
+    }
+
+    ~ParallelEnforcer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    ParallelEnforcer(const ParallelEnforcer&) = delete;
+    ParallelEnforcer& operator=(const ParallelEnforcer&) = delete;
+
+    // Chunks one run can schedule (a 32-bit half of Queue::bounds)
+    static constexpr std::size_t kMaxChunksPerRun = 0xffffffffu;
+
+    std::size_t thread_count() const noexcept { return queues_.size(); }
+    std::size_t chunk_size() const noexcept { return chunk_; }
+
+    // out[i] = engine.enforce(S[i], proposed[i]) for i < n; decisions (if
+    // non-null, Engine only) receives the matching records. Blocks until all
+    // pairs are enforced. out must not overlap S; it may alias proposed.
+    template <class EngineT, class State, class Step>
+    void enforce(const EngineT& engine, const State* S, const Step* proposed, Step* out,
+                 std::size_t n, Decision* decisions = nullptr)
+    {
+        if (n == 0) return;
+
+        // Pairs per run, saturating: kMaxChunksPerRun full chunks
+        const std::size_t per_run =
+            (chunk_ <= SIZE_MAX / kMaxChunksPerRun) ? kMaxChunksPerRun * chunk_ : SIZE_MAX;
+        for (std::size_t done = 0; done < n;) {
+            const std::size_t m = (n - done < per_run) ? (n - done) : per_run;
+            Job<EngineT, State, Step> job{engine, S + done, proposed + done, out + done,
+                                          decisions ? decisions + done : nullptr, m, chunk_};
+            run(&Job<EngineT, State, Step>::invoke, &job, m / chunk_ + (m % chunk_ != 0));
+            done += m;
+        }
+    }
+
+private:
+    // Packed [begin, end) chunk range: begin in the low 32 bits, end in the high.
+    struct alignas(64) Queue {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    static_assert(kMaxChunksPerRun <= 0xffffffffu, "chunk indices must fit a 32-bit half");
+
+    // begin, end <= kMaxChunksPerRun (run() enforces it)
+    static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) noexcept {
+        return (end << 32) | (begin & 0xffffffffu);
+    }
+
+    // Owner side: take the first chunk
+    static bool pop_front(Queue& q, std::size_t& chunk) noexcept {
+        std::uint64_t v = q.bounds.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint64_t b = v & 0xffffffffu;
+            const std::uint64_t e = v >> 32;
+            if (b >= e) return false;
+            if (q.bounds.compare_exchange_weak(v, pack(b + 1, e), std::memory_order_acq_rel)) {
+                chunk = static_cast<std::size_t>(b);
+                return true;
+            }
+        }
+    }
+
+    // Thief side: take the last chunk
+    static bool steal_back(Queue& q, std::size_t& chunk) noexcept {
+        std::uint64_t v = q.bounds.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint64_t b = v & 0xffffffffu;
+            const std::uint64_t e = v >> 32;
+            if (b >= e) return false;
+            if (q.bounds.compare_exchange_weak(v, pack(b, e - 1), std::memory_order_acq_rel)) {
+                chunk = static_cast<std::size_t>(e - 1);
+                return true;
+            }
+        }
+    }
+
+    using ChunkFn = void (*)(void* job, std::size_t chunk);
+
+    template <class EngineT, class State, class Step>
+    struct Job {
+        const EngineT& engine;
+        const State* S;
+        const Step* proposed;
+        Step* out;
+        Decision* decisions;
+        std::size_t n;
+        std::size_t chunk;
+
+        static void invoke(void* self, std::size_t c) {
+            const Job& j = *static_cast<const Job*>(self);
+            const std::size_t begin = c * j.chunk;
+            const std::size_t count = (j.n - begin < j.chunk) ? (j.n - begin) : j.chunk;
+            detail_enforce_chunk(j.engine, j.S + begin, j.proposed + begin, j.out + begin, count,
+                                 j.decisions ? j.decisions + begin : nullptr, 0);
+        }
+    };
+
+    // Engine: one batched call per chunk (hook checks / dispatch once per chunk)
+    template <class EngineT, class State, class Step>
+    static auto detail_enforce_chunk(const EngineT& engine, const State* S, const Step* proposed,
+                                     Step* out, std::size_t n, Decision* decisions, int)
+        -> decltype(engine.enforce_batch(S, proposed, out, n, decisions), void())
+    {
+        engine.enforce_batch(S, proposed, out, n, decisions);
+    }
+
+    // Any other engine (e.g. StaticEngine): element by element
+    template <class EngineT, class State, class Step>
+    static void detail_enforce_chunk(const EngineT& engine, const State* S, const Step* proposed,
+                                     Step* out, std::size_t n, Decision*, long)
+    {
+        for (std::size_t i = 0; i < n; ++i) out[i] = engine.enforce(S[i], proposed[i]);
+    }
+
+    // chunks <= kMaxChunksPerRun (enforce splits larger ranges)
+    void run(ChunkFn fn, void* job, std::size_t chunks) {
+        std::lock_guard<std::mutex> serial(run_mutex_); // one job at a time
+
+        // Contiguous run of chunks per worker (64-bit products: no overflow)
+        const std::size_t w_count = queues_.size();
+        for (std::size_t w = 0; w < w_count; ++w) {
+            const std::uint64_t b = static_cast<std::uint64_t>(chunks) * w / w_count;
+            const std::uint64_t e = static_cast<std::uint64_t>(chunks) * (w + 1) / w_count;
+            queues_[w].bounds.store(pack(b, e), std::memory_order_relaxed);
+        }
+
+        if (workers_.empty()) {
+            drain(0, fn, job);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn_ = fn;
+            job_ = job;
+            pending_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        drain(0, fn, job);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        fn_ = nullptr;
+        job_ = nullptr;
+    }
+
+    // Own chunks first, then steal until every queue is empty
+    void drain(std::size_t self, ChunkFn fn, void* job) noexcept {
+        std::size_t c = 0;
+        while (pop_front(queues_[self], c)) fn(job, c);
+
+        const std::size_t w_count = queues_.size();
+        for (std::size_t k = 1; k < w_count; ++k) {
+            Queue& victim = queues_[(self + k) % w_count];
+            while (steal_back(victim, c)) fn(job, c);
+        }
+    }
+
+    void worker_main(std::size_t self) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            ChunkFn fn = nullptr;
+            void* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                fn = fn_;
+                job = job_;
+            }
+
+            drain(self, fn, job);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) done_.notify_one();
+            }
+        }
+    }
+
+private:
+    std::size_t chunk_;
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    std::uint64_t generation_ = 0;
+    std::size_t pending_ = 0;
+    ChunkFn fn_ = nullptr;
+    void* job_ = nullptr;
+};
+
+} // namespace ase
@@ -0,0 +1,285 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+#include "ase/vector_envelope.hpp"
+
+namespace ase {
+namespace proj {
+
+// Exact projection kernels for Project mode over vector states (contiguous
+// doubles, next state = S + ΔS elementwise).
+//
+// Each set has
+//   admits(S, dS, n)                    S + dS in the set (a vec:: membership
+//                                       test, usable as is_admissible)
+//   project(S, in, out, n, certified)   out := P(S + in) - S, the Euclidean
+//                                       projection of the next state
+//
+// project returns false when it produces no output (non-finite input, an
+// empty set) and sets certified iff admits(S, out, n) holds. Rounding of
+// S + out is corrected in the kernel (a nudge by one ulp, a shrink of the
+// L2 radius by a few ulps), so certified is the rule rather than the
+// exception, and the certificate is the same floating-point test as admits:
+//
+//   static const ase::proj::L2Ball ball{R};
+//   bool project(const Vec& S, const Vec& in, Vec& out, bool& certified) {
+//       out.resize(in.size());
+//       return ball.project(S.data(), in.data(), out.data(), in.size(), certified);
+//   }
+//   deps.project_step_certified = &project;   // with is_admissible == ball.admits
+//
+// With a certified output the engine skips its post-projection evaluation,
+// so Project mode costs one evaluation of the proposal plus an O(N) kernel
+// (O(N log N) for the simplex, bounded Dykstra iterations for an
+// intersection). A host whose admissible set is more than the kernel's set
+// MUST NOT forward certified (Dependencies::project_step_certified).
+//
+// out must not alias S or in. Kernels are deterministic: their reductions
+// use the fixed lane order of ase/vector_envelope.hpp (Specification §4.6).
+
+namespace detail {
+
+// out = clamp(S + in, lo, hi) - S, nudged until S + out lies in [lo, hi].
+// Returns false if out is not finite; certified &= membership of S + out.
+inline bool clamp_element(double S, double in, double lo, double hi, double& out, bool& certified) noexcept {
+    const double v = S + in;
+    if (lo <= v && v <= hi) {
+        out = in;
+        return true;
+    }
+
+    double o = (v < lo ? lo : hi) - S;
+    for (int i = 0; i < 4 && std::isfinite(o); ++i) {
+        const double w = S + o;
+        if (w > hi) {
+            o = std::nextafter(o, -HUGE_VAL);
+        } else if (w < lo) {
+            o = std::nextafter(o, HUGE_VAL);
+        } else {
+            out = o;
+            return true;
+        }
+    }
+    out = o;
+    certified = false;
+    return std::isfinite(o);
+}
+
+} // namespace detail
+
+// ||S + dS||2 <= R
+struct L2Ball final {
+    double R = 0.0;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return vec::next_in_l2_ball(S, dS, n, R);
+    }
+
+    // Radial projection c · (S + in) with c = R / ||S + in||; c is shrunk
+    // by a few ulps when rounding puts the result outside the ball.
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        if (!(R >= 0.0) || !std::isfinite(R)) return false;
+
+        const double sq = vec::detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& acc, auto&) {
+            using P = decltype(p);
+            const auto v = P::add(P::load(S + i), P::load(in + i));
+            acc = P::add(acc, P::mul(v, v));
+        }).sum;
+        if (!std::isfinite(sq)) return false;
+
+        if (std::sqrt(sq) <= R) {
+            std::copy(in, in + n, out);
+            certified = true;
+            return true;
+        }
+
+        const double c = R / std::sqrt(sq);
+        double shrink = 1.0;
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            const double k = c * shrink;
+            if (!vec::detail::map_finite(n, out, [&](auto p, std::size_t i) {
+                    using P = decltype(p);
+                    const auto s = P::load(S + i);
+                    return P::sub(P::mul(P::set1(k), P::add(s, P::load(in + i))), s);
+                })) {
+                return false;
+            }
+            if (admits(S, out, n)) {
+                certified = true;
+                return true;
+            }
+            shrink = 1.0 - std::ldexp(1.0, -48 + 8 * (attempt + 1)); // 1 - 2^-40, 2^-32, 2^-24
+        }
+        return true;
+    }
+};
+
+// |S[i] + dS[i]| <= R
+struct LinfBall final {
+    double R = 0.0;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return vec::next_in_linf_ball(S, dS, n, R);
+    }
+
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        if (!(R >= 0.0) || !std::isfinite(R)) return false;
+        bool cert = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(S[i]) || !std::isfinite(in[i])) return false;
+            if (!detail::clamp_element(S[i], in[i], -R, R, out[i], cert)) return false;
+        }
+        certified = cert;
+        return true;
+    }
+};
+
+// lo[i] <= S[i] + dS[i] <= hi[i] (bounds may be infinite)
+struct Box final {
+    const double* lo = nullptr;
+    const double* hi = nullptr;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return vec::next_in_box(S, dS, lo, hi, n);
+    }
+
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        bool cert = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!std::isfinite(S[i]) || !std::isfinite(in[i]) || !(lo[i] <= hi[i])) return false;
+            if (!detail::clamp_element(S[i], in[i], lo[i], hi[i], out[i], cert)) return false;
+        }
+        certified = cert;
+        return true;
+    }
+};
+
+// S[i] + dS[i] >= -eps for i < k (e.g. a second-moment channel); the
+// remaining elements are passed through.
+struct SignPrefix final {
+    std::size_t k = 0;
+    double eps = 0.0;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return k <= n && vec::next_sign_prefix_nonneg(S, dS, k, eps);
+    }
+
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        if (k > n || !(eps >= 0.0) || !std::isfinite(eps)) return false;
+        bool cert = true;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (!std::isfinite(S[i]) || !std::isfinite(in[i])) return false;
+            if (!detail::clamp_element(S[i], in[i], -eps, HUGE_VAL, out[i], cert)) return false;
+        }
+        std::copy(in + k, in + n, out + k);
+        certified = cert;
+        return true;
+    }
+};
+
+// S[i] + dS[i] >= 0 and |Σ (S[i] + dS[i]) - total| <= tol (probability
+// vectors, budget allocations). work: n doubles, caller-owned.
+struct Simplex final {
+    double total = 1.0;
+    double tol = 0.0;
+    double* work = nullptr;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return vec::next_in_simplex(S, dS, n, total, tol);
+    }
+
+    // Sort-based threshold: x = max(y - τ, 0) with Σ x = total
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        if (n == 0 || !work || !(total > 0.0) || !std::isfinite(total) || !(tol >= 0.0)) return false;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            work[i] = S[i] + in[i];
+            if (!std::isfinite(work[i])) return false;
+        }
+        std::sort(work, work + n, std::greater<double>());
+
+        double cum = 0.0;
+        double tau = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            cum += work[j];
+            const double t = (cum - total) / static_cast<double>(j + 1);
+            if (work[j] - t > 0.0) tau = t;
+        }
+        if (!std::isfinite(tau)) return false;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const double x = S[i] + in[i] - tau;
+            double o = (x > 0.0 ? x : 0.0) - S[i];
+            if (S[i] + o < 0.0) o = -S[i]; // S + (-S) == 0 exactly
+            if (!std::isfinite(o)) return false;
+            out[i] = o;
+        }
+        certified = admits(S, out, n);
+        return true;
+    }
+};
+
+// A ∩ B by Dykstra's alternating projections, at most max_iterations
+// rounds; stops at the first iterate both sets admit. The last projection
+// of each round is onto B, so order the sets so that P_B keeps membership
+// in A where possible (e.g. SignPrefix then L2Ball: radial shrinking keeps
+// signs), which certifies in one or two rounds. work: 4n doubles,
+// caller-owned (separate from any work buffer of A or B). Intersections
+// nest: Intersection<Intersection<A, B>, C>.
+template <class A, class B>
+struct Intersection final {
+    A a;
+    B b;
+    double* work = nullptr;
+    std::size_t max_iterations = 16;
+
+    bool admits(const double* S, const double* dS, std::size_t n) const noexcept {
+        return a.admits(S, dS, n) && b.admits(S, dS, n);
+    }
+
+    bool project(const double* S, const double* in, double* out, std::size_t n, bool& certified) const noexcept {
+        certified = false;
+        if (!work || max_iterations == 0) return false;
+        double* const t = work;     // input of the next projection
+        double* const y = work + n; // iterate in A
+        double* const p = y + n;    // Dykstra increments
+        double* const q = p + n;
+
+        std::copy(in, in + n, out);
+        std::fill(p, p + 2 * n, 0.0); // p and q
+        for (std::size_t it = 0; it < max_iterations; ++it) {
+            bool in_a = false;
+            bool in_b = false;
+            for (std::size_t i = 0; i < n; ++i) t[i] = out[i] + p[i];
+            if (!a.project(S, t, y, n, in_a)) return false;
+            for (std::size_t i = 0; i < n; ++i) {
+                p[i] = t[i] - y[i];
+                t[i] = y[i] + q[i];
+            }
+            if (!b.project(S, t, out, n, in_b)) return false;
+            for (std::size_t i = 0; i < n; ++i) q[i] = t[i] - out[i];
+
+            if (in_b && a.admits(S, out, n)) {
+                certified = true;
+                return true;
+            }
+        }
+        return true;
+    }
+};
+
+template <class A, class B>
+Intersection<A, B> intersect(A a, B b, double* work, std::size_t max_iterations = 16) noexcept {
+    return Intersection<A, B>{a, b, work, max_iterations};
+}
+
+} // namespace proj
+} // namespace ase
@@ -0,0 +1,409 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "ase/ase.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define ASE_HAS_MMAP 1
+#endif
+
+namespace ase {
+
+// Replay log of enforcement decisions (host-side, outside the engine).
+//
+// The engine does no I/O (Integration Constraints); the host records each
+// call after it returns:
+//
+//   ase::ReplayRecorder rec;
+//   rec.open("ase.replay", 1 << 20);            // ring of 2^20 records, 64 MiB
+//   const ase::EnforceOutcome<Step> r = engine.enforce_outcome(S, dS, hint);
+//   rec.record(hash(S), hash(dS), r, hash(r.step), hint, tick);
+//
+// The file is a fixed header plus a power-of-two ring of 64-byte records,
+// mapped MAP_SHARED: a record reaches the page cache when record() returns
+// and survives a crash of the process. Appends are lock-free (one
+// fetch_add and plain stores, as in TraceRing); when the ring is full the
+// oldest records are overwritten. Threads that record at high rates should
+// use one recorder (file) each, so they do not share the head counter.
+//
+// Offline, ReplayLog reads the file and replay::verify re-runs Engine on
+// inputs the host reproduces (from a checkpoint, a seed, a capture) and
+// checks every recorded decision against the re-run.
+
+namespace replay {
+
+// 64-bit content hash of a byte range (four independent multiply-rotate
+// lanes over 8-byte little-endian words, then a final avalanche). Fixed
+// algorithm: the same bytes give the same hash on every little-endian host.
+// Not cryptographic.
+inline std::uint64_t hash_bytes(const void* data, std::size_t bytes, std::uint64_t seed = 0) noexcept {
+    constexpr std::uint64_t P1 = 0x9E3779B185EBCA87ull;
+    constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+    const auto rotl = [](std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    const auto lane = [&](std::uint64_t h, std::uint64_t w) { return rotl(h + w * P2, 31) * P1; };
+
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i + 8 * l, 8);
+            h[l] = lane(h[l], w);
+        }
+    }
+
+    std::uint64_t acc = rotl(h[0], 1) + rotl(h[1], 7) + rotl(h[2], 12) + rotl(h[3], 18);
+    acc += static_cast<std::uint64_t>(bytes);
+    for (; i + 8 <= bytes; i += 8) {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        acc = rotl(acc ^ lane(0, w), 27) * P1 + P2;
+    }
+    for (; i < bytes; ++i) acc = rotl(acc ^ (p[i] * P1), 11) * P2;
+
+    acc ^= acc >> 33;
+    acc *= P2;
+    acc ^= acc >> 29;
+    acc *= P1;
+    acc ^= acc >> 32;
+    return acc;
+}
+
+inline std::uint64_t hash_doubles(const double* x, std::size_t n) noexcept {
+    return hash_bytes(x, n * sizeof(double));
+}
+
+// One enforcement as recorded. output_hash == 0 => not recorded.
+struct Record final {
+    std::uint64_t seq = 0;         // append index (0, 1, 2, ...)
+    std::uint64_t state_hash = 0;
+    std::uint64_t step_hash = 0;   // proposed ΔS
+    std::uint64_t output_hash = 0; // ΔS'
+    double k = 0.0;
+    double hint = 1.0;             // ScaleHint::k of the call
+    Outcome kind = Outcome::Neutral;
+    std::uint8_t attempts = 0;
+    std::uint32_t tag = 0;         // host's own id (tick, stream)
+};
+
+constexpr char kMagic[8] = {'A', 'S', 'E', 'R', 'P', 'L', 'Y', '1'};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "replay log needs lock-free 64-bit atomics");
+
+// File layout: Header, then capacity Slots
+struct alignas(64) Header {
+    char magic[8];
+    std::uint32_t record_bytes;
+    std::uint32_t reserved;
+    std::uint64_t capacity;          // power of two
+    std::atomic<std::uint64_t> head; // records ever appended
+};
+
+// seq == 2*i + 1 while record i is written, 2*i + 2 once it is published
+struct alignas(64) Slot {
+    std::atomic<std::uint64_t> seq;
+    std::atomic<std::uint64_t> state_hash;
+    std::atomic<std::uint64_t> step_hash;
+    std::atomic<std::uint64_t> output_hash;
+    std::atomic<std::uint64_t> k_bits;
+    std::atomic<std::uint64_t> hint_bits;
+    std::atomic<std::uint64_t> meta; // kind | attempts << 8 | tag << 32
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(Slot) == 64, "replay record must stay 64 bytes");
+
+inline std::uint64_t bits_of(double x) noexcept {
+    std::uint64_t b;
+    std::memcpy(&b, &x, sizeof b);
+    return b;
+}
+
+inline double double_of(std::uint64_t b) noexcept {
+    double x;
+    std::memcpy(&x, &b, sizeof x);
+    return x;
+}
+
+inline bool valid_header(const Header& h, std::size_t bytes) noexcept {
+    return std::memcmp(h.magic, kMagic, sizeof kMagic) == 0 && h.record_bytes == sizeof(Slot) &&
+           h.capacity > 0 && (h.capacity & (h.capacity - 1)) == 0 &&
+           bytes == sizeof(Header) + h.capacity * sizeof(Slot);
+}
+
+// Shared mapping of one log file
+class Mapping {
+public:
+    Mapping() noexcept = default;
+    ~Mapping() { close(); }
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    // capacity > 0: create (or reuse a valid log of that capacity) for
+    // writing; capacity == 0: open an existing log read-only. Only a new or
+    // empty file is initialized: any other file (a log of another capacity,
+    // an unrelated file) makes open fail and is left untouched.
+    bool open(const char* path, std::uint64_t capacity) noexcept {
+        close();
+#if defined(ASE_HAS_MMAP)
+        const bool write = capacity > 0;
+        if (write && (capacity & (capacity - 1)) != 0) return false;
+
+        const int fd = write ? ::open(path, O_RDWR | O_CREAT, 0644) : ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        const std::size_t want = sizeof(Header) + static_cast<std::size_t>(capacity) * sizeof(Slot);
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        const bool fresh = write && bytes == 0;
+        if (fresh) {
+            if (::ftruncate(fd, static_cast<off_t>(want)) != 0) {
+                ::close(fd);
+                return false;
+            }
+            bytes = want;
+        }
+        if (bytes < sizeof(Header) || (write && bytes != want)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* p = ::mmap(nullptr, bytes, write ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (p == MAP_FAILED) return false;
+        addr_ = p;
+        bytes_ = bytes;
+
+        Header* h = static_cast<Header*>(p);
+        if (fresh) {
+            h = new (p) Header{};
+            std::memcpy(h->magic, kMagic, sizeof kMagic);
+            h->record_bytes = sizeof(Slot);
+            h->capacity = capacity;
+            Slot* s = reinterpret_cast<Slot*>(static_cast<char*>(p) + sizeof(Header));
+            for (std::uint64_t i = 0; i < capacity; ++i) new (s + i) Slot{};
+            h->head.store(0, std::memory_order_release);
+        }
+        // An existing file is reused only as a log of this capacity
+        if (!valid_header(*h, bytes) || (write && h->capacity != capacity)) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        (void)path;
+        (void)capacity;
+        return false;
+#endif
+    }
+
+    void close() noexcept {
+#if defined(ASE_HAS_MMAP)
+        if (addr_) ::munmap(addr_, bytes_);
+#endif
+        addr_ = nullptr;
+        bytes_ = 0;
+    }
+
+    // Schedules written pages for write-back (MS_ASYNC); false on error
+    bool sync() const noexcept {
+#if defined(ASE_HAS_MMAP)
+        return addr_ && ::msync(addr_, bytes_, MS_ASYNC) == 0;
+#else
+        return false;
+#endif
+    }
+
+    bool is_open() const noexcept { return addr_ != nullptr; }
+    Header* header() const noexcept { return static_cast<Header*>(addr_); }
+    Slot* slots() const noexcept {
+        return reinterpret_cast<Slot*>(static_cast<char*>(addr_) + sizeof(Header));
+    }
+
+private:
+    void* addr_ = nullptr;
+    std::size_t bytes_ = 0;
+};
+
+} // namespace replay
+
+// Append side. record() is a no-op while no log is open.
+class ReplayRecorder final {
+public:
+    // Creates path as an empty ring of capacity records (a power of two), or
+    // continues an existing log of the same capacity after its last record.
+    // Returns false on any failure (no exceptions), including a non-empty
+    // file at path that is not such a log; that file is not modified.
+    bool open(const char* path, std::uint64_t capacity) noexcept {
+        if (capacity == 0 || !map_.open(path, capacity)) return false;
+        mask_ = capacity - 1;
+        return true;
+    }
+
+    void close() noexcept {
+        map_.close();
+        mask_ = 0;
+    }
+
+    bool is_open() const noexcept { return map_.is_open(); }
+    bool sync() const noexcept { return map_.sync(); }
+
+    // Records ever appended (including overwritten ones)
+    std::uint64_t recorded() const noexcept {
+        return map_.is_open() ? map_.header()->head.load(std::memory_order_acquire) : 0;
+    }
+
+    // Lock-free append, callable from any thread. output_hash = 0 => ΔS'
+    // not hashed.
+    void record(std::uint64_t state_hash, std::uint64_t step_hash, const Decision& d,
+                std::uint64_t output_hash = 0, ScaleHint hint = {}, std::uint32_t tag = 0) noexcept {
+        record(state_hash, step_hash, d.kind, d.k, d.attempts, output_hash, hint.k, tag);
+    }
+
+    template <class Step>
+    void record(std::uint64_t state_hash, std::uint64_t step_hash, const EnforceOutcome<Step>& r,
+                std::uint64_t output_hash = 0, ScaleHint hint = {}, std::uint32_t tag = 0) noexcept {
+        record(state_hash, step_hash, r.kind, r.k, r.attempts, output_hash, hint.k, tag);
+    }
+
+private:
+    void record(std::uint64_t state_hash, std::uint64_t step_hash, Outcome kind, double k,
+                std::uint8_t attempts, std::uint64_t output_hash, double hint, std::uint32_t tag) noexcept {
+        if (!map_.is_open()) return;
+        const std::uint64_t i = map_.header()->head.fetch_add(1, std::memory_order_relaxed);
+        replay::Slot& s = map_.slots()[i & mask_];
+
+        s.seq.store(2 * i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.state_hash.store(state_hash, std::memory_order_relaxed);
+        s.step_hash.store(step_hash, std::memory_order_relaxed);
+        s.output_hash.store(output_hash, std::memory_order_relaxed);
+        s.k_bits.store(replay::bits_of(k), std::memory_order_relaxed);
+        s.hint_bits.store(replay::bits_of(hint), std::memory_order_relaxed);
+        s.meta.store(static_cast<std::uint64_t>(kind) | (std::uint64_t{attempts} << 8) |
+                         (std::uint64_t{tag} << 32),
+                     std::memory_order_relaxed);
+        s.seq.store(2 * i + 2, std::memory_order_release);
+    }
+
+    replay::Mapping map_;
+    std::uint64_t mask_ = 0;
+};
+
+// Read side (offline, or live next to a recorder)
+class ReplayLog final {
+public:
+    bool open(const char* path) noexcept { return map_.open(path, 0); }
+    void close() noexcept { map_.close(); }
+    bool is_open() const noexcept { return map_.is_open(); }
+
+    std::uint64_t capacity() const noexcept { return map_.is_open() ? map_.header()->capacity : 0; }
+    std::uint64_t recorded() const noexcept {
+        return map_.is_open() ? map_.header()->head.load(std::memory_order_acquire) : 0;
+    }
+
+    // Oldest retained record and one past the newest
+    std::uint64_t first() const noexcept {
+        const std::uint64_t head = recorded();
+        return head > capacity() ? head - capacity() : 0;
+    }
+    std::uint64_t end() const noexcept { return recorded(); }
+
+    // false if record seq is not retained or is being written
+    bool read(std::uint64_t seq, replay::Record& out) const noexcept {
+        if (!map_.is_open() || seq >= recorded() || seq < first()) return false;
+        const replay::Slot& s = map_.slots()[seq & (capacity() - 1)];
+        if (s.seq.load(std::memory_order_acquire) != 2 * seq + 2) return false;
+
+        replay::Record r;
+        r.seq = seq;
+        r.state_hash = s.state_hash.load(std::memory_order_relaxed);
+        r.step_hash = s.step_hash.load(std::memory_order_relaxed);
+        r.output_hash = s.output_hash.load(std::memory_order_relaxed);
+        r.k = replay::double_of(s.k_bits.load(std::memory_order_relaxed));
+        r.hint = replay::double_of(s.hint_bits.load(std::memory_order_relaxed));
+        const std::uint64_t m = s.meta.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) != 2 * seq + 2) return false;
+
+        r.kind = static_cast<Outcome>(m & 0xFFu);
+        r.attempts = static_cast<std::uint8_t>((m >> 8) & 0xFFu);
+        r.tag = static_cast<std::uint32_t>(m >> 32);
+        out = r;
+        return true;
+    }
+
+private:
+    replay::Mapping map_;
+};
+
+namespace replay {
+
+struct VerifyReport final {
+    std::uint64_t checked = 0;           // records re-run
+    std::uint64_t skipped = 0;           // not retained / no inputs from the source
+    std::uint64_t input_mismatches = 0;  // reproduced S or ΔS hash differently
+    std::uint64_t decision_mismatches = 0; // re-run disagrees (kind, k, attempts, ΔS')
+    std::uint64_t first_mismatch = UINT64_MAX; // seq of the first mismatch
+
+    bool ok() const noexcept { return input_mismatches == 0 && decision_mismatches == 0; }
+};
+
+// Re-runs engine.enforce_outcome for every retained record in [first, end).
+//   source(const Record&, State& S, Step& dS) -> bool   reproduce the inputs
+//                                                      (false => skipped)
+//   hash_state(const State&) / hash_step(const Step&) -> std::uint64_t
+//                                                      the hashes used when recording
+// A record matches when its inputs hash the same and the re-run yields the
+// same kind, k (bit for bit), attempts and, if recorded, ΔS' hash.
+//
+//   auto rep = ase::replay::verify<State, Step>(log, engine, log.first(), log.end(), source, hs, hd);
+template <class State, class Step, class EngineT, class Source, class HashState, class HashStep>
+VerifyReport verify(const ReplayLog& log, const EngineT& engine, std::uint64_t first, std::uint64_t end,
+                    Source&& source, HashState&& hash_state, HashStep&& hash_step) {
+    VerifyReport rep;
+    State S{};
+    Step dS{};
+    const auto mismatch = [&rep](std::uint64_t& counter, std::uint64_t seq) {
+        ++counter;
+        if (seq < rep.first_mismatch) rep.first_mismatch = seq;
+    };
+
+    for (std::uint64_t seq = first; seq < end; ++seq) {
+        Record r;
+        if (!log.read(seq, r) || !source(r, S, dS)) {
+            ++rep.skipped;
+            continue;
+        }
+        ++rep.checked;
+
+        if (hash_state(S) != r.state_hash || hash_step(dS) != r.step_hash) {
+            mismatch(rep.input_mismatches, seq);
+            continue;
+        }
+
+        const EnforceOutcome<Step> out = engine.enforce_outcome(S, dS, ScaleHint{r.hint});
+        const bool same = out.kind == r.kind && bits_of(out.k) == bits_of(r.k) && out.attempts == r.attempts &&
+                          (r.output_hash == 0 || hash_step(out.step) == r.output_hash);
+        if (!same) mismatch(rep.decision_mismatches, seq);
+    }
+    return rep;
+}
+
+} // namespace replay
+
+} // namespace ase
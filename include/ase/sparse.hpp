@@ -0,0 +1,388 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "ase/vector_envelope.hpp"
+
+namespace ase {
+
+// Sparse steps for mostly-zero updates (embedding rows, top-k compressed
+// gradients). A step touches nnz coordinates of a dense state of size N:
+//
+//   ΔS = k · Σ_j value[j] · e_index[j],   index strictly increasing, < N
+//
+// Checking, scaling, projecting and applying such a step costs O(nnz), not
+// O(N). The L2 ball is the only non-separable piece of the usual envelope:
+// it is evaluated from a cached Σ S[i]^2 plus the change on the touched
+// coordinates, Σ d (2 S[i] + d). The host keeps that cache next to the state
+// (SparseStateView::of once, then every apply_step updates it).
+//
+// The cache drifts: every incremental update is rounded. SparseStateView
+// carries a bound on that drift (sum_sq_err), apply_step grows it, and the
+// L2 test compares against a ball shrunk by it and by the rounding of the
+// check itself. Refresh policy: the SparseStateView overload of apply_step
+// recomputes sum_sq from the state (one O(N) pass, drift reset) every
+// kSparseRefreshApplies applies; hosts that keep a bare sum_sq re-seed it
+// with SparseStateView::of at least that often.
+//
+// Per-coordinate limits (L∞, sign prefix) are checked on the touched
+// coordinates only: the others keep the values of S. That assumes S is
+// already admissible (it is if every step the host applied was); unlike
+// the dense vec::next_within, a violation outside the touched coordinates
+// is not detected. Index lists that are not strictly increasing or run past
+// N are rejected (fail-closed).
+//
+//   using Engine = ase::Engine<ase::SparseStateView, ase::SparseStepView>;
+//   deps.neutral_step = &ase::neutral_sparse;
+//   deps.scale_step   = &ase::scale_sparse;   // k only, values never copied
+//
+// Views do not own memory (see ase/views.hpp); SparseStep owns its arrays
+// and is the Step type for Project mode, where new values are written.
+
+// Applies between full recomputations of the cached Σ S[i]^2
+constexpr std::size_t kSparseRefreshApplies = 1024;
+
+namespace vec {
+
+namespace detail {
+
+constexpr double kSparseUnit = 1.0 / 9007199254740992.0; // 2^-53
+
+// Rounding bound of a sparse_sum_squares_delta over nnz terms, given
+// mag = Σ (|S[i]| + |d|)^2: each term is rounded a few times, the sum
+// nnz times, and the stored S[i] + d once more.
+inline double sparse_delta_err(double mag, std::size_t nnz) noexcept {
+    return static_cast<double>(nnz + 8) * kSparseUnit * mag;
+}
+
+// sum_sq + delta within the ball, after both error bounds and the
+// rounding of the comparison
+inline bool sparse_l2_within(double sum_sq, double sum_sq_err, double delta, double delta_err,
+                             double l2) noexcept {
+    const double next = std::fmax(0.0, sum_sq + delta);
+    const double upper = (next + sum_sq_err + delta_err) * (1.0 + 4.0 * kSparseUnit);
+    return std::isfinite(upper) && upper <= l2 * l2 * (1.0 - 2.0 * kSparseUnit);
+}
+
+} // namespace detail
+
+// Bound on |vec::sum_squares(x, n) - Σ x[i]^2| given its result
+inline double sum_squares_err(double sum_sq, std::size_t n) noexcept {
+    return 2.0 * static_cast<double>(n + 4) * detail::kSparseUnit * sum_sq;
+}
+
+// ----------------------------
+// Kernels over (index, value, nnz) arrays.
+// Sums run in j order, so results are deterministic and ISA-independent.
+// ----------------------------
+
+// index strictly increasing and every index < n
+inline bool sparse_indices_valid(const std::size_t* index, std::size_t nnz, std::size_t n) noexcept {
+    for (std::size_t j = 0; j < nnz; ++j) {
+        if (index[j] >= n || (j > 0 && index[j] <= index[j - 1])) return false;
+    }
+    return true;
+}
+
+// ||S + k·ΔS||2^2 - ||S||2^2 over the touched coordinates
+inline double sparse_sum_squares_delta(const double* S, const std::size_t* index, const double* value,
+                                       double k, std::size_t nnz) noexcept {
+    double delta = 0.0;
+    for (std::size_t j = 0; j < nnz; ++j) {
+        const double d = k * value[j];
+        delta += d * (2.0 * S[index[j]] + d);
+    }
+    return delta;
+}
+
+// S + k·ΔS satisfies lim and |k·value[j]| <= lim.step_linf, where sum_sq is
+// the cached Σ S[i]^2 and sum_sq_err bounds its drift. The L2 test is
+// conservative (both bounds and the check's own rounding); L∞ and the sign
+// prefix are checked on the touched coordinates only, so S is assumed to
+// be admissible. The next state is never stored.
+inline bool next_sparse_within(const double* S, double sum_sq, const std::size_t* index, const double* value,
+                               double k, std::size_t nnz, std::size_t n, const BlockLimits& lim,
+                               double sum_sq_err = 0.0) noexcept {
+    if (!std::isfinite(k) || !std::isfinite(sum_sq) || !sparse_indices_valid(index, nnz, n)) return false;
+    if (!(sum_sq_err >= 0.0) || !std::isfinite(sum_sq_err)) return false;
+
+    double delta = 0.0;
+    double mag = 0.0;
+    for (std::size_t j = 0; j < nnz; ++j) {
+        const std::size_t i = index[j];
+        const double d = k * value[j];
+        const double x = S[i] + d;
+        if (!std::isfinite(d) || !std::isfinite(x)) return false;
+        if (std::fabs(d) > lim.step_linf || std::fabs(x) > lim.linf) return false;
+        if (i < lim.sign_prefix && x < lim.sign_floor) return false;
+        delta += d * (2.0 * S[i] + d);
+        const double m = std::fabs(S[i]) + std::fabs(d);
+        mag += m * m;
+    }
+
+    return detail::sparse_l2_within(sum_sq, sum_sq_err, delta, detail::sparse_delta_err(mag, nnz), lim.l2);
+}
+
+// Largest k in (0, 1] with ||S + k·ΔS||2 <= R, from the cached sum_sq in
+// O(nnz) (closed form of the quadratic in k). Usable as a solve_scale body;
+// false if S itself is outside the ball or the inputs are not finite.
+inline bool sparse_l2_scale_limit(const double* S, double sum_sq, const std::size_t* index,
+                                  const double* value, std::size_t nnz, double R, double& k_max) noexcept {
+    double a = 0.0; // ||ΔS||^2
+    double b = 0.0; // <S, ΔS>
+    for (std::size_t j = 0; j < nnz; ++j) {
+        a += value[j] * value[j];
+        b += S[index[j]] * value[j];
+    }
+    const double c = sum_sq - R * R;
+    if (!std::isfinite(a) || !std::isfinite(b) || !std::isfinite(c) || c > 0.0) return false;
+
+    if (a == 0.0) {
+        k_max = 1.0;
+        return true;
+    }
+    // Root of a k^2 + 2 b k + c = 0 with k >= 0, without cancellation
+    const double disc = std::sqrt(b * b - a * c);
+    const double k = (b > 0.0) ? -c / (b + disc) : (disc - b) / a;
+    if (!std::isfinite(k)) return false;
+    k_max = (k < 1.0) ? k : 1.0;
+    return true;
+}
+
+// Projection of a sparse step onto lim, keeping its sparsity pattern:
+// out[j] is value[j] clipped to the step bound, then to the L∞ box and the
+// sign floor around S; if the L2 ball is still violated, the whole step is
+// scaled back toward S, into the ball shrunk by the error bounds of
+// next_sparse_within (and slightly further, so the engine's re-check is
+// not lost to rounding). out may alias value.
+// false if S itself violates the shrunk ball or some input is not finite.
+inline bool project_sparse_into(const double* S, double sum_sq, const std::size_t* index, const double* value,
+                                std::size_t nnz, std::size_t n, const BlockLimits& lim, double* out,
+                                double sum_sq_err = 0.0) noexcept {
+    if (!std::isfinite(sum_sq) || !sparse_indices_valid(index, nnz, n)) return false;
+    if (!(sum_sq_err >= 0.0) || !std::isfinite(sum_sq_err)) return false;
+
+    for (std::size_t j = 0; j < nnz; ++j) {
+        const std::size_t i = index[j];
+        double d = value[j];
+        if (!std::isfinite(d) || !std::isfinite(S[i])) return false;
+
+        d = std::fmin(lim.step_linf, std::fmax(-lim.step_linf, d));
+        double x = std::fmin(lim.linf, std::fmax(-lim.linf, S[i] + d));
+        if (i < lim.sign_prefix) x = std::fmax(lim.sign_floor, x);
+        out[j] = x - S[i];
+    }
+
+    double mag = 0.0;
+    for (std::size_t j = 0; j < nnz; ++j) {
+        const double m = std::fabs(S[index[j]]) + std::fabs(out[j]);
+        mag += m * m;
+    }
+    if (detail::sparse_l2_within(sum_sq, sum_sq_err, sparse_sum_squares_delta(S, index, out, 1.0, nnz),
+                                 detail::sparse_delta_err(mag, nnz), lim.l2)) {
+        return true;
+    }
+
+    // Σ (|S[i]| + |k d|)^2 <= 10 l2^2 for S and S + k·ΔS in the ball, so the
+    // delta error at the solved k is at most sparse_delta_err(10 l2^2, nnz)
+    const double l2_sq = lim.l2 * lim.l2;
+    const double r2 = l2_sq * (1.0 - 8.0 * detail::kSparseUnit) - sum_sq_err -
+                      detail::sparse_delta_err(10.0 * l2_sq, nnz);
+    if (!(r2 > 0.0)) return false;
+
+    double k = 0.0;
+    if (!sparse_l2_scale_limit(S, sum_sq, index, out, nnz, std::sqrt(r2), k)) return false;
+    k *= 1.0 - 1e-12;
+    for (std::size_t j = 0; j < nnz; ++j) out[j] *= k;
+    return true;
+}
+
+// state[index[j]] += k · value[j], with *sum_sq (optional) updated by the
+// same incremental formula the checks use and *sum_sq_err (optional) grown
+// by its rounding bound. false on an invalid index list (nothing written)
+// or a non-finite result (state already written).
+inline bool apply_sparse(const std::size_t* index, const double* value, double k, std::size_t nnz,
+                         double* state, std::size_t n, double* sum_sq = nullptr,
+                         double* sum_sq_err = nullptr) noexcept {
+    if (!std::isfinite(k) || !sparse_indices_valid(index, nnz, n)) return false;
+    if (sum_sq) *sum_sq += sparse_sum_squares_delta(state, index, value, k, nnz);
+
+    bool finite = true;
+    double mag = 0.0;
+    for (std::size_t j = 0; j < nnz; ++j) {
+        double& s = state[index[j]];
+        const double d = k * value[j];
+        const double m = std::fabs(s) + std::fabs(d);
+        mag += m * m;
+        s += d;
+        finite = finite && std::isfinite(s);
+    }
+    if (sum_sq_err) *sum_sq_err += detail::sparse_delta_err(mag, nnz);
+    return finite && (!sum_sq || std::isfinite(*sum_sq)) && (!sum_sq_err || std::isfinite(*sum_sq_err));
+}
+
+} // namespace vec
+
+// Dense state with its cached squared L2 norm
+struct SparseStateView final {
+    const double* data = nullptr;
+    std::size_t size = 0;
+    double sum_sq = 0.0;     // Σ data[i]^2, kept current by the host
+    double sum_sq_err = 0.0; // bound on |sum_sq - Σ data[i]^2|
+    std::size_t applies = 0; // incremental updates since the last recomputation
+
+    // One O(N) pass; afterwards keep sum_sq current through apply_step
+    static SparseStateView of(const double* data, std::size_t size) noexcept {
+        const double sum_sq = vec::sum_squares(data, size);
+        return {data, size, sum_sq, vec::sum_squares_err(sum_sq, size), 0};
+    }
+};
+
+// Owning sparse step (Project mode output, or host-side storage)
+struct SparseStep final {
+    std::vector<std::size_t> index;
+    std::vector<double> value;
+    std::size_t size = 0;
+
+    std::size_t nnz() const noexcept { return index.size(); }
+    bool valid() const noexcept { return index.size() == value.size(); }
+};
+
+inline bool operator==(const SparseStep& a, const SparseStep& b) noexcept {
+    if (a.nnz() == 0 || b.nnz() == 0) return a.nnz() == b.nnz(); // zero step of any size
+    return a.size == b.size && a.index == b.index && a.value == b.value;
+}
+
+inline bool operator!=(const SparseStep& a, const SparseStep& b) noexcept {
+    return !(a == b);
+}
+
+// ΔS = k · (index, value). k == 0 or nnz == 0 is the zero step of any size
+// (the arrays are never read), which is what neutral_sparse() returns.
+struct SparseStepView final {
+    const std::size_t* index = nullptr;
+    const double* value = nullptr;
+    std::size_t nnz = 0;
+    std::size_t size = 0;
+    double k = 1.0;
+
+    // A malformed step (index / value lengths differ) views as zero; the
+    // SparseStep overloads below reject it instead.
+    static SparseStepView of(const SparseStep& s) noexcept {
+        return {s.index.data(), s.value.data(), s.valid() ? s.nnz() : 0, s.size, s.valid() ? 1.0 : 0.0};
+    }
+
+    bool is_zero() const noexcept { return k == 0.0 || nnz == 0; }
+};
+
+inline bool operator==(const SparseStepView& a, const SparseStepView& b) noexcept {
+    if (a.is_zero() || b.is_zero()) return a.is_zero() && b.is_zero();
+    return a.index == b.index && a.value == b.value && a.nnz == b.nnz && a.size == b.size && a.k == b.k;
+}
+
+inline bool operator!=(const SparseStepView& a, const SparseStepView& b) noexcept {
+    return !(a == b);
+}
+
+// ----------------------------
+// Hooks for Engine<SparseStateView, SparseStepView> / <..., SparseStep>
+// ----------------------------
+
+// scale_step hook: out = k · in, as a view (O(1))
+inline bool scale_sparse(const SparseStepView& in, double k, SparseStepView& out) noexcept {
+    if (!std::isfinite(k)) return false;
+    const double kk = in.k * k;
+    if (!std::isfinite(kk)) return false;
+    out = {in.index, in.value, in.nnz, in.size, kk};
+    return true;
+}
+
+// neutral_step hook
+inline SparseStepView neutral_sparse() noexcept {
+    return {nullptr, nullptr, 0, 0, 0.0};
+}
+
+// scale_step hook for the owning step: same pattern, values · k (O(nnz))
+inline bool scale_sparse_step(const SparseStep& in, double k, SparseStep& out) {
+    if (!in.valid() || !std::isfinite(k)) return false;
+    out.index = in.index;
+    out.value.resize(in.value.size());
+    out.size = in.size;
+    return vec::scale_into(in.value.data(), k, out.value.data(), in.value.size());
+}
+
+// neutral_step hook for the owning step
+inline SparseStep neutral_sparse_step() {
+    return SparseStep{};
+}
+
+// S ⊕ k·ΔS satisfies lim (see vec::next_sparse_within)
+inline bool next_sparse_within(const SparseStateView& S, const SparseStepView& dS,
+                               const vec::BlockLimits& lim) noexcept {
+    if (dS.is_zero()) {
+        return vec::next_sparse_within(S.data, S.sum_sq, nullptr, nullptr, 0.0, 0, S.size, lim, S.sum_sq_err);
+    }
+    if (dS.size != S.size) return false;
+    return vec::next_sparse_within(S.data, S.sum_sq, dS.index, dS.value, dS.k, dS.nnz, S.size, lim, S.sum_sq_err);
+}
+
+inline bool next_sparse_within(const SparseStateView& S, const SparseStep& dS, const vec::BlockLimits& lim) noexcept {
+    return dS.valid() && next_sparse_within(S, SparseStepView::of(dS), lim);
+}
+
+// Largest k with S ⊕ k·ΔS inside the L2 ball of radius R (solve_scale body)
+inline bool sparse_l2_scale_limit(const SparseStateView& S, const SparseStepView& dS, double R,
+                                  double& k_max) noexcept {
+    if (dS.is_zero() || dS.size != S.size || !vec::sparse_indices_valid(dS.index, dS.nnz, S.size)) return false;
+    double k = 0.0;
+    if (!vec::sparse_l2_scale_limit(S.data, S.sum_sq, dS.index, dS.value, dS.nnz, R, k)) return false;
+    k_max = k / dS.k; // dS is dS.k · (index, value)
+    if (k_max > 1.0) k_max = 1.0;
+    return std::isfinite(k_max);
+}
+
+// project_step body: out keeps the pattern of in with projected values
+inline bool project_sparse(const SparseStateView& S, const SparseStep& in, const vec::BlockLimits& lim,
+                           SparseStep& out) {
+    if (!in.valid() || (in.nnz() > 0 && in.size != S.size)) return false;
+    out.index = in.index;
+    out.value.resize(in.value.size());
+    out.size = in.size;
+    return vec::project_sparse_into(S.data, S.sum_sq, in.index.data(), in.value.data(), in.nnz(), S.size, lim,
+                                    out.value.data(), S.sum_sq_err);
+}
+
+// ----------------------------
+// Application (host side): S ⊕ ΔS in place, O(nnz), sum_sq kept current.
+// A zero step leaves the state untouched. false on a size mismatch or an
+// invalid index list (nothing written), or a non-finite result.
+// ----------------------------
+
+inline bool apply_step(const SparseStepView& dS, double* state, std::size_t n, double* sum_sq = nullptr,
+                       double* sum_sq_err = nullptr) noexcept {
+    if (dS.is_zero()) return true;
+    if (dS.size != n) return false;
+    return vec::apply_sparse(dS.index, dS.value, dS.k, dS.nnz, state, n, sum_sq, sum_sq_err);
+}
+
+inline bool apply_step(const SparseStep& dS, double* state, std::size_t n, double* sum_sq = nullptr,
+                       double* sum_sq_err = nullptr) noexcept {
+    return dS.valid() && apply_step(SparseStepView::of(dS), state, n, sum_sq, sum_sq_err);
+}
+
+// Applies to S.data (the same storage as state) and keeps the whole view
+// current: sum_sq and its drift bound, recomputed from the state every
+// kSparseRefreshApplies applies.
+inline bool apply_step(const SparseStepView& dS, double* state, SparseStateView& S) noexcept {
+    if (state != S.data) return false;
+    if (!apply_step(dS, state, S.size, &S.sum_sq, &S.sum_sq_err)) return false;
+    if (!dS.is_zero() && ++S.applies >= kSparseRefreshApplies) S = SparseStateView::of(state, S.size);
+    return true;
+}
+
+inline bool apply_step(const SparseStep& dS, double* state, SparseStateView& S) noexcept {
+    return dS.valid() && apply_step(SparseStepView::of(dS), state, S);
+}
+
+} // namespace ase
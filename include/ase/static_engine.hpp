@@ -0,0 +1,361 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "ase/ase.hpp"
+
+namespace ase {
+
+// Compile-time hook binding (Design §5.4).
+//
+// StaticEngine enforces exactly the semantics of Engine, but the hooks are
+// resolved at compile time from a Policy type instead of through function
+// pointers, so the compiler can inline and vectorize across them.
+//
+// A Policy provides (static or const member functions):
+//   bool is_admissible(const State&, const Step&)            mandatory
+//   Step neutral_step()                                      mandatory
+//   bool scale_step(const Step& in, double k, Step& out)     optional (Scale)
+//   bool project_step(const State&, const Step& in, Step& out) optional (Project)
+//
+// A missing optional hook is treated exactly like a null pointer in
+// Dependencies: the corresponding mode fails closed to the neutral step.
+//
+// The Config may be fixed at compile time too (the mode is fixed for the
+// deployment, Specification §6.1):
+//
+//   ase::StaticEngine<State, Step, Policy, ase::StaticConfig<ase::Mode::Scale, 16>> engine;
+//
+// Then only the configured mode's path is compiled, the geometric scale
+// grid k = 1, f, f^2, ... is a constexpr table, and the search over it is
+// unrolled (up to kMaxUnrolledScaleAttempts candidates).
+
+// Compile-time Config. ScaleFactor and ScaleTolerance are std::ratio types
+// (C++17 has no double template parameters). Only StaticEngine takes it:
+// the runtime Engine has no Config template parameter, and its fourth
+// parameter is Context, so Engine<State, Step, StaticConfig<...>> does not
+// fix the configuration. Give Engine Cfg::config() instead.
+template <Mode M, std::size_t MaxScaleAttempts = 16, class ScaleFactor = std::ratio<1, 2>,
+          ScaleSearch Search = ScaleSearch::Geometric, class ScaleTolerance = std::ratio<1, 1000>>
+struct StaticConfig final {
+    static constexpr Mode mode = M;
+    static constexpr std::size_t max_scale_attempts = MaxScaleAttempts;
+    static constexpr double scale_factor =
+        static_cast<double>(ScaleFactor::num) / static_cast<double>(ScaleFactor::den);
+    static constexpr ScaleSearch scale_search = Search;
+    static constexpr double scale_tolerance =
+        static_cast<double>(ScaleTolerance::num) / static_cast<double>(ScaleTolerance::den);
+
+    // The equivalent runtime Config
+    static constexpr Config config() noexcept {
+        Config cfg{};
+        cfg.mode = mode;
+        cfg.max_scale_attempts = max_scale_attempts;
+        cfg.scale_factor = scale_factor;
+        cfg.scale_search = scale_search;
+        cfg.scale_tolerance = scale_tolerance;
+        return cfg;
+    }
+
+    // Geometric grid, by the same repeated multiplication as the runtime
+    // search (so the values are bit-identical)
+    static constexpr std::array<double, MaxScaleAttempts> scale_grid() noexcept {
+        std::array<double, MaxScaleAttempts> grid{};
+        double k = 1.0;
+        for (std::size_t i = 0; i < MaxScaleAttempts; ++i) {
+            grid[i] = k;
+            k *= scale_factor;
+        }
+        return grid;
+    }
+};
+
+// Longest geometric search StaticEngine unrolls; longer ones loop over the table
+constexpr std::size_t kMaxUnrolledScaleAttempts = 32;
+
+// Placeholder for an absent callable hook (see make_hooks).
+struct NoHook final {};
+
+// Policy built from callables (lambdas, function objects, function pointers).
+template <class Admissible, class Neutral, class Scale = NoHook, class Project = NoHook>
+struct Hooks final {
+    Admissible is_admissible_fn;
+    Neutral    neutral_step_fn;
+    Scale      scale_step_fn{};
+    Project    project_step_fn{};
+
+    template <class State, class Step>
+    bool is_admissible(const State& S, const Step& dS) const {
+        return is_admissible_fn(S, dS);
+    }
+
+    auto neutral_step() const { return neutral_step_fn(); }
+
+    template <class Step, class F = Scale,
+              class = std::enable_if_t<!std::is_same<F, NoHook>::value>>
+    bool scale_step(const Step& in, double k, Step& out) const {
+        return scale_step_fn(in, k, out);
+    }
+
+    template <class State, class Step, class F = Project,
+              class = std::enable_if_t<!std::is_same<F, NoHook>::value>>
+    bool project_step(const State& S, const Step& in, Step& out) const {
+        return project_step_fn(S, in, out);
+    }
+};
+
+template <class Admissible, class Neutral, class Scale = NoHook, class Project = NoHook>
+constexpr Hooks<Admissible, Neutral, Scale, Project>
+make_hooks(Admissible adm, Neutral neutral, Scale scale = NoHook{}, Project project = NoHook{}) {
+    return {adm, neutral, scale, project};
+}
+
+namespace detail {
+
+template <class P, class State, class Step, class = void>
+struct has_scale_step : std::false_type {};
+
+template <class P, class State, class Step>
+struct has_scale_step<P, State, Step,
+    std::void_t<decltype(std::declval<const P&>().scale_step(
+        std::declval<const Step&>(), 1.0, std::declval<Step&>()))>> : std::true_type {};
+
+template <class P, class State, class Step, class = void>
+struct has_project_step : std::false_type {};
+
+template <class P, class State, class Step>
+struct has_project_step<P, State, Step,
+    std::void_t<decltype(std::declval<const P&>().project_step(
+        std::declval<const State&>(), std::declval<const Step&>(), std::declval<Step&>()))>>
+    : std::true_type {};
+
+template <class P, class State, class Step, class = void>
+struct has_mandatory_hooks : std::false_type {};
+
+template <class P, class State, class Step>
+struct has_mandatory_hooks<P, State, Step,
+    std::void_t<decltype(static_cast<bool>(std::declval<const P&>().is_admissible(
+                    std::declval<const State&>(), std::declval<const Step&>()))),
+                decltype(static_cast<Step>(std::declval<const P&>().neutral_step()))>>
+    : std::true_type {};
+
+template <class C>
+struct is_static_config : std::false_type {};
+
+template <class Cfg>
+inline constexpr std::array<double, Cfg::max_scale_attempts> kScaleGrid = Cfg::scale_grid();
+
+template <class Cfg>
+constexpr bool static_geometric() noexcept {
+    if constexpr (is_static_config<Cfg>::value) {
+        return Cfg::scale_search == ScaleSearch::Geometric;
+    } else {
+        return false;
+    }
+}
+
+template <Mode M, std::size_t A, class F, ScaleSearch S, class T>
+struct is_static_config<StaticConfig<M, A, F, S, T>> : std::true_type {};
+
+// Runtime Config storage; a StaticConfig needs none
+template <class Cfg>
+struct ConfigSlot {
+    static constexpr Config config() noexcept { return Cfg::config(); }
+};
+
+template <>
+struct ConfigSlot<Config> {
+    explicit ConfigSlot(const Config& cfg) noexcept : cfg_(cfg) {}
+    const Config& config() const noexcept { return cfg_; }
+
+private:
+    Config cfg_;
+};
+
+} // namespace detail
+
+// ASE core engine with compile-time hooks: stateless per call, bounded,
+// deterministic (Specification §4, §9). Output is identical to Engine for
+// the same Config and equivalent hooks. Cfg is Config (set at
+// construction) or a StaticConfig.
+template <class State, class Step, class Policy, class Cfg = Config>
+class StaticEngine final : private detail::ConfigSlot<Cfg> {
+    static_assert(detail::has_mandatory_hooks<Policy, State, Step>::value,
+                  "ASE Policy must provide is_admissible(S, dS) and neutral_step() (Specification §7, §10)");
+    static_assert(std::is_same<Cfg, Config>::value || detail::is_static_config<Cfg>::value,
+                  "StaticEngine Cfg must be ase::Config or an ase::StaticConfig");
+
+    static constexpr bool kStaticConfig = !std::is_same<Cfg, Config>::value;
+
+public:
+    template <class C = Cfg, std::enable_if_t<std::is_same<C, Config>::value, int> = 0>
+    explicit StaticEngine(const Config& cfg, const Policy& policy = Policy{}) noexcept
+        : detail::ConfigSlot<Config>(cfg), policy_(policy) {}
+
+    template <class C = Cfg, std::enable_if_t<!std::is_same<C, Config>::value, int> = 0>
+    explicit StaticEngine(const Policy& policy = Policy{}) noexcept : policy_(policy) {}
+
+    // Canonical enforcement entry point:
+    // Input: (S, ΔS)  Output: ΔS' only (Integration Constraints §2.1)
+    Step enforce(const State& S, const Step& proposed) const noexcept {
+        // 1) Evaluate admissibility of proposed step (Implementation Notes §3.3)
+        bool admissible = false;
+        if (!safe_is_admissible(S, proposed, admissible)) {
+            // Evaluation failure => fail-closed => neutral (Specification §3.5, §11)
+            return neutral_safe();
+        }
+
+        if (admissible) {
+            // Pass-through (Specification §5.2)
+            return proposed;
+        }
+
+        // 2) Inadmissible => enforce according to fixed mode (Specification §6.1)
+        if constexpr (kStaticConfig) {
+            if constexpr (Cfg::mode == Mode::Scale) {
+                return enforce_scale(S, proposed);
+            } else if constexpr (Cfg::mode == Mode::Project) {
+                return enforce_project(S, proposed);
+            } else {
+                return neutral_safe();
+            }
+        } else {
+            switch (this->config().mode) {
+                case Mode::Reject:
+                    return neutral_safe();
+
+                case Mode::Scale:
+                    return enforce_scale(S, proposed);
+
+                case Mode::Project:
+                    return enforce_project(S, proposed);
+            }
+
+            // Defensive fail-closed (should not happen)
+            return neutral_safe();
+        }
+    }
+
+private:
+    Step enforce_scale(const State& S, const Step& proposed) const noexcept {
+        if constexpr (!detail::has_scale_step<Policy, State, Step>::value) {
+            (void)S;
+            (void)proposed;
+            return neutral_safe();
+        } else {
+            const auto scale = [&](double k, Step& out) { return policy_.scale_step(proposed, k, out); };
+            const auto eval  = [&](const Step& cand) {
+                bool admissible = false;
+                if (!safe_is_admissible(S, cand, admissible)) return detail::Eval::Failed;
+                return admissible ? detail::Eval::Admissible : detail::Eval::Inadmissible;
+            };
+
+            Step scaled{}; // reused by every attempt
+            double k = 0.0;
+            bool found = false;
+            if constexpr (detail::static_geometric<Cfg>()) {
+                (void)k;
+                found = search_static(scaled, scale, eval);
+            } else {
+                const Config& cfg = this->config();
+                switch (cfg.scale_search) {
+                    case ScaleSearch::Geometric:
+                        found = detail::search_geometric(cfg, scaled, k, scale, eval);
+                        break;
+
+                    case ScaleSearch::Bisection: {
+                        Step probe{};
+                        found = detail::search_bisection(cfg, scaled, probe, k, scale, eval);
+                        break;
+                    }
+                }
+            }
+
+            // Bounded attempts exhausted or failure => neutral (Specification §5.4)
+            if (!found) return neutral_safe();
+            return scaled;
+        }
+    }
+
+    // Geometric search over Cfg::scale_grid(): the same candidates, in the
+    // same order, as detail::search_geometric
+    template <class ScaleFn, class EvalFn>
+    static bool search_static(Step& result, ScaleFn& scale, EvalFn& eval) noexcept {
+        bool found = false;
+
+        // true => the search ends (found, or fail-closed)
+        const auto attempt = [&](double k) {
+            if (!scale(k, result)) return true;
+            switch (eval(result)) {
+                case detail::Eval::Admissible:   found = true; return true;
+                case detail::Eval::Failed:       return true;
+                case detail::Eval::Inadmissible: return false;
+            }
+            return true;
+        };
+
+        if constexpr (Cfg::max_scale_attempts <= kMaxUnrolledScaleAttempts) {
+            unrolled(attempt, std::make_index_sequence<Cfg::max_scale_attempts>{});
+        } else {
+            for (double k : detail::kScaleGrid<Cfg>) {
+                if (attempt(k)) break;
+            }
+        }
+        return found;
+    }
+
+    template <class Attempt, std::size_t... I>
+    static void unrolled(const Attempt& attempt, std::index_sequence<I...>) noexcept {
+        (void)(false || ... || attempt(detail::kScaleGrid<Cfg>[I]));
+    }
+
+    Step enforce_project(const State& S, const Step& proposed) const noexcept {
+        if constexpr (!detail::has_project_step<Policy, State, Step>::value) {
+            (void)S;
+            (void)proposed;
+            return neutral_safe();
+        } else {
+            Step projected{};
+            if (!policy_.project_step(S, proposed, projected)) {
+                return neutral_safe();
+            }
+
+            bool admissible = false;
+            if (!safe_is_admissible(S, projected, admissible)) {
+                return neutral_safe();
+            }
+
+            // Project applied at most once; inadmissible => neutral (Specification §6.4)
+            if (!admissible) return neutral_safe();
+            return projected;
+        }
+    }
+
+    // MUST NOT allow exceptions to escape enforcement boundary (Specification §11.3)
+    bool safe_is_admissible(const State& S, const Step& dS, bool& out) const noexcept {
+#if defined(__cpp_exceptions)
+        try {
+            out = static_cast<bool>(policy_.is_admissible(S, dS));
+            return true;
+        } catch (...) {
+            out = false;
+            return false;
+        }
+#else
+        out = static_cast<bool>(policy_.is_admissible(S, dS));
+        return true;
+#endif
+    }
+
+    Step neutral_safe() const noexcept {
+        return policy_.neutral_step();
+    }
+
+private:
+    Policy policy_;
+};
+
+} // namespace ase
@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ase/ase.hpp"
+
+namespace ase {
+
+// Enforcement telemetry (observability only, outside the admissibility logic).
+//
+// Usage:
+//   ase::ShardedStats<> stats;
+//   ase::Engine<State, Step, ase::NoContext, ase::ShardedStats<>> engine(cfg, deps, &stats);
+//   ...
+//   const ase::StatsSnapshot snap = stats.snapshot(); // from any thread
+//
+// Counters are written through per-thread shards, so concurrent enforce()
+// calls from different threads do not contend on a shared cache line.
+
+// Scale-attempt histogram: bucket i counts Scale-mode enforcements that built
+// i candidates; the last bucket also collects anything larger.
+constexpr std::size_t kScaleAttemptBuckets = 17;
+
+struct StatsSnapshot final {
+    std::uint64_t pass_through = 0;
+    std::uint64_t scaled = 0;
+    std::uint64_t projected = 0;
+    std::uint64_t neutral = 0;
+
+    std::uint64_t missing_hooks = 0;
+    std::uint64_t hook_exceptions = 0;
+    std::uint64_t transform_failures = 0;
+    std::uint64_t evaluation_failures = 0; // Verdict::Failed (Engine::resume), is_admissible_batch false
+    std::uint64_t unsupported_configs = 0; // enforce_async above kMaxAsyncScaleAttempts
+
+    std::array<std::uint64_t, kScaleAttemptBuckets> scale_attempts{};
+
+    std::uint64_t total() const noexcept {
+        return pass_through + scaled + projected + neutral;
+    }
+};
+
+template <std::size_t Shards = 16>
+class ShardedStats final {
+    static_assert(Shards > 0, "ShardedStats needs at least one shard");
+
+public:
+    ShardedStats() noexcept = default;
+    ShardedStats(const ShardedStats&) = delete;
+    ShardedStats& operator=(const ShardedStats&) = delete;
+
+    // Engine sink interface (see ase::NullStats)
+    void on_enforce(Outcome kind, std::size_t scale_attempts) noexcept {
+        Shard& sh = local_shard();
+        bump(sh.outcomes[static_cast<std::size_t>(kind)]);
+        if (scale_attempts > 0) {
+            const std::size_t b = scale_attempts < kScaleAttemptBuckets
+                                ? scale_attempts : kScaleAttemptBuckets - 1;
+            bump(sh.attempts[b]);
+        }
+    }
+
+    void on_hook_failure(HookFailure kind) noexcept {
+        bump(local_shard().failures[static_cast<std::size_t>(kind)]);
+    }
+
+    // Sum over all shards. Concurrent updates may or may not be included;
+    // every counter is individually monotone.
+    StatsSnapshot snapshot() const noexcept {
+        StatsSnapshot snap;
+        for (const Shard& sh : shards_) {
+            snap.pass_through += load(sh.outcomes[static_cast<std::size_t>(Outcome::PassThrough)]);
+            snap.scaled       += load(sh.outcomes[static_cast<std::size_t>(Outcome::Scaled)]);
+            snap.projected    += load(sh.outcomes[static_cast<std::size_t>(Outcome::Projected)]);
+            snap.neutral      += load(sh.outcomes[static_cast<std::size_t>(Outcome::Neutral)]);
+
+            snap.missing_hooks      += load(sh.failures[static_cast<std::size_t>(HookFailure::Missing)]);
+            snap.hook_exceptions    += load(sh.failures[static_cast<std::size_t>(HookFailure::Exception)]);
+            snap.transform_failures += load(sh.failures[static_cast<std::size_t>(HookFailure::Transform)]);
+            snap.evaluation_failures += load(sh.failures[static_cast<std::size_t>(HookFailure::Evaluation)]);
+            snap.unsupported_configs += load(sh.failures[static_cast<std::size_t>(HookFailure::Unsupported)]);
+
+            for (std::size_t b = 0; b < kScaleAttemptBuckets; ++b) {
+                snap.scale_attempts[b] += load(sh.attempts[b]);
+            }
+        }
+        return snap;
+    }
+
+private:
+    using Counter = std::atomic<std::uint64_t>;
+
+    // One cache-line-aligned shard per thread slot (no false sharing)
+    struct alignas(64) Shard {
+        Counter outcomes[4] = {};
+        Counter failures[5] = {};
+        Counter attempts[kScaleAttemptBuckets] = {};
+    };
+
+    static void bump(Counter& c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t load(const Counter& c) noexcept {
+        return c.load(std::memory_order_relaxed);
+    }
+
+    // Threads are assigned shards round-robin on first use
+    Shard& local_shard() noexcept {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+        return shards_[slot % Shards];
+    }
+
+    std::array<Shard, Shards> shards_{};
+};
+
+} // namespace ase
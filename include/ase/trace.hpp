@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "ase/ase.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define ASE_TRACE_TSC 1
+#elif defined(__aarch64__)
+    #define ASE_TRACE_CNTVCT 1
+#endif
+
+namespace ase {
+
+// Hook-call tracing (observability only, outside the admissibility logic).
+//
+// Usage:
+//   static ase::TraceRing<> ring;   // large: keep it out of the stack
+//   ase::Engine<State, Step, ase::NoContext, ase::NullStats, ase::TraceRing<>>
+//       engine(cfg, deps, nullptr, &ring);
+//   ...
+//   ring.write_chrome_json(file);   // open in ui.perfetto.dev or chrome://tracing
+//
+// Recording is lock-free: each event claims a slot with one fetch_add and
+// is published with a per-slot sequence number, so any number of threads
+// may enforce concurrently. The ring keeps the most recent Capacity events;
+// older ones are overwritten.
+
+inline const char* hook_name(Hook hook) noexcept {
+    switch (hook) {
+        case Hook::IsAdmissible:       return "is_admissible";
+        case Hook::IsAdmissibleBatch:  return "is_admissible_batch";
+        case Hook::Prepare:            return "prepare";
+        case Hook::SolveScale:         return "solve_scale";
+        case Hook::ScaleStep:          return "scale_step";
+        case Hook::IsAdmissibleScaled: return "is_admissible_scaled";
+        case Hook::ProjectStep:        return "project_step";
+        case Hook::NeutralStep:        return "neutral_step";
+        case Hook::AdmissibleStage:    return "admissibility_stage";
+        case Hook::IsAdmissibleCandidates: return "is_admissible_candidates";
+    }
+    return "?";
+}
+
+namespace trace {
+
+// Raw timestamp: TSC on x86, the virtual counter on AArch64, otherwise
+// steady_clock nanoseconds. Units are converted when a trace is written.
+inline std::uint64_t ticks() noexcept {
+#if defined(ASE_TRACE_TSC)
+    return static_cast<std::uint64_t>(__rdtsc());
+#elif defined(ASE_TRACE_CNTVCT)
+    std::uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline std::int64_t clock_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Small dense id of the calling thread (0, 1, 2, ... in first-use order)
+inline std::uint32_t thread_index() noexcept {
+    static std::atomic<std::uint32_t> next{0};
+    thread_local const std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+enum class Phase : std::uint8_t { Begin = 0, End = 1 };
+
+struct Event final {
+    std::uint64_t ticks = 0;
+    Hook hook = Hook::IsAdmissible;
+    Phase phase = Phase::Begin;
+    std::uint32_t thread = 0;
+    std::uint32_t attempt = 0;
+};
+
+} // namespace trace
+
+// Capacity must be a power of two.
+template <std::size_t Capacity = 65536>
+class TraceRing final {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "TraceRing capacity must be a power of two");
+
+public:
+    TraceRing() noexcept : start_ticks_(trace::ticks()), start_ns_(trace::clock_ns()) {}
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    // Engine tracer interface (see ase::NullTracer)
+    void on_hook_begin(Hook hook, std::size_t attempt) noexcept { record(hook, trace::Phase::Begin, attempt); }
+    void on_hook_end(Hook hook, std::size_t attempt) noexcept { record(hook, trace::Phase::End, attempt); }
+
+    // Events ever recorded (including overwritten ones)
+    std::uint64_t recorded() const noexcept { return head_.load(std::memory_order_acquire); }
+
+    // Copies up to max retained events, oldest first, into out. Slots being
+    // written or overwritten during the copy are skipped. Returns the count.
+    std::size_t snapshot(trace::Event* out, std::size_t max) const noexcept {
+        const std::uint64_t head = recorded();
+        const std::uint64_t first = head > Capacity ? head - Capacity : 0;
+
+        std::size_t n = 0;
+        for (std::uint64_t i = first; i < head && n < max; ++i) {
+            if (read(i, out[n])) ++n;
+        }
+        return n;
+    }
+
+    // Chrome trace-event JSON ("B"/"E" duration events, microseconds),
+    // readable by Perfetto and chrome://tracing. Call from any thread.
+    // Returns false on a write error.
+    bool write_chrome_json(std::FILE* out) const noexcept {
+        const double us_per_tick = calibrate_us_per_tick();
+        const std::uint64_t head = recorded();
+        const std::uint64_t first = head > Capacity ? head - Capacity : 0;
+
+        bool ok = std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out) >= 0;
+        bool comma = false;
+        for (std::uint64_t i = first; i < head && ok; ++i) {
+            trace::Event e;
+            if (!read(i, e)) continue;
+
+            const double ts = static_cast<double>(static_cast<std::int64_t>(e.ticks - start_ticks_)) * us_per_tick;
+            ok = std::fprintf(out, "%s\n{\"name\":\"%s\",\"cat\":\"ase\",\"ph\":\"%c\",\"ts\":%.3f,"
+                                   "\"pid\":1,\"tid\":%u,\"args\":{\"attempt\":%u}}",
+                              comma ? "," : "", hook_name(e.hook), e.phase == trace::Phase::Begin ? 'B' : 'E',
+                              ts, static_cast<unsigned>(e.thread), static_cast<unsigned>(e.attempt)) > 0;
+            comma = true;
+        }
+        return ok && std::fputs("\n]}\n", out) >= 0;
+    }
+
+    // Drops all events. Only while no engine is recording.
+    void clear() noexcept {
+        for (Slot& s : slots_) s.seq.store(0, std::memory_order_relaxed);
+        head_.store(0, std::memory_order_release);
+    }
+
+private:
+    // seq == 2*i + 1 while event i is written, 2*i + 2 once it is published
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<std::uint64_t> ticks{0};
+        std::atomic<std::uint64_t> meta{0};
+    };
+
+    static std::uint64_t pack(Hook hook, trace::Phase phase, std::uint32_t thread, std::size_t attempt) noexcept {
+        const std::uint64_t a = attempt < 0xFFFFFFFFu ? attempt : 0xFFFFFFFFu;
+        return (a << 32) | (std::uint64_t{thread & 0xFFFFu} << 16) |
+               (std::uint64_t{static_cast<std::uint8_t>(phase)} << 8) | static_cast<std::uint8_t>(hook);
+    }
+
+    void record(Hook hook, trace::Phase phase, std::size_t attempt) noexcept {
+        const std::uint64_t t = trace::ticks();
+        const std::uint64_t i = head_.fetch_add(1, std::memory_order_relaxed);
+        Slot& s = slots_[i & (Capacity - 1)];
+
+        s.seq.store(2 * i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.ticks.store(t, std::memory_order_relaxed);
+        s.meta.store(pack(hook, phase, trace::thread_index(), attempt), std::memory_order_relaxed);
+        s.seq.store(2 * i + 2, std::memory_order_release);
+    }
+
+    bool read(std::uint64_t i, trace::Event& e) const noexcept {
+        const Slot& s = slots_[i & (Capacity - 1)];
+        if (s.seq.load(std::memory_order_acquire) != 2 * i + 2) return false;
+
+        const std::uint64_t t = s.ticks.load(std::memory_order_relaxed);
+        const std::uint64_t m = s.meta.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.seq.load(std::memory_order_relaxed) != 2 * i + 2) return false;
+
+        e.ticks = t;
+        e.hook = static_cast<Hook>(m & 0xFFu);
+        e.phase = static_cast<trace::Phase>((m >> 8) & 0xFFu);
+        e.thread = static_cast<std::uint32_t>((m >> 16) & 0xFFFFu);
+        e.attempt = static_cast<std::uint32_t>(m >> 32);
+        return true;
+    }
+
+    // Tick rate from the elapsed ticks vs steady_clock since construction
+    double calibrate_us_per_tick() const noexcept {
+        const std::uint64_t dt = trace::ticks() - start_ticks_;
+        const std::int64_t dns = trace::clock_ns() - start_ns_;
+        if (dt == 0 || dns <= 0) return 1e-3;
+        return (static_cast<double>(dns) * 1e-3) / static_cast<double>(dt);
+    }
+
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    const std::uint64_t start_ticks_;
+    const std::int64_t start_ns_;
+    alignas(64) Slot slots_[Capacity];
+};
+
+} // namespace ase
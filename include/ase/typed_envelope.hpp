@@ -0,0 +1,294 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ase/vector_envelope.hpp"
+
+namespace ase {
+namespace vec {
+
+// ----------------------------
+// Narrow element types
+// ----------------------------
+
+// bfloat16: the upper 16 bits of an IEEE-754 binary32
+struct bf16 final {
+    std::uint16_t bits = 0;
+
+    // Round to nearest even (NaN stays NaN)
+    static bf16 from_float(float f) noexcept {
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof u);
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) return {static_cast<std::uint16_t>((u >> 16) | 0x0040u)};
+        u += 0x7FFFu + ((u >> 16) & 1u);
+        return {static_cast<std::uint16_t>(u >> 16)};
+    }
+
+    float to_float() const noexcept {
+        const std::uint32_t u = std::uint32_t{bits} << 16;
+        float f;
+        std::memcpy(&f, &u, sizeof f);
+        return f;
+    }
+};
+
+// Signed 16-bit fixed point: value = raw · 2^-FracBits
+template <int FracBits>
+struct fixed16 final {
+    static_assert(FracBits >= 0 && FracBits <= 15, "fixed16 has 16 bits");
+    static constexpr double kQuantum = 1.0 / static_cast<double>(1 << FracBits);
+
+    std::int16_t raw = 0;
+};
+
+// Numeric policy of an element type:
+//   widen(x)          exact value of x as a double (exact for all types below)
+//   narrow(v, out)    v rounded to the type; false if not representable
+//                     (non-finite, or outside the fixed-point range)
+template <class T>
+struct Numeric;
+
+template <>
+struct Numeric<double> {
+    static double widen(double x) noexcept { return x; }
+    static bool narrow(double v, double& out) noexcept {
+        out = v;
+        return std::isfinite(v);
+    }
+};
+
+template <>
+struct Numeric<float> {
+    static double widen(float x) noexcept { return static_cast<double>(x); }
+    static bool narrow(double v, float& out) noexcept {
+        out = static_cast<float>(v);
+        return std::isfinite(out);
+    }
+};
+
+// Narrowing goes through float (round to nearest even twice)
+template <>
+struct Numeric<bf16> {
+    static double widen(bf16 x) noexcept { return static_cast<double>(x.to_float()); }
+    static bool narrow(double v, bf16& out) noexcept {
+        out = bf16::from_float(static_cast<float>(v));
+        return std::isfinite(out.to_float());
+    }
+};
+
+// Narrowing rounds half away from zero; out-of-range values fail (no saturation)
+template <int F>
+struct Numeric<fixed16<F>> {
+    static double widen(fixed16<F> x) noexcept { return static_cast<double>(x.raw) * fixed16<F>::kQuantum; }
+    static bool narrow(double v, fixed16<F>& out) noexcept {
+        if (!std::isfinite(v)) return false;
+        const double q = v / fixed16<F>::kQuantum;
+        const double r = (q < 0.0) ? -std::floor(-q + 0.5) : std::floor(q + 0.5);
+        if (r < -32768.0 || r > 32767.0) return false;
+        out.raw = static_cast<std::int16_t>(r);
+        return true;
+    }
+};
+
+// ----------------------------
+// Envelope kernels over narrow steps and states (namespace typed).
+//
+// Elements are widened exactly to double. Sums use compensated
+// (Neumaier) accumulation in 8 lanes in index order, like the double
+// kernels, so results are deterministic. Nothing is converted in bulk, so
+// fp32 steps are read at half the bandwidth of double and bf16 / fixed16
+// steps at a quarter.
+//
+// Membership tests are conservative: a value is admitted only if it stays
+// inside the limit after the worst-case rounding error of the evaluation,
+// and by the explicit relative margin tolerance (Specification §8.4). So
+// a true result implies the exact next state satisfies the limits. It also
+// implies that the values the host stores satisfy them: the step as
+// scale_into builds it (rounded to the step type) and the next state as
+// axpy_into(S, 1, step) writes it (rounded to the state type). Both are
+// recomputed exactly here and checked alongside the exact bound.
+// ----------------------------
+
+namespace typed {
+
+namespace detail {
+
+constexpr double kUnit = 1.0 / 9007199254740992.0; // 2^-53
+
+// Neumaier-compensated sum in 8 fixed lanes
+class CompensatedSum {
+public:
+    void add(std::size_t i, double x) noexcept {
+        double& s = sum_[i % kLanes];
+        const double t = s + x;
+        comp_[i % kLanes] += (std::fabs(s) >= std::fabs(x)) ? (s - t) + x : (x - t) + s;
+        s = t;
+    }
+
+    double value() const noexcept {
+        double s = 0.0;
+        double c = 0.0;
+        for (std::size_t j = 0; j < kLanes; ++j) {
+            for (double x : {sum_[j], comp_[j]}) {
+                const double t = s + x;
+                c += (std::fabs(s) >= std::fabs(x)) ? (s - t) + x : (x - t) + s;
+                s = t;
+            }
+        }
+        return s + c;
+    }
+
+private:
+    static constexpr std::size_t kLanes = vec::detail::kLanes;
+    double sum_[kLanes] = {};
+    double comp_[kLanes] = {};
+};
+
+// Upper bound of an exact sum of n non-negative terms, each computed with
+// relative error <= term_err, from its compensated value s
+inline double sum_upper(double s, std::size_t n, double term_err) noexcept {
+    const double nu = static_cast<double>(n) * kUnit;
+    return s * (1.0 + term_err + 2.0 * kUnit + 4.0 * nu * kUnit) * (1.0 + 2.0 * kUnit);
+}
+
+// Shrinks a limit by the tolerance and one rounding
+inline double shrink(double limit, double tolerance) noexcept {
+    return limit * (1.0 - tolerance) * (1.0 - 2.0 * kUnit);
+}
+
+// next(i) yields the rounded S[i] + ΔS[i], step(i) the rounded ΔS[i].
+// step_err bounds the error of the step term relative to |ΔS[i]| (0 when
+// it is exact), so |exact next| <= |v| (1 + 2u) + |d| step_err.
+// store(i, v, d, x, ds) writes the next state x and step ds as the host
+// stores them (false if one is not representable); every limit must hold
+// for the exact bound and for the stored values.
+template <class Next, class StepAt, class Store>
+inline bool within(std::size_t n, const BlockLimits& lim, double tolerance, double step_err,
+                   Next&& next, StepAt&& step, Store&& store) noexcept {
+    if (!(tolerance >= 0.0 && tolerance < 1.0)) return false;
+    const double linf = shrink(lim.linf, tolerance);
+    const double step_linf = shrink(lim.step_linf, tolerance);
+    const double l2 = shrink(lim.l2, tolerance);
+
+    CompensatedSum sum;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = next(i);
+        const double d = step(i);
+        if (!std::isfinite(v) || !std::isfinite(d)) return false;
+        double x = v;
+        double ds = d;
+        if (!store(i, v, d, x, ds) || !std::isfinite(x) || !std::isfinite(ds)) return false;
+
+        const double err = 2.0 * kUnit * std::fabs(v) + step_err * std::fabs(d);
+        const double hi = std::fmax(std::fabs(v) + err, std::fabs(x));
+        if (hi > linf) return false;
+        if (std::fmax(std::fabs(d) * (1.0 + step_err + 2.0 * kUnit), std::fabs(ds)) > step_linf) return false;
+        if (i < lim.sign_prefix && std::fmin(v - err, x) < lim.sign_floor) return false;
+        sum.add(i, hi * hi);
+    }
+
+    // hi and hi^2 are rounded at most three times
+    const double s = sum.value();
+    return std::isfinite(s) && sum_upper(s, n, 4.0 * kUnit) <= l2 * l2 * (1.0 - 2.0 * kUnit);
+}
+
+// v rounded to T and widened back: the value a T buffer holds
+template <class T>
+inline bool stored(double v, double& out) noexcept {
+    T t{};
+    if (!Numeric<T>::narrow(v, t)) return false;
+    out = Numeric<T>::widen(t);
+    return true;
+}
+
+} // namespace detail
+
+// true iff every x[i] is finite
+template <class T>
+inline bool all_finite(const T* x, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(Numeric<T>::widen(x[i]))) return false;
+    }
+    return true;
+}
+
+// Compensated Σ x[i]^2 (each square is exact for float, bf16 and fixed16)
+template <class T>
+inline double sum_squares(const T* x, std::size_t n) noexcept {
+    detail::CompensatedSum sum;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = Numeric<T>::widen(x[i]);
+        sum.add(i, v * v);
+    }
+    return sum.value();
+}
+
+// x satisfies lim (step_linf ignored), conservatively
+template <class T>
+inline bool within(const T* x, std::size_t n, const BlockLimits& lim, double tolerance = 0.0) noexcept {
+    return detail::within(n, lim, tolerance, 0.0,
+        [&](std::size_t i) { return Numeric<T>::widen(x[i]); },
+        [](std::size_t) { return 0.0; },
+        [](std::size_t, double, double, double&, double&) { return true; });
+}
+
+// S + ΔS satisfies lim and |ΔS[i]| <= lim.step_linf, conservatively, also
+// once rounded to TS (axpy_into); the next state is never stored. S and ΔS
+// may have different element types.
+template <class TS, class TD>
+inline bool next_within(const TS* S, const TD* dS, std::size_t n, const BlockLimits& lim,
+                        double tolerance = 0.0) noexcept {
+    return detail::within(n, lim, tolerance, 0.0,
+        [&](std::size_t i) { return Numeric<TS>::widen(S[i]) + Numeric<TD>::widen(dS[i]); },
+        [&](std::size_t i) { return Numeric<TD>::widen(dS[i]); },
+        [](std::size_t, double v, double, double& x, double&) { return detail::stored<TS>(v, x); });
+}
+
+// S + k · base satisfies lim and |k · base[i]| <= lim.step_linf, conservatively
+// (the check of a scaled candidate without building it). The limits also
+// hold for the step scale_into(base, k) builds in TD and for the state
+// axpy_into(S, 1, step) then stores in TS; for bf16 or fixed16 those
+// roundings are far larger than the evaluation's.
+template <class TS, class TD>
+inline bool next_scaled_within(const TS* S, const TD* base, double k, std::size_t n, const BlockLimits& lim,
+                               double tolerance = 0.0) noexcept {
+    if (!std::isfinite(k)) return false;
+    if (k == 0.0) return within(S, n, lim, tolerance);
+    // k · base[i] is rounded once: relative error <= u on the step term
+    return detail::within(n, lim, tolerance, 2.0 * detail::kUnit,
+        [&](std::size_t i) { return Numeric<TS>::widen(S[i]) + k * Numeric<TD>::widen(base[i]); },
+        [&](std::size_t i) { return k * Numeric<TD>::widen(base[i]); },
+        [&](std::size_t i, double, double d, double& x, double& ds) {
+            return detail::stored<TD>(d, ds) && detail::stored<TS>(Numeric<TS>::widen(S[i]) + ds, x);
+        });
+}
+
+// out[i] = in[i] · k rounded to T; out may alias in. false if some output
+// is not representable (outputs are still written up to that element).
+template <class T>
+inline bool scale_into(const T* in, double k, T* out, std::size_t n) noexcept {
+    if (!std::isfinite(k)) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!Numeric<T>::narrow(Numeric<T>::widen(in[i]) * k, out[i])) return false;
+    }
+    return true;
+}
+
+// state[i] += k · dS[i], in the state's type. false if some result is not
+// representable (the state is then partially written).
+template <class TS, class TD>
+inline bool axpy_into(TS* state, double k, const TD* dS, std::size_t n) noexcept {
+    if (!std::isfinite(k)) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!Numeric<TS>::narrow(Numeric<TS>::widen(state[i]) + k * Numeric<TD>::widen(dS[i]), state[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace typed
+} // namespace vec
+} // namespace ase
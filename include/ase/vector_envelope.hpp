@@ -0,0 +1,574 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#if defined(ASE_VEC_SCALAR)
+    // forced portable path
+#elif defined(__AVX512F__)
+    #include <immintrin.h>
+    #define ASE_VEC_AVX512 1
+#elif defined(__AVX__)
+    #include <immintrin.h>
+    #define ASE_VEC_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define ASE_VEC_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define ASE_VEC_NEON 1
+#endif
+
+namespace ase {
+namespace vec {
+
+// Vectorized kernels for the standard envelope pieces used by hosts of
+// vector states (std::array<double, N>, contiguous buffers):
+//
+//   all_finite, sum_squares / l2_norm / l2_norm_diff, linf_norm,
+//   in_l2_ball, in_linf_ball, in_box, sign_prefix_nonneg, in_simplex,
+//   next_* variants that check S + ΔS without materializing it,
+//   scale_into / add_into / axpy_into that report finiteness of the result.
+//
+// Each kernel is a single pass over its inputs. The instruction set is
+// chosen at compile time (AVX-512, AVX/AVX2, SSE2, NEON, or portable scalar;
+// define ASE_VEC_SCALAR to force the latter), from the compiler's target
+// macros only: there is no runtime dispatch. A default x86-64 build gets
+// SSE2; the wide paths need -mavx2 / -mavx512f or -march (the ase CMake
+// target passes -march=${ASE_MARCH} when that is set). kIsa names the path
+// that was compiled in.
+//
+// Determinism (Specification §4.6): every reduction uses the same fixed
+// layout on every ISA. Element i is accumulated into lane i % 8 in index
+// order, and the 8 lanes are combined by one fixed tree. Sums are therefore
+// bit-identical between ISAs, provided the compiler does not contract
+// a * b + c into FMA (the default for ISO C++ modes; the ase CMake target
+// also passes -ffp-contract=off). Max-reductions are exact in any order.
+//
+// Non-finite inputs never produce a "true" from a membership test.
+
+#if defined(ASE_VEC_AVX512)
+constexpr const char* kIsa = "avx512";
+#elif defined(ASE_VEC_AVX)
+constexpr const char* kIsa = "avx";
+#elif defined(ASE_VEC_SSE2)
+constexpr const char* kIsa = "sse2";
+#elif defined(ASE_VEC_NEON)
+constexpr const char* kIsa = "neon";
+#else
+constexpr const char* kIsa = "scalar";
+#endif
+
+namespace detail {
+
+constexpr std::size_t kLanes = 8;
+
+// One element at a time (portable path and reduction tails)
+struct ScalarPack {
+    using T = double;
+    static constexpr std::size_t W = 1;
+    static T zero() noexcept { return 0.0; }
+    static T set1(double v) noexcept { return v; }
+    static T load(const double* p) noexcept { return *p; }
+    static void store(double* p, T v) noexcept { *p = v; }
+    static T add(T a, T b) noexcept { return a + b; }
+    static T sub(T a, T b) noexcept { return a - b; }
+    static T mul(T a, T b) noexcept { return a * b; }
+    static T abs(T a) noexcept { return std::fabs(a); }
+    static T max(T a, T b) noexcept { return a < b ? b : a; }
+};
+
+#if defined(ASE_VEC_AVX512)
+struct NativePack {
+    using T = __m512d;
+    static constexpr std::size_t W = 8;
+    static T zero() noexcept { return _mm512_setzero_pd(); }
+    static T set1(double v) noexcept { return _mm512_set1_pd(v); }
+    static T load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+    static void store(double* p, T v) noexcept { _mm512_storeu_pd(p, v); }
+    static T add(T a, T b) noexcept { return _mm512_add_pd(a, b); }
+    static T sub(T a, T b) noexcept { return _mm512_sub_pd(a, b); }
+    static T mul(T a, T b) noexcept { return _mm512_mul_pd(a, b); }
+    static T abs(T a) noexcept { return _mm512_abs_pd(a); }
+    // masked form: avoids GCC's -Wmaybe-uninitialized on _mm512_undefined_pd
+    static T max(T a, T b) noexcept { return _mm512_mask_max_pd(a, 0xFF, a, b); }
+};
+#elif defined(ASE_VEC_AVX)
+struct NativePack {
+    using T = __m256d;
+    static constexpr std::size_t W = 4;
+    static T zero() noexcept { return _mm256_setzero_pd(); }
+    static T set1(double v) noexcept { return _mm256_set1_pd(v); }
+    static T load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, T v) noexcept { _mm256_storeu_pd(p, v); }
+    static T add(T a, T b) noexcept { return _mm256_add_pd(a, b); }
+    static T sub(T a, T b) noexcept { return _mm256_sub_pd(a, b); }
+    static T mul(T a, T b) noexcept { return _mm256_mul_pd(a, b); }
+    static T abs(T a) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static T max(T a, T b) noexcept { return _mm256_max_pd(a, b); }
+};
+#elif defined(ASE_VEC_SSE2)
+struct NativePack {
+    using T = __m128d;
+    static constexpr std::size_t W = 2;
+    static T zero() noexcept { return _mm_setzero_pd(); }
+    static T set1(double v) noexcept { return _mm_set1_pd(v); }
+    static T load(const double* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(double* p, T v) noexcept { _mm_storeu_pd(p, v); }
+    static T add(T a, T b) noexcept { return _mm_add_pd(a, b); }
+    static T sub(T a, T b) noexcept { return _mm_sub_pd(a, b); }
+    static T mul(T a, T b) noexcept { return _mm_mul_pd(a, b); }
+    static T abs(T a) noexcept { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static T max(T a, T b) noexcept { return _mm_max_pd(a, b); }
+};
+#elif defined(ASE_VEC_NEON)
+struct NativePack {
+    using T = float64x2_t;
+    static constexpr std::size_t W = 2;
+    static T zero() noexcept { return vdupq_n_f64(0.0); }
+    static T set1(double v) noexcept { return vdupq_n_f64(v); }
+    static T load(const double* p) noexcept { return vld1q_f64(p); }
+    static void store(double* p, T v) noexcept { vst1q_f64(p, v); }
+    static T add(T a, T b) noexcept { return vaddq_f64(a, b); }
+    static T sub(T a, T b) noexcept { return vsubq_f64(a, b); }
+    static T mul(T a, T b) noexcept { return vmulq_f64(a, b); } // never vfmaq
+    static T abs(T a) noexcept { return vabsq_f64(a); }
+    static T max(T a, T b) noexcept { return vmaxq_f64(a, b); }
+};
+#else
+using NativePack = ScalarPack;
+#endif
+
+static_assert(kLanes % NativePack::W == 0, "lane layout must be a multiple of the vector width");
+
+// Result of one fused pass: a lane-ordered sum and a max.
+struct Reduced {
+    double sum = 0.0;
+    double max = 0.0;
+};
+
+// Fixed combine tree, identical on every ISA
+inline double combine_sum(const double* l) noexcept {
+    return ((l[0] + l[4]) + (l[2] + l[6])) + ((l[1] + l[5]) + (l[3] + l[7]));
+}
+
+inline double combine_max(const double* l, double init) noexcept {
+    double m = init;
+    for (std::size_t j = 0; j < kLanes; ++j) m = ScalarPack::max(m, l[j]);
+    return m;
+}
+
+// Running lane state of a reduction. f(Pack{}, i, sum, max) is called for
+// every Pack::W elements starting at i; f adds into sum and max-folds into
+// max. Element i always lands in lane i % 8, so the result does not depend
+// on Pack::W, nor on how the range is split into fold() calls.
+class Accumulator {
+    using P = NativePack;
+    static constexpr std::size_t R = kLanes / P::W;
+
+public:
+    explicit Accumulator(double max_init) noexcept : max_init_(max_init) {
+        for (std::size_t r = 0; r < R; ++r) {
+            sum_[r] = P::zero();
+            mx_[r] = P::set1(max_init);
+        }
+    }
+
+    // [begin, end): begin and end - begin are multiples of kLanes
+    template <class F>
+    void fold(std::size_t begin, std::size_t end, F& f) noexcept {
+        for (std::size_t i = begin; i < end; i += kLanes) {
+            for (std::size_t r = 0; r < R; ++r) f(P{}, i + r * P::W, sum_[r], mx_[r]);
+        }
+    }
+
+    // Everything folded so far plus the tail [begin, n), n - begin < kLanes
+    template <class F>
+    Reduced finish(std::size_t begin, std::size_t n, F& f) const noexcept {
+        double sl[kLanes];
+        double ml[kLanes];
+        for (std::size_t r = 0; r < R; ++r) {
+            P::store(sl + r * P::W, sum_[r]);
+            P::store(ml + r * P::W, mx_[r]);
+        }
+        for (std::size_t j = 0; begin + j < n; ++j) f(ScalarPack{}, begin + j, sl[j], ml[j]);
+        return {combine_sum(sl), combine_max(ml, max_init_)};
+    }
+
+    // Everything folded so far
+    Reduced partial() const noexcept {
+        const auto none = [](auto, std::size_t, auto&, auto&) {};
+        return finish(0, 0, none);
+    }
+
+private:
+    typename P::T sum_[R];
+    typename P::T mx_[R];
+    double max_init_;
+};
+
+template <class F>
+inline Reduced reduce(std::size_t n, double max_init, F&& f) noexcept {
+    Accumulator acc(max_init);
+    const std::size_t full = n - n % kLanes;
+    acc.fold(0, full, f);
+    return acc.finish(full, n, f);
+}
+
+// Elementwise map with a finiteness guard: returns false if any output is
+// non-finite (outputs are still written).
+template <class F>
+inline bool map_finite(std::size_t n, double* out, F&& f) noexcept {
+    const Reduced r = reduce(n, 0.0, [&](auto p, std::size_t i, auto& guard, auto&) {
+        using P = decltype(p);
+        const auto v = f(p, i);
+        P::store(out + i, v);
+        guard = P::add(guard, P::mul(v, P::zero()));
+    });
+    return r.sum == 0.0;
+}
+
+} // namespace detail
+
+// ----------------------------
+// Reductions over one vector
+// ----------------------------
+
+// true iff every x[i] is finite (x * 0 is 0 exactly for finite x, NaN otherwise)
+inline bool all_finite(const double* x, std::size_t n) noexcept {
+    const detail::Reduced r = detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& s, auto&) {
+        using P = decltype(p);
+        s = P::add(s, P::mul(P::load(x + i), P::zero()));
+    });
+    return r.sum == 0.0;
+}
+
+// Σ x[i]^2; non-finite input (or overflow) yields a non-finite result
+inline double sum_squares(const double* x, std::size_t n) noexcept {
+    return detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& s, auto&) {
+        using P = decltype(p);
+        const auto v = P::load(x + i);
+        s = P::add(s, P::mul(v, v));
+    }).sum;
+}
+
+inline double l2_norm(const double* x, std::size_t n) noexcept {
+    return std::sqrt(sum_squares(x, n));
+}
+
+// ||a - b||2
+inline double l2_norm_diff(const double* a, const double* b, std::size_t n) noexcept {
+    return std::sqrt(detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& s, auto&) {
+        using P = decltype(p);
+        const auto d = P::sub(P::load(a + i), P::load(b + i));
+        s = P::add(s, P::mul(d, d));
+    }).sum);
+}
+
+// max |x[i]|; NaN if any element is non-finite
+inline double linf_norm(const double* x, std::size_t n) noexcept {
+    const detail::Reduced r = detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::load(x + i);
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::abs(v));
+    });
+    return r.sum == 0.0 ? r.max : std::nan("");
+}
+
+// ----------------------------
+// Envelope membership
+// ----------------------------
+
+// all finite and ||x||2 <= R
+inline bool in_l2_ball(const double* x, std::size_t n, double R) noexcept {
+    const double s = sum_squares(x, n);
+    return std::isfinite(s) && std::sqrt(s) <= R;
+}
+
+// all finite and |x[i]| <= R
+inline bool in_linf_ball(const double* x, std::size_t n, double R) noexcept {
+    const double m = linf_norm(x, n);
+    return m == m && m <= R;
+}
+
+// all finite and lo[i] <= x[i] <= hi[i]
+// (lo - x <= 0 exactly when lo <= x, so one max over both gaps decides)
+inline bool in_box(const double* x, const double* lo, const double* hi, std::size_t n) noexcept {
+    const detail::Reduced r = detail::reduce(n, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::load(x + i);
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::max(P::sub(P::load(lo + i), v), P::sub(v, P::load(hi + i))));
+    });
+    return r.sum == 0.0 && r.max <= 0.0;
+}
+
+// x[i] finite and x[i] >= -eps for i < k (sign preservation on a prefix)
+inline bool sign_prefix_nonneg(const double* x, std::size_t k, double eps = 0.0) noexcept {
+    const double floor = -eps;
+    const detail::Reduced r = detail::reduce(k, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::load(x + i);
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::sub(P::set1(floor), v));
+    });
+    return r.sum == 0.0 && r.max <= 0.0;
+}
+
+// all finite, x[i] >= 0 and |Σ x[i] - total| <= tol (the sum in lane order)
+inline bool in_simplex(const double* x, std::size_t n, double total, double tol) noexcept {
+    const detail::Reduced r = detail::reduce(n, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::load(x + i);
+        s = P::add(s, v);
+        m = P::max(m, P::sub(P::zero(), v));
+    });
+    return std::isfinite(r.sum) && r.max <= 0.0 && std::fabs(r.sum - total) <= tol;
+}
+
+// ----------------------------
+// Next-state checks: S + ΔS is evaluated on the fly, never stored.
+// S + ΔS is finite only if S and ΔS are, so one guard covers all three.
+// ----------------------------
+
+inline bool next_in_l2_ball(const double* S, const double* dS, std::size_t n, double R) noexcept {
+    const double s = detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& acc, auto&) {
+        using P = decltype(p);
+        const auto v = P::add(P::load(S + i), P::load(dS + i));
+        acc = P::add(acc, P::mul(v, v));
+    }).sum;
+    return std::isfinite(s) && std::sqrt(s) <= R;
+}
+
+inline bool next_in_linf_ball(const double* S, const double* dS, std::size_t n, double R) noexcept {
+    const detail::Reduced r = detail::reduce(n, 0.0, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::add(P::load(S + i), P::load(dS + i));
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::abs(v));
+    });
+    return r.sum == 0.0 && r.max <= R;
+}
+
+inline bool next_in_box(const double* S, const double* dS,
+                        const double* lo, const double* hi, std::size_t n) noexcept {
+    const detail::Reduced r = detail::reduce(n, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::add(P::load(S + i), P::load(dS + i));
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::max(P::sub(P::load(lo + i), v), P::sub(v, P::load(hi + i))));
+    });
+    return r.sum == 0.0 && r.max <= 0.0;
+}
+
+inline bool next_sign_prefix_nonneg(const double* S, const double* dS, std::size_t k,
+                                    double eps = 0.0) noexcept {
+    const double floor = -eps;
+    const detail::Reduced r = detail::reduce(k, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::add(P::load(S + i), P::load(dS + i));
+        s = P::add(s, P::mul(v, P::zero()));
+        m = P::max(m, P::sub(P::set1(floor), v));
+    });
+    return r.sum == 0.0 && r.max <= 0.0;
+}
+
+inline bool next_in_simplex(const double* S, const double* dS, std::size_t n,
+                            double total, double tol) noexcept {
+    const detail::Reduced r = detail::reduce(n, -HUGE_VAL, [&](auto p, std::size_t i, auto& s, auto& m) {
+        using P = decltype(p);
+        const auto v = P::add(P::load(S + i), P::load(dS + i));
+        s = P::add(s, v);
+        m = P::max(m, P::sub(P::zero(), v));
+    });
+    return std::isfinite(r.sum) && r.max <= 0.0 && std::fabs(r.sum - total) <= tol;
+}
+
+// ----------------------------
+// Blocked checks for very large vectors (10^7..10^9 elements).
+//
+// The input is walked in cache-sized blocks in index order. After every
+// block the hard constraints seen so far are checked and the walk stops at
+// the first violation: a non-finite value, an L∞ or step bound, the sign
+// prefix, or an L2 partial norm that already exceeds the radius (partial
+// sums of squares only grow). Lane accumulators carry over between blocks,
+// so the final norm is bit-identical to l2_norm() whatever the block size,
+// and the verdict equals the unblocked one.
+//
+// The sum of squares must stay finite (non-finite values and overflow both
+// reject).
+// ----------------------------
+
+constexpr std::size_t kBlockSize = 4096; // doubles (32 KiB)
+
+struct BlockLimits final {
+    double l2 = HUGE_VAL;        // ||x||2 <= l2
+    double linf = HUGE_VAL;      // |x[i]| <= linf
+    double step_linf = HUGE_VAL; // |ΔS[i]| <= step_linf (next_within_blocked only)
+    std::size_t sign_prefix = 0; // x[i] >= sign_floor for i < sign_prefix
+    double sign_floor = 0.0;
+};
+
+namespace detail {
+
+// value(P, i) yields next[i]; step(P, i) yields ΔS[i] (or zero)
+template <class Value, class StepOf>
+inline bool within_blocked(std::size_t n, const BlockLimits& lim, std::size_t block,
+                           std::size_t* scanned, Value&& value, StepOf&& step) noexcept {
+    // Block boundaries stay on lane boundaries
+    block = (block < kLanes) ? kLanes : block - block % kLanes;
+
+    // max over |x| - linf and |ΔS| - step_linf: > 0 is a violation
+    const auto f = [&](auto p, std::size_t i, auto& sum, auto& mx) {
+        using P = decltype(p);
+        const auto v = value(p, i);
+        sum = P::add(sum, P::mul(v, v));
+        mx = P::max(mx, P::max(P::sub(P::abs(v), P::set1(lim.linf)),
+                               P::sub(P::abs(step(p, i)), P::set1(lim.step_linf))));
+    };
+    const auto sign_ok = [&](std::size_t b, std::size_t e) {
+        const Reduced r = reduce(e - b, -HUGE_VAL, [&](auto p, std::size_t j, auto& s, auto& m) {
+            using P = decltype(p);
+            const auto v = value(p, b + j);
+            s = P::add(s, P::mul(v, P::zero()));
+            m = P::max(m, P::sub(P::set1(lim.sign_floor), v));
+        });
+        return r.sum == 0.0 && r.max <= 0.0;
+    };
+    const auto ok = [&](const Reduced& r) {
+        return std::isfinite(r.sum) && r.max <= 0.0 && std::sqrt(r.sum) <= lim.l2;
+    };
+
+    Accumulator acc(-HUGE_VAL);
+    const std::size_t full = n - n % kLanes;
+
+    // i counts elements folded into the accumulators
+    std::size_t i = 0;
+    bool pass = true;
+    while (pass && i < full) {
+        const std::size_t end = (full - i < block) ? full : i + block;
+        if (i < lim.sign_prefix && !sign_ok(i, (end < lim.sign_prefix) ? end : lim.sign_prefix)) {
+            pass = false;
+            break;
+        }
+        acc.fold(i, end, f);
+        pass = ok(acc.partial());
+        i = end;
+    }
+
+    if (pass) {
+        if (i < lim.sign_prefix && !sign_ok(i, (n < lim.sign_prefix) ? n : lim.sign_prefix)) {
+            pass = false;
+        } else {
+            pass = ok(acc.finish(full, n, f));
+            i = n;
+        }
+    }
+
+    if (scanned) *scanned = i;
+    return pass;
+}
+
+} // namespace detail
+
+// x satisfies lim (step_linf ignored). *scanned (optional) receives the
+// number of elements folded into the norm before the verdict.
+inline bool within_blocked(const double* x, std::size_t n, const BlockLimits& lim,
+                           std::size_t block = kBlockSize, std::size_t* scanned = nullptr) noexcept {
+    return detail::within_blocked(n, lim, block, scanned,
+        [&](auto p, std::size_t i) { return decltype(p)::load(x + i); },
+        [](auto p, std::size_t) { return decltype(p)::zero(); });
+}
+
+// S + ΔS satisfies lim and |ΔS[i]| <= lim.step_linf; the next state is never stored
+inline bool next_within_blocked(const double* S, const double* dS, std::size_t n,
+                                const BlockLimits& lim, std::size_t block = kBlockSize,
+                                std::size_t* scanned = nullptr) noexcept {
+    return detail::within_blocked(n, lim, block, scanned,
+        [&](auto p, std::size_t i) {
+            using P = decltype(p);
+            return P::add(P::load(S + i), P::load(dS + i));
+        },
+        [&](auto p, std::size_t i) { return decltype(p)::load(dS + i); });
+}
+
+// S + k · base satisfies lim and |k · base[i]| <= lim.step_linf, i.e. the
+// check of a scaled candidate without building it (is_admissible_scaled).
+// k == 0 is the zero step (base is not read).
+inline bool next_scaled_within_blocked(const double* S, const double* base, double k, std::size_t n,
+                                       const BlockLimits& lim, std::size_t block = kBlockSize,
+                                       std::size_t* scanned = nullptr) noexcept {
+    if (k == 0.0) return within_blocked(S, n, lim, block, scanned);
+    return detail::within_blocked(n, lim, block, scanned,
+        [&](auto p, std::size_t i) {
+            using P = decltype(p);
+            return P::add(P::load(S + i), P::mul(P::set1(k), P::load(base + i)));
+        },
+        [&](auto p, std::size_t i) {
+            using P = decltype(p);
+            return P::mul(P::set1(k), P::load(base + i));
+        });
+}
+
+// ----------------------------
+// Step transforms (false => some output is non-finite)
+// ----------------------------
+
+// out[i] = in[i] * k; out may alias in. Usable directly as a scale_step body.
+inline bool scale_into(const double* in, double k, double* out, std::size_t n) noexcept {
+    if (!std::isfinite(k)) return false;
+    return detail::map_finite(n, out, [&](auto p, std::size_t i) {
+        using P = decltype(p);
+        return P::mul(P::load(in + i), P::set1(k));
+    });
+}
+
+// out[i] = a[i] + b[i]; out may alias a or b
+inline bool add_into(const double* a, const double* b, double* out, std::size_t n) noexcept {
+    return detail::map_finite(n, out, [&](auto p, std::size_t i) {
+        using P = decltype(p);
+        return P::add(P::load(a + i), P::load(b + i));
+    });
+}
+
+// out[i] = y[i] + k * x[i]; out may alias x or y (e.g. S ⊕ k·ΔS in place)
+inline bool axpy_into(const double* y, double k, const double* x, double* out, std::size_t n) noexcept {
+    if (!std::isfinite(k)) return false;
+    return detail::map_finite(n, out, [&](auto p, std::size_t i) {
+        using P = decltype(p);
+        return P::add(P::load(y + i), P::mul(P::set1(k), P::load(x + i)));
+    });
+}
+
+// ----------------------------
+// std::array convenience overloads
+// ----------------------------
+
+template <std::size_t N>
+inline bool all_finite(const std::array<double, N>& x) noexcept { return all_finite(x.data(), N); }
+
+template <std::size_t N>
+inline double l2_norm(const std::array<double, N>& x) noexcept { return l2_norm(x.data(), N); }
+
+template <std::size_t N>
+inline double l2_norm_diff(const std::array<double, N>& a, const std::array<double, N>& b) noexcept {
+    return l2_norm_diff(a.data(), b.data(), N);
+}
+
+template <std::size_t N>
+inline double linf_norm(const std::array<double, N>& x) noexcept { return linf_norm(x.data(), N); }
+
+template <std::size_t N>
+inline bool scale_into(const std::array<double, N>& in, double k, std::array<double, N>& out) noexcept {
+    return scale_into(in.data(), k, out.data(), N);
+}
+
+template <std::size_t N>
+inline bool add_into(const std::array<double, N>& a, const std::array<double, N>& b,
+                     std::array<double, N>& out) noexcept {
+    return add_into(a.data(), b.data(), out.data(), N);
+}
+
+} // namespace vec
+} // namespace ase
@@ -0,0 +1,120 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+#include "ase/vector_envelope.hpp"
+
+namespace ase {
+
+// Zero-copy State / Step views for large vector states.
+//
+// Engine takes State by const reference and Step by value, so with a plain
+// vector type every candidate is a full copy. With views the State and the
+// proposal stay where they already are (mmap'd parameter files, pinned or
+// device-staged host buffers, see ase/mapped_file.hpp) and the Engine only
+// moves a few words:
+//
+//   using Engine = ase::Engine<ase::StateView, ase::ScaledStepView>;
+//   deps.scale_step   = &ase::scale_view;   // k·ΔS as a view, nothing written
+//   deps.neutral_step = &ase::neutral_view; // zero step
+//
+// The enforced step is a "scaled-by-k view" of the proposal; the host
+// materializes it exactly once, when it applies S ⊕ ΔS' (apply_step).
+// Views do not own memory: the viewed buffers must outlive every use.
+
+struct StateView final {
+    const double* data = nullptr;
+    std::size_t size = 0;
+
+    const double& operator[](std::size_t i) const noexcept { return data[i]; }
+};
+
+struct StepView final {
+    const double* data = nullptr;
+    std::size_t size = 0;
+
+    const double& operator[](std::size_t i) const noexcept { return data[i]; }
+};
+
+// ΔS = k · base. k == 0 is the zero step of any size (base is never read),
+// which is what neutral_view() returns.
+struct ScaledStepView final {
+    const double* base = nullptr;
+    std::size_t size = 0;
+    double k = 1.0;
+
+    static ScaledStepView of(const StepView& s) noexcept { return {s.data, s.size, 1.0}; }
+
+    bool is_zero() const noexcept { return k == 0.0; }
+
+    double operator[](std::size_t i) const noexcept { return is_zero() ? 0.0 : k * base[i]; }
+};
+
+inline bool operator==(const ScaledStepView& a, const ScaledStepView& b) noexcept {
+    if (a.is_zero() || b.is_zero()) return a.is_zero() && b.is_zero();
+    return a.base == b.base && a.size == b.size && a.k == b.k;
+}
+
+inline bool operator!=(const ScaledStepView& a, const ScaledStepView& b) noexcept {
+    return !(a == b);
+}
+
+// ----------------------------
+// Hooks for Engine<..., ScaledStepView>
+// ----------------------------
+
+// scale_step hook: out = k · in, as a view (O(1), no element is touched)
+inline bool scale_view(const ScaledStepView& in, double k, ScaledStepView& out) noexcept {
+    if (!std::isfinite(k)) return false;
+    const double kk = in.k * k;
+    if (!std::isfinite(kk)) return false;
+    out = {in.base, in.size, kk};
+    return true;
+}
+
+// neutral_step hook
+inline ScaledStepView neutral_view() noexcept {
+    return {nullptr, 0, 0.0};
+}
+
+// ----------------------------
+// Materialization (host side, once per applied step)
+// ----------------------------
+
+// out[i] = ΔS[i] for i < n. false on size mismatch or non-finite output.
+inline bool materialize(const ScaledStepView& dS, double* out, std::size_t n) noexcept {
+    if (dS.is_zero()) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = 0.0;
+        return true;
+    }
+    if (dS.size != n) return false;
+    return vec::scale_into(dS.base, dS.k, out, n);
+}
+
+// S ⊕ ΔS in place: state[i] += k · base[i]. A zero step leaves the state
+// untouched. false on size mismatch (nothing written) or if the result is
+// non-finite (state already written).
+inline bool apply_step(const ScaledStepView& dS, double* state, std::size_t n) noexcept {
+    if (dS.is_zero()) return true;
+    if (dS.size != n) return false;
+    return vec::axpy_into(state, dS.k, dS.base, state, n);
+}
+
+// ----------------------------
+// Envelope checks reading through the views (nothing materialized)
+// ----------------------------
+
+// S + k · base satisfies lim (see vec::next_within_blocked)
+inline bool next_within_blocked(const StateView& S, const ScaledStepView& dS,
+                                const vec::BlockLimits& lim,
+                                std::size_t block = vec::kBlockSize,
+                                std::size_t* scanned = nullptr) noexcept {
+    if (!dS.is_zero() && dS.size != S.size) {
+        if (scanned) *scanned = 0;
+        return false;
+    }
+
+    return vec::next_scaled_within_blocked(S.data, dS.base, dS.k, S.size, lim, block, scanned);
+}
+
+} // namespace ase
@@ -28,6 +28,8 @@
 #include <string>
 
 #include "ase/ase.hpp"
+#include "ase/envelope_spec.hpp"
+#include "ase/stats.hpp"
 
 namespace {
 
@@ -231,47 +233,79 @@ inline State derive_next(const State& S, const Step& dtheta) {
     return next;
 }
 
-inline bool step_finite_and_bounded(const Step& dtheta) {
-    for (double x : dtheta) {
-        if (!is_finite(x)) return false;
-        if (std::fabs(x) > g_env.R_dinf + g_env.tol) return false;
-    }
-    return true;
+// The same envelope + transition, declared once and evaluated in a single
+// streaming pass (no materialized next State per scale/bisection attempt).
+// Channels: 0 = theta, 1 = m, 2 = v, 3 = ema.
+static ase::EnvelopeSpec<4> g_spec;
+
+inline void build_spec() {
+    const double tol = g_env.tol;
+    g_spec = ase::EnvelopeSpec<4>{};
+    g_spec.transition(0, 1.0, 1.0)                                  // theta + dtheta
+          .transition(1, g_env.b1, 1.0 - g_env.b1)                  // m
+          .transition(2, g_env.b2, 0.0, 1.0 - g_env.b2).clamp_nonneg(2) // v
+          .transition(3, g_env.beta, 0.0).feed(3, 0, 1.0 - g_env.beta)  // ema over theta_next
+          .l2_ball(0, g_env.R_theta + tol)
+          .l2_ball(1, g_env.R_m + tol)
+          .l2_ball(2, g_env.R_v + tol)
+          .l2_ball(3, g_env.R_ema + tol)
+          .l2_gap(3, 0, g_env.R_gap + tol)
+          .lower_bound(0, -tol, g_env.sign_preserve_k)
+          .lower_bound(2, -tol)
+          .step_linf(g_env.R_dinf + tol);
+}
+
+inline ase::EnvelopeSpec<4>::Channels channels(const State& s) {
+    return {s.theta.data(), s.m.data(), s.v.data(), s.ema.data()};
+}
+
+// Admissibility of dtheta at an S already known to be valid
+// (step_next == step + 1 holds by construction of derive_next)
+inline bool is_next_admissible(const State& S, const Step& dtheta) {
+    return g_spec.admits(channels(S), dtheta.data(), N);
 }
 
 bool is_admissible(const State& S, const Step& dtheta) {
-    if (!is_state_valid_materialized(S)) return false;
-    if (!step_finite_and_bounded(dtheta)) return false;
+    if (!g_spec.contains(channels(S), N)) return false;
+    return is_next_admissible(S, dtheta);
+}
+
+// Split-phase admissibility: validity of S is checked once per enforcement
+// instead of once per candidate.
+struct AdmissibleContext {};
 
-    const State next = derive_next(S, dtheta);
-    if (next.step != S.step + 1) return false;
+bool prepare(const State& S, AdmissibleContext&) {
+    return g_spec.contains(channels(S), N);
+}
 
-    return is_state_valid_materialized(next);
+bool is_admissible_ctx(const State& S, const AdmissibleContext&, const Step& dtheta) {
+    return is_next_admissible(S, dtheta);
 }
 
 // Project step: deterministic scalar search for k in [0,1] such that admissible(S, k*in)
 bool project_step(const State& S, const Step& in, Step& out) {
-    if (!is_state_valid_materialized(S)) return false;
+    if (!g_spec.contains(channels(S), N)) return false;
     // input must be finite (bounds handled by scaling too, but keep strict)
     for (double x : in) if (!is_finite(x)) return false;
 
     // if in violates per-component bound, treat as needing projection
-    if (is_admissible(S, in)) { out = in; return true; }
+    // (S is valid from here on, so only the next state is checked)
+    if (is_next_admissible(S, in)) { out = in; return true; }
 
     const Step z = neutral_step();
-    if (!is_admissible(S, z)) return false; // neutral must be admissible
+    if (!is_next_admissible(S, z)) return false; // neutral must be admissible
 
     double lo = 0.0, hi = 1.0;
+    Step cand{};
     for (int it = 0; it < 24; ++it) {
         const double mid = 0.5 * (lo + hi);
-        Step cand{};
         if (!scale_step(in, mid, cand)) return false;
-        if (is_admissible(S, cand)) lo = mid;
+        if (is_next_admissible(S, cand)) lo = mid;
         else hi = mid;
     }
 
     if (!scale_step(in, lo, out)) return false;
-    return is_admissible(S, out);
+    return is_next_admissible(S, out);
 }
 
 // ----------------------------
@@ -333,17 +367,24 @@ RunStats run_loop(const std::string& label,
     cfg.max_scale_attempts = 16;
     cfg.scale_factor = 0.5;
 
-    ase::Dependencies<State, Step> deps;
-    deps.is_admissible = &is_admissible;
-    deps.neutral_step  = &neutral_step;
-    deps.scale_step    = &scale_step;
-    deps.project_step  = &project_step;
+    ase::Dependencies<State, Step, AdmissibleContext> deps;
+    deps.is_admissible     = &is_admissible;
+    deps.neutral_step      = &neutral_step;
+    deps.scale_step        = &scale_step;
+    deps.project_step      = &project_step;
+    deps.prepare           = &prepare;
+    deps.is_admissible_ctx = &is_admissible_ctx;
 
-    ase::Engine<State, Step> engine(cfg, deps);
+    using Stats = ase::ShardedStats<1>;
+    Stats stats;
+    ase::Engine<State, Step, AdmissibleContext, Stats> engine(cfg, deps, &stats);
 
     RunStats st{};
     st.steps = T;
 
+    // Host-owned warm start: consecutive steps after a spike need similar k
+    ase::ScaleHint hint;
+
     for (std::size_t t = 0; t < T; ++t) {
         const Step prop = propose_dtheta(s, rng);
 
@@ -355,10 +396,9 @@ RunStats run_loop(const std::string& label,
 
         Step eff = prop;
         if (use_ase) {
-            eff = engine.enforce(s, prop);
-            bool is_neutral = true;
-            for (double x : eff) { if (x != 0.0) { is_neutral = false; break; } }
-            if (is_neutral) st.neutral_emitted++;
+            const ase::EnforceOutcome<Step> r = engine.enforce_outcome(s, prop, hint);
+            eff = r.step;
+            hint.k = (r.kind == ase::Outcome::Scaled) ? r.k : 1.0;
         }
 
         s = derive_next(s, eff);
@@ -369,6 +409,8 @@ RunStats run_loop(const std::string& label,
         }
     }
 
+    st.neutral_emitted = static_cast<std::size_t>(stats.snapshot().neutral);
+
     st.th   = l2_norm(s.theta);
     st.m    = l2_norm(s.m);
     st.v    = l2_norm(s.v);
@@ -406,6 +448,7 @@ int main() {
     g_env.b2   = 0.999;
     g_env.beta = 0.98;
     g_env.tol  = 1e-12;
+    build_spec();
 
     State s0{};
     s0.step = 0;
@@ -252,20 +252,16 @@ RunStats run_loop(const std::string& label,
 
         if (!is_admissible(theta, proposed)) st.inadmissible_proposed++;
 
-        Step eff = proposed;
         if (use_ase) {
-            eff = engine.enforce(theta, proposed);
+            const ase::EnforceOutcome<Step> r = engine.enforce_outcome(theta, proposed);
 
-            // neutral detection
-            bool is_neutral = true;
-            for (double x : eff) {
-                if (x != 0.0) { is_neutral = false; break; }
-            }
-            if (is_neutral) st.neutral_emitted++;
+            // neutral step is the zero step: nothing to apply
+            if (r.is_neutral()) st.neutral_emitted++;
+            else theta = add(theta, r.step);
+        } else {
+            theta = add(theta, proposed);
         }
 
-        theta = add(theta, eff);
-
         // Keep demo invariant: state remains valid under ASE modes (should always hold)
         // For NO_ASE, we allow it to explode (that’s the point).
         if (use_ase) {
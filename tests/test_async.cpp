@@ -0,0 +1,224 @@
+// tests/test_async.cpp
+// Asynchronous enforcement: many operations in flight on one thread, resumed
+// in arbitrary interleavings, produce exactly enforce_outcome's step and
+// decision (every mode and search, warm starts, closed-form solver, vector
+// steps); the attempt bound holds; failed verdicts, missing hooks and an
+// oversized attempt bound fail closed.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/stats.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool admissible_limit(const double& S, const double& dS) {
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    const double next = S + dS;
+    return std::isfinite(next) && std::fabs(next) <= 1.0;
+}
+
+static double neutral_zero() { return 0.0; }
+
+static bool scale_mul(const double& in, double k, double& out) {
+    if (!std::isfinite(in) || !std::isfinite(k)) return false;
+    out = in * k;
+    return std::isfinite(out);
+}
+
+static bool project_clamp(const double& S, const double& dS, double& out) {
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    const double next = std::fmax(-1.0, std::fmin(1.0, S + dS));
+    out = next - S;
+    return true;
+}
+
+static bool solve_limit(const double& S, const double& dS, double& k_max) {
+    if (dS == 0.0) return false;
+    k_max = ((dS > 0.0 ? 1.0 : -1.0) - S) / dS;
+    return true;
+}
+
+static bool same(const ase::Decision& a, ase::Outcome kind, double k, std::uint8_t attempts) {
+    return a.kind == kind && a.k == k && a.attempts == attempts;
+}
+
+using Op = ase::AsyncEnforcement<double, double>;
+using Eng = ase::Engine<double, double>;
+
+// Runs n operations at once; each round resumes the pending ones in a
+// shuffled order, answering with is_admissible
+static void check_against_blocking(const Eng& eng, const std::vector<double>& S, const std::vector<double>& dS,
+                                   const std::vector<ase::ScaleHint>& hints, std::mt19937& rng) {
+    const std::size_t n = S.size();
+    std::vector<Op> ops(n);
+    for (std::size_t i = 0; i < n; ++i) eng.enforce_async(S[i], dS[i], ops[i], hints[i]);
+
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) order[i] = i;
+    for (bool pending = true; pending;) {
+        pending = false;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (std::size_t i : order) {
+            if (ops[i].done()) continue;
+            pending = true;
+            const bool ok = admissible_limit(ops[i].state(), ops[i].candidate());
+            eng.resume(ops[i], ok ? ase::Verdict::Admissible : ase::Verdict::Inadmissible);
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const ase::EnforceOutcome<double> ref = eng.enforce_outcome(S[i], dS[i], hints[i]);
+        const ase::Decision& d = ops[i].decision();
+        REQUIRE(ops[i].step() == ref.step);
+        REQUIRE(same(d, ref.kind, ref.k, ref.attempts));
+    }
+}
+
+static void test_matches_blocking() {
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<double> us(-1.0, 1.0);
+    std::uniform_real_distribution<double> ud(-8.0, 8.0);
+    std::uniform_real_distribution<double> uh(0.0, 1.2);
+
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 6, 0.5},
+        {ase::Mode::Scale, 24, 0.5, ase::ScaleSearch::Bisection, 1e-6},
+        {ase::Mode::Project},
+    };
+    for (const ase::Config& cfg : cfgs) {
+        for (bool solver : {false, true}) {
+            ase::Dependencies<double, double> deps{&admissible_limit, &neutral_zero, &scale_mul, &project_clamp};
+            if (solver) deps.solve_scale = &solve_limit;
+            const Eng eng(cfg, deps);
+
+            const std::size_t n = 300;
+            std::vector<double> S(n), dS(n);
+            std::vector<ase::ScaleHint> hints(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                S[i] = us(rng);
+                dS[i] = (i % 5 == 0) ? 0.01 * ud(rng) : ud(rng);
+                hints[i].k = (i % 2) ? uh(rng) : 1.0;
+            }
+            dS[7] = std::numeric_limits<double>::quiet_NaN();
+            check_against_blocking(eng, S, dS, hints, rng);
+        }
+    }
+}
+
+// Vector steps: the accepted candidate is kept apart from the one in flight
+using Vec = std::vector<double>;
+
+static bool admissible_vec(const Vec& S, const Vec& dS) {
+    if (S.size() != dS.size()) return false;
+    double sq = 0.0;
+    for (std::size_t i = 0; i < S.size(); ++i) sq += (S[i] + dS[i]) * (S[i] + dS[i]);
+    return std::isfinite(sq) && sq <= 1.0;
+}
+
+static Vec neutral_vec() { return Vec{}; }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) out[i] = k * in[i];
+    return true;
+}
+
+static void test_vector_steps() {
+    const ase::Engine<Vec, Vec> eng({ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+                                    {&admissible_vec, &neutral_vec, &scale_vec, nullptr});
+    const Vec S{0.3, -0.2, 0.1};
+    const Vec dS{2.0, 1.0, -3.0};
+
+    ase::AsyncEnforcement<Vec, Vec> op;
+    for (double hint : {1.0, 0.2, 0.9}) {
+        eng.enforce_async(S, dS, op, {hint});
+        std::size_t rounds = 0;
+        while (!op.done()) {
+            ++rounds;
+            eng.resume(op, admissible_vec(op.state(), op.candidate()) ? ase::Verdict::Admissible
+                                                                      : ase::Verdict::Inadmissible);
+        }
+        const ase::EnforceOutcome<Vec> ref = eng.enforce_outcome(S, dS, {hint});
+        REQUIRE(op.step() == ref.step);
+        REQUIRE(same(op.decision(), ref.kind, ref.k, ref.attempts));
+        REQUIRE(rounds == 1u + ref.attempts);      // one verdict per candidate, proposal included
+        REQUIRE(ref.attempts <= 20 && ref.kind == ase::Outcome::Scaled);
+    }
+}
+
+static void test_fail_closed() {
+    using Stats = ase::ShardedStats<>;
+    Stats stats;
+    const ase::Dependencies<double, double> deps{&admissible_limit, &neutral_zero, &scale_mul, nullptr};
+    const ase::Engine<double, double, ase::NoContext, Stats> eng({ase::Mode::Scale, 16, 0.5}, deps, &stats);
+
+    // A failed evaluation at any point => neutral
+    ase::AsyncEnforcement<double, double> op;
+    const double S = 0.9, dS = 0.5;
+    eng.enforce_async(S, dS, op);
+    eng.resume(op, ase::Verdict::Inadmissible); // proposal
+    eng.resume(op, ase::Verdict::Inadmissible); // k = 1
+    REQUIRE(!op.done() && op.candidate() == 0.25);
+    eng.resume(op, ase::Verdict::Failed);
+    REQUIRE(op.done() && op.step() == 0.0 && op.decision().is_neutral());
+    REQUIRE(op.decision().attempts == 2);
+    eng.resume(op, ase::Verdict::Admissible);  // ignored once done
+    REQUIRE(op.decision().is_neutral());
+
+    // Inadmissible answers throughout exhaust the bound
+    eng.enforce_async(S, dS, op);
+    std::size_t rounds = 0;
+    while (!op.done()) {
+        ++rounds;
+        eng.resume(op, ase::Verdict::Inadmissible);
+    }
+    REQUIRE(rounds == 17 && op.decision().is_neutral() && op.decision().attempts == 16);
+
+    const ase::StatsSnapshot snap = stats.snapshot();
+    REQUIRE(snap.evaluation_failures == 1);
+    REQUIRE(snap.neutral == 2);
+
+    // Missing neutral step: done at once, no candidate
+    const Eng no_neutral({ase::Mode::Scale}, {&admissible_limit, nullptr, &scale_mul, nullptr});
+    no_neutral.enforce_async(0.0, 0.1, op);
+    REQUIRE(op.done() && op.decision().is_neutral());
+
+    // Missing mode hook: neutral after the proposal
+    const Eng no_project({ase::Mode::Project}, deps);
+    no_project.enforce_async(0.9, 0.5, op);
+    no_project.resume(op, ase::Verdict::Inadmissible);
+    REQUIRE(op.done() && op.decision().is_neutral());
+
+    // Attempt bound beyond the fixed verdict log: neutral at once, and
+    // recorded, although the blocking path searches with the same Config
+    Stats over;
+    const ase::Config big{ase::Mode::Scale, ase::kMaxAsyncScaleAttempts + 1, 0.5};
+    const ase::Engine<double, double, ase::NoContext, Stats> too_many(big, deps, &over);
+    too_many.enforce_async(0.9, 0.5, op);
+    REQUIRE(op.done() && op.decision().is_neutral() && op.decision().attempts == 0);
+    const ase::StatsSnapshot os = over.snapshot();
+    REQUIRE(os.unsupported_configs == 1 && os.neutral == 1);
+    REQUIRE(os.missing_hooks == 0 && os.evaluation_failures == 0);
+    const ase::EnforceOutcome<double> blocking = too_many.enforce_outcome(0.9, 0.5);
+    REQUIRE(blocking.kind == ase::Outcome::Scaled && blocking.step == 0.0625);
+    too_many.enforce_async(0.9, 0.05, op); // even an admissible proposal
+    REQUIRE(op.done() && op.decision().is_neutral() && over.snapshot().unsupported_configs == 2);
+}
+
+int main() {
+    test_matches_blocking();
+    test_vector_steps();
+    test_fail_closed();
+    return 0;
+}
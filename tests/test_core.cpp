@@ -1,7 +1,11 @@
 // tests/test_core.cpp
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <limits>
+#include <vector>
 
 #include "ase/ase.hpp"
 
@@ -171,6 +175,1188 @@ static void test_project() {
     (void)eff;
 }
 
+static bool admissible_limit_batch(const double* S, const double* dS, bool* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = admissible_limit(S[i], dS[i]);
+    return true;
+}
+
+static bool failing_batch(const double*, const double*, bool*, std::size_t) {
+    return false;
+}
+
+static bool throwing_batch(const double*, const double*, bool*, std::size_t) {
+    throw 1;
+}
+
+// Stats sink counting hook failures by kind
+struct FailureCounts final {
+    int by_kind[5] = {};
+    int enforcements = 0;
+
+    void on_enforce(ase::Outcome, std::size_t) noexcept { ++enforcements; }
+    void on_hook_failure(ase::HookFailure kind) noexcept { ++by_kind[static_cast<int>(kind)]; }
+};
+
+static void test_batch_matches_scalar() {
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Project},
+    };
+
+    // > one internal chunk, mixes pass-through / scaled / projected / NaN
+    constexpr std::size_t n = 150;
+    double S[n];
+    double dS[n];
+    for (std::size_t i = 0; i < n; ++i) {
+        S[i]  = -1.0 + 2.0 * static_cast<double>(i) / static_cast<double>(n);
+        dS[i] = (i % 3 == 0) ? 0.05 : 0.75 * static_cast<double>(i % 5) - 1.5;
+    }
+    dS[7]  = std::numeric_limits<double>::quiet_NaN();
+    dS[99] = std::numeric_limits<double>::infinity();
+
+    for (const ase::Config& cfg : cfgs) {
+        for (int use_batch_hook = 0; use_batch_hook < 2; ++use_batch_hook) {
+            ase::Dependencies<double,double> deps{
+                &admissible_limit,
+                &neutral_zero,
+                &scale_mul,
+                &project_clamp
+            };
+            if (use_batch_hook) deps.is_admissible_batch = &admissible_limit_batch;
+
+            ase::Engine<double,double> eng(cfg, deps);
+
+            double out[n];
+            eng.enforce_batch(S, dS, out, n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const double ref = eng.enforce(S[i], dS[i]);
+                assert(out[i] == ref);
+                (void)ref;
+            }
+
+            // In-place (out aliases proposed)
+            double inplace[n];
+            for (std::size_t i = 0; i < n; ++i) inplace[i] = dS[i];
+            eng.enforce_batch(S, inplace, inplace, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                assert(inplace[i] == out[i]);
+            }
+            (void)out;
+            (void)inplace;
+        }
+    }
+}
+
+static void test_batch_fail_closed() {
+    ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+
+    ase::Dependencies<double,double> deps{
+        &admissible_limit,
+        &neutral_zero,
+        &scale_mul,
+        nullptr
+    };
+    deps.is_admissible_batch = &failing_batch;
+
+    ase::Engine<double,double> eng(cfg, deps);
+
+    const double S[2]  = {0.0, 0.9};
+    const double dS[2] = {0.2, 0.5};
+    double out[2] = {1.0, 1.0};
+    eng.enforce_batch(S, dS, out, 2);
+
+    // Batch evaluation failure => neutral for every pair
+    assert(out[0] == 0.0);
+    assert(out[1] == 0.0);
+
+    // ... and recorded for every pair: false return vs exception
+    {
+        using Counted = ase::Engine<double, double, ase::NoContext, FailureCounts>;
+        FailureCounts counts;
+        const Counted rejected(cfg, deps, &counts);
+        rejected.enforce_batch(S, dS, out, 2);
+        assert(counts.enforcements == 2);
+        assert(counts.by_kind[static_cast<int>(ase::HookFailure::Evaluation)] == 2);
+        assert(counts.by_kind[static_cast<int>(ase::HookFailure::Exception)] == 0);
+
+        ase::Dependencies<double,double> tdeps = deps;
+        tdeps.is_admissible_batch = &throwing_batch;
+        FailureCounts tcounts;
+        const Counted thrown(cfg, tdeps, &tcounts);
+        ase::Decision d[2];
+        thrown.enforce_batch(S, dS, out, 2, d);
+        assert(d[0].is_neutral() && d[1].is_neutral() && out[0] == 0.0 && out[1] == 0.0);
+        assert(tcounts.by_kind[static_cast<int>(ase::HookFailure::Exception)] == 2);
+        assert(tcounts.by_kind[static_cast<int>(ase::HookFailure::Evaluation)] == 0);
+        (void)d;
+    }
+
+    // Missing critical hook => neutral for every pair
+    deps.is_admissible = nullptr;
+    ase::Engine<double,double> broken(cfg, deps);
+    out[0] = out[1] = 1.0;
+    broken.enforce_batch(S, dS, out, 2);
+    assert(out[0] == 0.0);
+    assert(out[1] == 0.0);
+    (void)out;
+}
+
+using Vec = std::vector<double>;
+
+static bool admissible_vec(const Vec& S, const Vec& dS) {
+    if (S.size() != dS.size()) return false;
+    for (std::size_t i = 0; i < S.size(); ++i) {
+        if (!admissible_limit(S[i], dS[i])) return false;
+    }
+    return true;
+}
+
+static Vec neutral_vec() { return Vec(3, 0.0); }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        if (!scale_mul(in[i], k, out[i])) return false;
+    }
+    return true;
+}
+
+static bool project_vec(const Vec& S, const Vec& dS, Vec& out) {
+    if (S.size() != dS.size()) return false;
+    out.resize(dS.size());
+    for (std::size_t i = 0; i < dS.size(); ++i) {
+        if (!project_clamp(S[i], dS[i], out[i])) return false;
+    }
+    return true;
+}
+
+static void test_enforce_into_matches_enforce() {
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Project},
+    };
+
+    const double inputs[] = {-0.9, 0.0, 0.2, 0.5, 0.9, 1.5,
+                             std::numeric_limits<double>::quiet_NaN()};
+
+    for (const ase::Config& cfg : cfgs) {
+        // Trivially copyable step
+        {
+            ase::Dependencies<double,double> deps{
+                &admissible_limit, &neutral_zero, &scale_mul, &project_clamp
+            };
+            ase::Engine<double,double> eng(cfg, deps);
+            ase::Scratch<double> scratch;
+
+            for (double S : inputs) {
+                for (double dS : inputs) {
+                    const double ref = eng.enforce(S, dS);
+                    (void)ref;
+
+                    double out = 123.0;
+                    const bool derived = eng.enforce_into(S, dS, out, scratch);
+                    assert(out == ref);
+                    assert(derived || out == neutral_zero());
+
+                    double inplace = dS;
+                    eng.enforce_into(S, inplace, inplace, scratch);
+                    assert(inplace == ref);
+                    (void)derived;
+                }
+            }
+        }
+
+        // Non-trivially copyable step (buffers reused across calls)
+        {
+            ase::Dependencies<Vec,Vec> deps{
+                &admissible_vec, &neutral_vec, &scale_vec, &project_vec
+            };
+            ase::Engine<Vec,Vec> eng(cfg, deps);
+            ase::Scratch<Vec> scratch;
+
+            const Vec S  = {0.9, 0.0, -0.5};
+            const Vec dS = {0.5, 0.1, -0.2};
+            const Vec ref = eng.enforce(S, dS);
+
+            Vec out;
+            for (int rep = 0; rep < 3; ++rep) {
+                eng.enforce_into(S, dS, out, scratch);
+                assert(out == ref);
+            }
+
+            Vec inplace = dS;
+            eng.enforce_into(S, inplace, inplace, scratch);
+            assert(inplace == ref);
+        }
+    }
+}
+
+static int g_eval_calls = 0;
+
+static bool admissible_counted(const double& S, const double& dS) {
+    ++g_eval_calls;
+    return admissible_limit(S, dS);
+}
+
+static void test_scale_bisection() {
+    ase::Config cfg{ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection, 1e-3};
+
+    ase::Dependencies<double,double> deps{
+        &admissible_counted,
+        &neutral_zero,
+        &scale_mul,
+        nullptr
+    };
+
+    ase::Engine<double,double> eng(cfg, deps);
+
+    // Largest admissible k is 0.2 (0.9 + 0.2 * 0.5 == 1.0)
+    g_eval_calls = 0;
+    const double eff = eng.enforce(0.9, 0.5);
+    const int calls = g_eval_calls;
+
+    assert(admissible_limit(0.9, eff));
+    assert(eff <= 0.1 && eff >= 0.1 - 0.5 * cfg.scale_tolerance);
+
+    // Bounded: initial check + at most max_scale_attempts probes,
+    // and the tolerance ends the search early (2^-10 < 1e-3)
+    assert(calls <= 1 + 10);
+
+    // Deterministic
+    const double again = eng.enforce(0.9, 0.5);
+    assert(again == eff);
+
+    // Same result via enforce_into / enforce_batch
+    ase::Scratch<double> scratch;
+    double out = 0.0;
+    eng.enforce_into(0.9, 0.5, out, scratch);
+    assert(out == eff);
+
+    const double S[1] = {0.9};
+    const double dS[1] = {0.5};
+    double batch[1] = {0.0};
+    eng.enforce_batch(S, dS, batch, 1);
+    assert(batch[0] == eff);
+
+    // Attempt bound is honoured even with zero tolerance
+    ase::Config tight{ase::Mode::Scale, 4, 0.5, ase::ScaleSearch::Bisection, 0.0};
+    ase::Engine<double,double> bounded(tight, deps);
+    g_eval_calls = 0;
+    const double eff4 = bounded.enforce(0.9, 0.5);
+    assert(g_eval_calls == 1 + 4);
+    assert(admissible_limit(0.9, eff4));
+
+    // No admissible k => neutral
+    g_eval_calls = 0;
+    const double none = eng.enforce(0.0, std::numeric_limits<double>::infinity());
+    assert(none == 0.0);
+    (void)eff;
+    (void)calls;
+    (void)again;
+    (void)eff4;
+    (void)none;
+}
+
+// Split-phase admissibility: per-state invariants cached once per enforcement
+struct LimitContext {
+    bool state_finite = false;
+};
+
+static int g_prepare_calls = 0;
+static int g_ctx_calls = 0;
+
+static bool prepare_limit(const double& S, LimitContext& ctx) {
+    ++g_prepare_calls;
+    ctx.state_finite = is_finite(S);
+    return ctx.state_finite;
+}
+
+static bool admissible_limit_ctx(const double& S, const LimitContext& ctx, const double& dS) {
+    ++g_ctx_calls;
+    if (!ctx.state_finite || !is_finite(dS)) return false;
+    const double next = S + dS;
+    return is_finite(next) && std::fabs(next) <= 1.0;
+}
+
+static void test_split_phase_context() {
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection, 1e-3},
+        {ase::Mode::Project},
+    };
+
+    const double inputs[] = {-0.9, 0.0, 0.2, 0.5, 0.9, 1.5,
+                             std::numeric_limits<double>::quiet_NaN()};
+
+    for (const ase::Config& cfg : cfgs) {
+        ase::Dependencies<double,double> ref_deps{
+            &admissible_limit, &neutral_zero, &scale_mul, &project_clamp
+        };
+        ase::Engine<double,double> ref(cfg, ref_deps);
+
+        // is_admissible left null: the split-phase pair is sufficient
+        ase::Dependencies<double,double,LimitContext> deps;
+        deps.neutral_step      = &neutral_zero;
+        deps.scale_step        = &scale_mul;
+        deps.project_step      = &project_clamp;
+        deps.prepare           = &prepare_limit;
+        deps.is_admissible_ctx = &admissible_limit_ctx;
+        ase::Engine<double,double,LimitContext> eng(cfg, deps);
+
+        ase::Scratch<double> scratch;
+        for (double S : inputs) {
+            for (double dS : inputs) {
+                g_prepare_calls = 0;
+                const double eff = eng.enforce(S, dS);
+                const double expected = ref.enforce(S, dS);
+                assert(eff == expected);
+                (void)expected;
+                assert(g_prepare_calls == 1); // once per enforcement, not per attempt
+
+                double out = 1.0;
+                eng.enforce_into(S, dS, out, scratch);
+                assert(out == eff);
+
+                double batch = 1.0;
+                eng.enforce_batch(&S, &dS, &batch, 1);
+                assert(batch == eff);
+                (void)eff;
+            }
+        }
+    }
+
+    // Scale: many candidates evaluated against one prepared context
+    ase::Dependencies<double,double,LimitContext> deps;
+    deps.neutral_step      = &neutral_zero;
+    deps.scale_step        = &scale_mul;
+    deps.prepare           = &prepare_limit;
+    deps.is_admissible_ctx = &admissible_limit_ctx;
+    ase::Engine<double,double,LimitContext> eng({ase::Mode::Scale, 16, 0.5}, deps);
+
+    g_prepare_calls = 0;
+    g_ctx_calls = 0;
+    const double scaled = eng.enforce(0.9, 0.5);
+    assert(scaled == 0.0625);
+    (void)scaled;
+    assert(g_prepare_calls == 1);
+    assert(g_ctx_calls == 1 + 4);
+
+    // Invalid state => prepare fails => neutral without evaluating any candidate
+    g_ctx_calls = 0;
+    const double invalid = eng.enforce(std::numeric_limits<double>::infinity(), -0.1);
+    assert(invalid == 0.0);
+    (void)invalid;
+    assert(g_ctx_calls == 0);
+
+    // Only one half of the pair and no plain predicate => fail-closed
+    deps.prepare = nullptr;
+    ase::Engine<double,double,LimitContext> broken({ase::Mode::Scale, 16, 0.5}, deps);
+    const double eff_broken = broken.enforce(0.0, 0.2);
+    assert(eff_broken == 0.0);
+    (void)eff_broken;
+}
+
+// Analytic boundary of |S + k dS| <= 1, shrunk slightly for rounding
+static bool solve_limit(const double& S, const double& dS, double& k_max) {
+    if (!is_finite(S) || !is_finite(dS) || dS == 0.0) return false;
+    const double bound = (dS > 0.0) ? (1.0 - S) : (-1.0 - S);
+    k_max = (bound / dS) * (1.0 - 1e-12);
+    return true;
+}
+
+static bool solve_too_large(const double&, const double&, double& k_max) {
+    k_max = 0.99;
+    return true;
+}
+
+static bool solve_none(const double&, const double&, double&) {
+    return false;
+}
+
+static void test_solve_scale() {
+    ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+
+    ase::Dependencies<double,double> deps{
+        &admissible_counted,
+        &neutral_zero,
+        &scale_mul,
+        nullptr
+    };
+    ase::Engine<double,double> geometric(cfg, deps);
+    const double geometric_eff = geometric.enforce(0.9, 0.5);
+
+    // Exact solver: initial check + one verification
+    deps.solve_scale = &solve_limit;
+    ase::Engine<double,double> solved(cfg, deps);
+    g_eval_calls = 0;
+    const double eff = solved.enforce(0.9, 0.5);
+    assert(g_eval_calls == 2);
+    assert(admissible_limit(0.9, eff));
+    assert(eff > geometric_eff && std::fabs(0.9 + eff - 1.0) < 1e-9);
+
+    // Pass-through never consults the solver
+    g_eval_calls = 0;
+    const double pass = solved.enforce(0.0, 0.2);
+    assert(pass == 0.2);
+    (void)pass;
+    assert(g_eval_calls == 1);
+
+    // Wrong solver => one extra evaluation, then the configured search
+    deps.solve_scale = &solve_too_large;
+    ase::Engine<double,double> wrong(cfg, deps);
+    g_eval_calls = 0;
+    const double fallback = wrong.enforce(0.9, 0.5);
+    assert(fallback == geometric_eff);
+    (void)fallback;
+    assert(g_eval_calls <= 1 + 1 + static_cast<int>(cfg.max_scale_attempts));
+
+    // No candidate => plain search
+    deps.solve_scale = &solve_none;
+    ase::Engine<double,double> none(cfg, deps);
+    const double plain = none.enforce(0.9, 0.5);
+    assert(plain == geometric_eff);
+    (void)plain;
+
+    // Non-finite proposal still fails closed
+    deps.solve_scale = &solve_limit;
+    ase::Engine<double,double> nan_case(cfg, deps);
+    const double neutral = nan_case.enforce(0.0, std::numeric_limits<double>::quiet_NaN());
+    assert(neutral == 0.0);
+    (void)neutral;
+    (void)eff;
+    (void)geometric_eff;
+}
+
+static void test_enforce_outcome() {
+    ase::Dependencies<double,double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, &project_clamp
+    };
+
+    // Scale: pass-through / scaled after 4 attempts / neutral
+    {
+        ase::Engine<double,double> eng({ase::Mode::Scale, 16, 0.5}, deps);
+
+        const ase::EnforceOutcome<double> pass = eng.enforce_outcome(0.0, 0.2);
+        assert(pass.kind == ase::Outcome::PassThrough);
+        assert(pass.step == 0.2 && pass.k == 1.0 && pass.attempts == 0);
+
+        const ase::EnforceOutcome<double> scaled = eng.enforce_outcome(0.9, 0.5);
+        assert(scaled.kind == ase::Outcome::Scaled);
+        assert(scaled.step == 0.0625 && scaled.k == 0.125 && scaled.attempts == 4);
+
+        const ase::EnforceOutcome<double> neutral =
+            eng.enforce_outcome(0.0, std::numeric_limits<double>::infinity());
+        assert(neutral.kind == ase::Outcome::Neutral);
+        assert(neutral.step == 0.0 && neutral.k == 0.0);
+
+        // Same record alongside caller storage
+        ase::Scratch<double> scratch;
+        ase::Decision d;
+        double out = 0.0;
+        const bool derived = eng.enforce_into(0.9, 0.5, out, scratch, d);
+        assert(derived && out == scaled.step && d.kind == ase::Outcome::Scaled);
+        assert(d.k == scaled.k && d.attempts == scaled.attempts);
+        (void)derived;
+
+        // Batch records
+        const double S[3]  = {0.0, 0.9, 0.0};
+        const double dS[3] = {0.2, 0.5, std::numeric_limits<double>::quiet_NaN()};
+        double batch[3];
+        ase::Decision ds[3];
+        eng.enforce_batch(S, dS, batch, 3, ds);
+        assert(ds[0].kind == ase::Outcome::PassThrough);
+        assert(ds[1].kind == ase::Outcome::Scaled && ds[1].k == 0.125);
+        assert(ds[2].kind == ase::Outcome::Neutral);
+        (void)pass;
+        (void)scaled;
+        (void)neutral;
+        (void)ds;
+    }
+
+    // Bisection reports the accepted k
+    {
+        ase::Engine<double,double> eng({ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection, 1e-3}, deps);
+        const ase::EnforceOutcome<double> r = eng.enforce_outcome(0.9, 0.5);
+        assert(r.kind == ase::Outcome::Scaled);
+        assert(r.step == r.k * 0.5);
+        (void)r;
+    }
+
+    // Project / Reject
+    {
+        ase::Engine<double,double> proj({ase::Mode::Project}, deps);
+        const ase::EnforceOutcome<double> p = proj.enforce_outcome(0.9, 0.5);
+        assert(p.kind == ase::Outcome::Projected && p.k == 1.0 && p.attempts == 0);
+
+        ase::Engine<double,double> rej({ase::Mode::Reject}, deps);
+        const ase::EnforceOutcome<double> r = rej.enforce_outcome(0.9, 0.5);
+        assert(r.kind == ase::Outcome::Neutral && r.step == 0.0);
+        (void)p;
+        (void)r;
+    }
+}
+
+static int g_scale_calls = 0;
+
+static bool scale_mul_counted(const double& in, double k, double& out) {
+    ++g_scale_calls;
+    return scale_mul(in, k, out);
+}
+
+// k·base evaluated without building the step (same arithmetic as scale_mul)
+static bool admissible_limit_scaled(const double& S, const double& base, double k) {
+    return admissible_limit(S, base * k);
+}
+
+static bool admissible_scaled_lies(const double&, const double&, double) {
+    return true;
+}
+
+static bool admissible_scaled_throws(const double&, const double&, double) {
+    throw 1;
+}
+
+static void test_lazy_scaled_admissibility() {
+    const ase::Config cfgs[] = {
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 3, 0.5},
+        {ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+    };
+    const double inputs[] = {-2.0, -0.9, -0.5, 0.0, 0.3, 0.9, 1.5, 1e300,
+                             std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::quiet_NaN()};
+
+    for (const ase::Config& cfg : cfgs) {
+        for (bool solver : {false, true}) {
+            ase::Dependencies<double,double> deps{&admissible_limit, &neutral_zero, &scale_mul_counted, nullptr};
+            if (solver) deps.solve_scale = &solve_limit;
+            ase::Engine<double,double> eager(cfg, deps);
+
+            deps.is_admissible_scaled = &admissible_limit_scaled;
+            ase::Engine<double,double> lazy(cfg, deps);
+
+            for (double S : inputs) {
+                for (double dS : inputs) {
+                    const ase::EnforceOutcome<double> a = eager.enforce_outcome(S, dS);
+
+                    g_scale_calls = 0;
+                    const ase::EnforceOutcome<double> b = lazy.enforce_outcome(S, dS);
+                    assert(g_scale_calls <= 1); // only the accepted k is built
+
+                    const bool same_step = (a.step == b.step) || (std::isnan(a.step) && std::isnan(b.step));
+                    assert(same_step && a.kind == b.kind && a.k == b.k);
+                    // scale_step failing (non-finite dS) ends the eager search at
+                    // once; the lazy search only sees inadmissible candidates
+                    assert(a.attempts == b.attempts || !is_finite(dS));
+                    (void)same_step;
+                }
+            }
+        }
+    }
+
+    // Hook disagreeing with the built step => neutral, not an inadmissible step
+    ase::Dependencies<double,double> deps{&admissible_limit, &neutral_zero, &scale_mul, nullptr};
+    deps.is_admissible_scaled = &admissible_scaled_lies;
+    ase::Engine<double,double> lying({ase::Mode::Scale, 16, 0.5}, deps);
+    const double lied = lying.enforce(0.9, 5.0);
+    assert(lied == 0.0);
+    (void)lied;
+    const double pass = lying.enforce(0.0, 0.2);
+    assert(pass == 0.2); // pass-through uses the regular predicate
+    (void)pass;
+
+    deps.is_admissible_scaled = &admissible_scaled_throws;
+    ase::Engine<double,double> throwing({ase::Mode::Scale, 16, 0.5}, deps);
+    const double thrown = throwing.enforce(0.9, 0.5);
+    assert(thrown == 0.0);
+    (void)thrown;
+
+    // Still requires scale_step to materialize
+    deps.is_admissible_scaled = &admissible_limit_scaled;
+    deps.scale_step = nullptr;
+    ase::Engine<double,double> no_scale({ase::Mode::Scale, 16, 0.5}, deps);
+    const double unscaled = no_scale.enforce(0.9, 0.5);
+    assert(unscaled == 0.0);
+    (void)unscaled;
+}
+
+static void test_scale_hint() {
+    const ase::Config geo{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double,double> deps{&admissible_limit, &neutral_zero, &scale_mul, nullptr};
+    ase::Engine<double,double> eng(geo, deps);
+
+    // Unusable hints => exactly the cold search
+    for (double h : {1.0, 2.0, 0.0, -0.5, std::numeric_limits<double>::quiet_NaN()}) {
+        const ase::EnforceOutcome<double> cold = eng.enforce_outcome(0.9, 0.5);
+        const ase::EnforceOutcome<double> warm = eng.enforce_outcome(0.9, 0.5, ase::ScaleHint{h});
+        assert(warm.step == cold.step && warm.k == cold.k && warm.attempts == cold.attempts);
+        (void)cold;
+        (void)warm;
+    }
+
+    // Monotone predicate: same grid k as the cold search for any hint,
+    // never more than max_scale_attempts candidates
+    const double Ss[] = {0.0, 0.5, 0.9, 0.99, -0.7};
+    const double dSs[] = {0.05, 0.5, 1.7, 5.0, -40.0, 1e6};
+    const double hints[] = {0.9, 0.5, 0.3, 0.125, 0.01, 1e-6, 1e-300};
+    for (double S : Ss) {
+        for (double dS : dSs) {
+            const ase::EnforceOutcome<double> cold = eng.enforce_outcome(S, dS);
+            for (double h : hints) {
+                const ase::EnforceOutcome<double> warm = eng.enforce_outcome(S, dS, ase::ScaleHint{h});
+                assert(warm.kind == cold.kind && warm.step == cold.step && warm.k == cold.k);
+                assert(warm.attempts <= geo.max_scale_attempts);
+                const double again = eng.enforce(S, dS, ase::ScaleHint{h});
+                assert(again == warm.step); // deterministic
+                (void)again;
+                (void)warm;
+            }
+            (void)cold;
+        }
+    }
+
+    // Steady state after a spike: hinting the last k saves attempts
+    const std::size_t cold_attempts = eng.enforce_outcome(0.9, 0.5).attempts;
+    assert(cold_attempts == 4); // k = 1, .5, .25, .125
+    (void)cold_attempts;
+    const std::size_t warm_attempts = eng.enforce_outcome(0.9, 0.5, ase::ScaleHint{0.125}).attempts;
+    assert(warm_attempts == 2); // .125, then .25 fails
+    (void)warm_attempts;
+    const double climbed = eng.enforce_outcome(0.0, 1.5, ase::ScaleHint{0.125}).k;
+    assert(climbed == 0.5); // climbs back up
+    (void)climbed;
+
+    // Bounded attempts close to the cold range limit
+    ase::Engine<double,double> short_eng({ase::Mode::Scale, 3, 0.5}, deps);
+    const double short_cold = short_eng.enforce(0.9, 0.5);
+    assert(short_cold == 0.0);
+    (void)short_cold;
+    const double short_warm = short_eng.enforce(0.9, 0.5, ase::ScaleHint{0.125});
+    assert(short_warm == 0.0); // k = .25 is the smallest cold k
+    (void)short_warm;
+    const std::size_t short_attempts = short_eng.enforce_outcome(0.9, 0.5, ase::ScaleHint{1e-3}).attempts;
+    assert(short_attempts <= 3);
+    (void)short_attempts;
+
+    // Bisection: the hint is probed first; result admissible and deterministic
+    ase::Engine<double,double> bis({ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4}, deps);
+    for (double h : hints) {
+        const ase::EnforceOutcome<double> r = bis.enforce_outcome(0.9, 0.5, ase::ScaleHint{h});
+        assert(r.kind == ase::Outcome::Scaled && admissible_limit(0.9, r.step));
+        const double again = bis.enforce(0.9, 0.5, ase::ScaleHint{h});
+        assert(r.attempts <= 20 && again == r.step);
+        (void)r;
+        (void)again;
+    }
+    const double exact = bis.enforce_outcome(0.9, 0.5, ase::ScaleHint{0.2}).k;
+    assert(exact == 0.2); // exact hint accepted
+    (void)exact;
+
+    // Lazy scaled path and batches honor the hint the same way
+    ase::Dependencies<double,double> lazy_deps = deps;
+    lazy_deps.is_admissible_scaled = &admissible_limit_scaled;
+    ase::Engine<double,double> lazy(geo, lazy_deps);
+
+    double S[6], dS[6], out[6];
+    ase::ScaleHint h6[6];
+    for (int i = 0; i < 6; ++i) {
+        S[i] = Ss[i % 5];
+        dS[i] = dSs[i];
+        h6[i] = ase::ScaleHint{hints[i]};
+    }
+    eng.enforce_batch(S, dS, out, 6, nullptr, h6);
+    for (int i = 0; i < 6; ++i) {
+        const ase::EnforceOutcome<double> a = eng.enforce_outcome(S[i], dS[i], h6[i]);
+        const ase::EnforceOutcome<double> b = lazy.enforce_outcome(S[i], dS[i], h6[i]);
+        assert(out[i] == a.step && b.step == a.step && b.k == a.k && b.attempts == a.attempts);
+        (void)a;
+        (void)b;
+    }
+}
+
+static int g_stage_calls[3] = {0, 0, 0};
+
+static bool stage_finite(const double& S, const double& dS) {
+    ++g_stage_calls[0];
+    return is_finite(S) && is_finite(dS);
+}
+
+static bool stage_step_bound(const double&, const double& dS) {
+    ++g_stage_calls[1];
+    return std::fabs(dS) <= 2.0;
+}
+
+static bool stage_limit(const double& S, const double& dS) {
+    ++g_stage_calls[2];
+    return admissible_limit(S, dS);
+}
+
+static bool stage_quarter_step(const double&, const double& dS) {
+    return std::fabs(dS) <= 0.25;
+}
+
+static bool stage_throws(const double&, const double& dS) {
+    if (dS > 0.7) throw 1;
+    return true;
+}
+
+static bool admissible_all_stages(const double& S, const double& dS) {
+    return is_finite(S) && is_finite(dS) && std::fabs(dS) <= 2.0 && admissible_limit(S, dS);
+}
+
+static void reset_stage_calls() {
+    g_stage_calls[0] = g_stage_calls[1] = g_stage_calls[2] = 0;
+}
+
+static void test_admissibility_stages() {
+    // Listed out of cost order on purpose: the engine runs cheapest first
+    const ase::AdmissibilityStage<double, double> stages[] = {
+        {&stage_limit, 10.0, false},
+        {&stage_finite, 0.1, true},
+        {&stage_step_bound, 0.5, true},
+    };
+
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+        {ase::Mode::Project},
+    };
+    const double inputs[] = {-3.0, -0.9, -0.2, 0.0, 0.4, 0.9, 1.9, 2.5, 1e300,
+                             std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::quiet_NaN()};
+
+    // Same outcome as one predicate doing all checks
+    for (const ase::Config& cfg : cfgs) {
+        ase::Dependencies<double,double> deps{nullptr, &neutral_zero, &scale_mul, &project_clamp};
+        deps.stages = stages;
+        deps.stage_count = 3;
+        ase::Engine<double,double> staged(cfg, deps);
+        ase::Engine<double,double> plain(cfg, {&admissible_all_stages, &neutral_zero, &scale_mul, &project_clamp});
+
+        double S[121], dS[121], out[121];
+        std::size_t n = 0;
+        for (double a : inputs) {
+            for (double b : inputs) {
+                const ase::EnforceOutcome<double> x = staged.enforce_outcome(a, b);
+                const ase::EnforceOutcome<double> y = plain.enforce_outcome(a, b);
+                const bool same_step = (x.step == y.step) || (std::isnan(x.step) && std::isnan(y.step));
+                assert(same_step && x.kind == y.kind && x.k == y.k && x.attempts == y.attempts);
+                (void)same_step;
+                S[n] = a;
+                dS[n] = b;
+                ++n;
+            }
+        }
+
+        staged.enforce_batch(S, dS, out, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double e = plain.enforce(S[i], dS[i]);
+            assert(out[i] == e || (std::isnan(out[i]) && std::isnan(e)));
+            (void)e;
+        }
+    }
+
+    ase::Dependencies<double,double> deps{nullptr, &neutral_zero, &scale_mul, &project_clamp};
+    deps.stages = stages;
+    deps.stage_count = 3;
+
+    // Stops at the first failing stage
+    ase::Engine<double,double> reject({ase::Mode::Reject}, deps);
+    reset_stage_calls();
+    const double rejected = reject.enforce(0.0, std::numeric_limits<double>::quiet_NaN());
+    assert(rejected == 0.0);
+    (void)rejected;
+    assert(g_stage_calls[0] == 1 && g_stage_calls[1] == 0 && g_stage_calls[2] == 0);
+
+    // Scale: monotone stages held at k = 1 are not re-run for k < 1
+    ase::Engine<double,double> scale({ase::Mode::Scale, 16, 0.5}, deps);
+    reset_stage_calls();
+    const double scaled = scale.enforce(0.9, 0.5);
+    assert(scaled == 0.0625); // proposal + k = 1, .5, .25, .125
+    (void)scaled;
+    assert(g_stage_calls[0] == 1 && g_stage_calls[1] == 1 && g_stage_calls[2] == 5);
+
+    // step bound fails at k = 1 (|dS| = 3), holds from k = .5 on, then skipped
+    const ase::EnforceOutcome<double> r = scale.enforce_outcome(0.0, 3.0);
+    assert(r.kind == ase::Outcome::Scaled && r.step == 0.75);
+    reset_stage_calls();
+    scale.enforce(0.0, 3.0);
+    assert(g_stage_calls[1] == 3); // proposal, k = 1 (fail), k = .5 (holds); k = .25 skipped
+    assert(g_stage_calls[2] == 2); // k = .5 (1.5 > 1), k = .25
+    (void)r;
+
+    // Bisection: only probes above the largest held k re-run a monotone stage
+    ase::Engine<double,double> bis({ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4}, deps);
+    reset_stage_calls();
+    const double b = bis.enforce(0.0, 3.0);
+    assert(admissible_all_stages(0.0, b) && b > 0.99);
+    assert(g_stage_calls[0] == 1);
+    assert(g_stage_calls[1] == 2); // proposal, first probe k = .5; later probes are all below
+    (void)b;
+
+    // Project candidate is not a scaled proposal: every stage runs again
+    ase::Engine<double,double> proj({ase::Mode::Project}, deps);
+    reset_stage_calls();
+    const double projected = proj.enforce(0.5, 1.0);
+    assert(projected == 0.5);
+    (void)projected;
+    assert(g_stage_calls[0] == 2 && g_stage_calls[1] == 2 && g_stage_calls[2] == 2);
+
+    // Regular predicate runs after all stages
+    deps.is_admissible = &admissible_counted;
+    ase::Engine<double,double> both({ase::Mode::Reject}, deps);
+    g_eval_calls = 0;
+    const double inf = both.enforce(0.0, std::numeric_limits<double>::infinity());
+    assert(inf == 0.0);
+    (void)inf;
+    assert(g_eval_calls == 0);
+    const double pass = both.enforce(0.0, 0.5);
+    assert(pass == 0.5);
+    (void)pass;
+    assert(g_eval_calls == 1);
+    deps.is_admissible = nullptr;
+
+    // A batch hook answering is_admissible alone: the stages still gate the
+    // pass-through, so enforce_batch matches enforce
+    const ase::AdmissibilityStage<double, double> quarter[] = {{&stage_quarter_step, 1.0, true}};
+    ase::Dependencies<double,double> qdeps{&admissible_limit, &neutral_zero, &scale_mul, &project_clamp};
+    qdeps.stages = quarter;
+    qdeps.stage_count = 1;
+    qdeps.is_admissible_batch = &admissible_limit_batch;
+    for (const ase::Config& cfg : cfgs) {
+        const ase::Engine<double,double> eng(cfg, qdeps);
+        const double qS[3] = {0.0, 0.2, 0.9};
+        const double qdS[3] = {0.5, 0.1, -0.75};
+        double qout[3];
+        ase::Decision qd[3];
+        eng.enforce_batch(qS, qdS, qout, 3, qd);
+        for (std::size_t i = 0; i < 3; ++i) {
+            const ase::EnforceOutcome<double> ref = eng.enforce_outcome(qS[i], qdS[i]);
+            assert(qout[i] == ref.step && qd[i].kind == ref.kind && qd[i].k == ref.k);
+            assert(qd[i].attempts == ref.attempts);
+            (void)ref;
+        }
+        assert(qd[0].kind != ase::Outcome::PassThrough); // stage rejects 0.5
+        (void)qd;
+    }
+
+    // Throwing stage => neutral
+    const ase::AdmissibilityStage<double, double> throwing[] = {{&stage_throws, 1.0, true}};
+    ase::Dependencies<double,double> tdeps{nullptr, &neutral_zero, &scale_mul, nullptr};
+    tdeps.stages = throwing;
+    tdeps.stage_count = 1;
+    ase::Engine<double,double> thr({ase::Mode::Scale, 16, 0.5}, tdeps);
+    const double thrown = thr.enforce(0.0, 0.9);
+    assert(thrown == 0.0);
+    (void)thrown;
+    const double thr_pass = thr.enforce(0.0, 0.5);
+    assert(thr_pass == 0.5);
+    (void)thr_pass;
+
+    // Malformed stage lists fail closed
+    const ase::Config rej{ase::Mode::Reject};
+    ase::Dependencies<double,double> bad = deps;
+    bad.stage_count = ase::kMaxAdmissibilityStages + 1;
+    const ase::Engine<double,double> too_many(rej, bad);
+    const double long_list = too_many.enforce(0.0, 0.1);
+    assert(long_list == 0.0);
+    (void)long_list;
+
+    const ase::AdmissibilityStage<double, double> null_check[] = {{&stage_finite, 1.0, true}, {nullptr, 2.0, false}};
+    bad.stages = null_check;
+    bad.stage_count = 2;
+    const ase::Engine<double,double> null_stage(rej, bad);
+    const double null_entry = null_stage.enforce(0.0, 0.1);
+    assert(null_entry == 0.0);
+    (void)null_entry;
+
+    bad.stages = nullptr;
+    bad.stage_count = 1;
+    const ase::Engine<double,double> null_list(rej, bad);
+    const double null_stages = null_list.enforce(0.0, 0.1);
+    assert(null_stages == 0.0);
+    (void)null_stages;
+}
+
+static int g_neutral_calls = 0;
+
+static Vec neutral_vec_counted() {
+    ++g_neutral_calls;
+    return Vec(3, 0.0);
+}
+
+static Vec neutral_vec_throws() { throw 1; }
+
+static void test_cached_neutral() {
+    g_neutral_calls = 0;
+    const ase::Dependencies<Vec,Vec> deps{&admissible_vec, &neutral_vec_counted, &scale_vec, nullptr};
+    const ase::Engine<Vec,Vec> eng({ase::Mode::Reject}, deps);
+    assert(g_neutral_calls == 1);
+    assert(eng.neutral() == Vec(3, 0.0));
+
+    // Every fail-closed path emits the cached step; the hook is not re-run
+    const Vec S = {0.9, 0.0, -0.5};
+    const Vec bad = {0.5, 0.1, -0.2};
+    const ase::EnforceOutcome<Vec> r = eng.enforce_outcome(S, bad);
+    assert(r.is_neutral() && r.step == eng.neutral());
+
+    ase::Scratch<Vec> scratch;
+    Vec out(3, 7.0);
+    const double* buf = out.data();
+    ase::Decision d;
+    const bool derived = eng.enforce_into(S, bad, out, scratch, d);
+    assert(!derived && d.is_neutral() && out == eng.neutral());
+    assert(out.data() == buf); // assigned in place, capacity reused
+
+    Vec batch_out[2];
+    const Vec batch_S[2] = {S, S};
+    const Vec batch_dS[2] = {bad, Vec(3, 0.0)};
+    ase::Decision ds[2];
+    eng.enforce_batch(batch_S, batch_dS, batch_out, 2, ds);
+    assert(ds[0].is_neutral() && !ds[1].is_neutral());
+    const Vec neutral = eng.enforce(S, bad);
+    assert(neutral == eng.neutral());
+    assert(g_neutral_calls == 1);
+
+    // Missing or throwing neutral_step => Step{}, every call fails closed
+    const ase::Engine<Vec,Vec> missing({ase::Mode::Reject}, {&admissible_vec, nullptr, nullptr, nullptr});
+    const Vec none = missing.enforce(S, Vec(3, 0.0));
+    assert(missing.neutral().empty() && none.empty());
+
+    const ase::Engine<Vec,Vec> throwing({ase::Mode::Reject}, {&admissible_vec, &neutral_vec_throws, nullptr, nullptr});
+    const ase::EnforceOutcome<Vec> t = throwing.enforce_outcome(S, Vec(3, 0.0));
+    assert(t.is_neutral() && t.step.empty());
+    (void)r;
+    (void)buf;
+    (void)derived;
+    (void)neutral;
+    (void)none;
+    (void)t;
+}
+
+// Candidates hook over the plain predicate (a real one would spread the
+// candidates over a thread team or SIMD lanes)
+static int g_candidate_calls = 0;
+
+static bool admissible_candidates(const double& S, const double* dS, bool* out, std::size_t n) {
+    ++g_candidate_calls;
+    for (std::size_t i = 0; i < n; ++i) out[i] = admissible_limit(S, dS[i]);
+    return true;
+}
+
+static bool candidates_fail(const double&, const double*, bool*, std::size_t) {
+    return false;
+}
+
+static bool scale_mul_large_k(const double& in, double k, double& out) {
+    if (k < 0.1) return false;
+    return scale_mul(in, k, out);
+}
+
+static void test_speculative_scale() {
+    ase::Dependencies<double,double> deps{&admissible_limit, &neutral_zero, &scale_mul, nullptr};
+    ase::Dependencies<double,double> spec_deps = deps;
+    spec_deps.is_admissible_candidates = &admissible_candidates;
+
+    for (std::size_t attempts : {std::size_t{4}, std::size_t{16}, std::size_t{40}}) {
+        const ase::Config seq_cfg{ase::Mode::Scale, attempts, 0.5};
+        ase::Config spec_cfg = seq_cfg;
+        spec_cfg.speculative_scale = true;
+        const ase::Engine<double,double> seq(seq_cfg, deps);
+        const ase::Engine<double,double> spec(spec_cfg, spec_deps);
+
+        // Same step and k, bit for bit; candidates are built a chunk at a time
+        for (double dS : {0.05, 0.5, 3.0, -7.0, 1e5, 1e7, 1e30}) {
+            const ase::EnforceOutcome<double> a = seq.enforce_outcome(0.9, dS);
+            g_candidate_calls = 0;
+            const ase::EnforceOutcome<double> b = spec.enforce_outcome(0.9, dS);
+            assert(a.step == b.step && a.kind == b.kind && a.k == b.k);
+            if (a.kind == ase::Outcome::Scaled) {
+                const std::size_t chunks = (a.attempts + ase::kSpeculativeChunk - 1) / ase::kSpeculativeChunk;
+                const std::size_t built = std::min(attempts, chunks * ase::kSpeculativeChunk);
+                assert(b.attempts == built && g_candidate_calls == static_cast<int>(chunks));
+                (void)built;
+            }
+            (void)b;
+        }
+
+        // A warm start keeps the sequential search
+        const ase::EnforceOutcome<double> warm = spec.enforce_outcome(0.9, 3.0, {0.1});
+        const ase::EnforceOutcome<double> warm_seq = seq.enforce_outcome(0.9, 3.0, {0.1});
+        assert(warm.attempts == warm_seq.attempts);
+        (void)warm;
+        (void)warm_seq;
+    }
+
+    // A transform failure ends the search where the sequential one would
+    ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    cfg.speculative_scale = true;
+    deps.scale_step = &scale_mul_large_k;
+    spec_deps.scale_step = &scale_mul_large_k;
+    const ase::Engine<double,double> seq_fail({ase::Mode::Scale, 16, 0.5}, deps);
+    const ase::Engine<double,double> spec_fail(cfg, spec_deps);
+    for (double dS : {0.5, 0.8, 3.0}) {
+        const double x = seq_fail.enforce(0.9, dS);
+        const double y = spec_fail.enforce(0.9, dS);
+        assert(x == y);
+        (void)x;
+        (void)y;
+    }
+    const ase::EnforceOutcome<double> failed = spec_fail.enforce_outcome(0.9, 3.0);
+    assert(failed.is_neutral());
+    (void)failed;
+
+    // A failing candidates hook fails closed
+    spec_deps.scale_step = &scale_mul;
+    spec_deps.is_admissible_candidates = &candidates_fail;
+    const ase::Engine<double,double> broken(cfg, spec_deps);
+    const ase::EnforceOutcome<double> closed = broken.enforce_outcome(0.9, 0.5);
+    const double pass = broken.enforce(0.0, 0.2);
+    assert(closed.is_neutral());
+    assert(pass == 0.2); // pass-through never needs it
+    (void)closed;
+    (void)pass;
+}
+
+// Elementwise |S + dS[i]| <= 1 over Steps of N doubles (stack budget of the
+// speculative search)
+template <std::size_t N>
+static bool admissible_arr(const double& S, const std::array<double, N>& dS) {
+    for (double d : dS) {
+        if (!admissible_limit(S, d)) return false;
+    }
+    return true;
+}
+
+template <std::size_t N>
+static std::array<double, N> neutral_arr() { return {}; }
+
+template <std::size_t N>
+static bool scale_arr(const std::array<double, N>& in, double k, std::array<double, N>& out) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!scale_mul(in[i], k, out[i])) return false;
+    }
+    return true;
+}
+
+template <std::size_t N>
+static bool admissible_arr_candidates(const double& S, const std::array<double, N>* dS, bool* out, std::size_t n) {
+    ++g_candidate_calls;
+    for (std::size_t i = 0; i < n; ++i) out[i] = admissible_arr<N>(S, dS[i]);
+    return true;
+}
+
+template <std::size_t N>
+static void check_speculative_chunk(std::size_t expected_chunk) {
+    using Arr = std::array<double, N>;
+    static_assert(ase::speculative_chunk<Arr>() * sizeof(Arr) <= ase::kSpeculativeStackBytes, "stack budget");
+    assert(ase::speculative_chunk<Arr>() == expected_chunk);
+
+    ase::Dependencies<double,Arr> deps{&admissible_arr<N>, &neutral_arr<N>, &scale_arr<N>, nullptr};
+    const ase::Engine<double,Arr> seq({ase::Mode::Scale, 16, 0.5}, deps);
+    deps.is_admissible_candidates = &admissible_arr_candidates<N>;
+    ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    cfg.speculative_scale = true;
+    const ase::Engine<double,Arr> spec(cfg, deps);
+
+    Arr dS{};
+    dS.fill(0.5);
+    dS[N - 1] = 3.0; // k = 1/32, the 6th candidate
+    g_candidate_calls = 0;
+    const ase::EnforceOutcome<Arr> a = seq.enforce_outcome(0.9, dS);
+    const ase::EnforceOutcome<Arr> b = spec.enforce_outcome(0.9, dS);
+    assert(a.kind == ase::Outcome::Scaled && a.step == b.step && a.k == b.k);
+    if (expected_chunk >= 2) {
+        const std::size_t chunks = (a.attempts + expected_chunk - 1) / expected_chunk;
+        assert(g_candidate_calls == static_cast<int>(chunks) && b.attempts == chunks * expected_chunk);
+        (void)chunks;
+    } else {
+        // Sequential fallback: the candidates hook is never called
+        assert(g_candidate_calls == 0 && b.attempts == a.attempts);
+    }
+    (void)a;
+    (void)b;
+}
+
+static void test_speculative_stack_budget() {
+    check_speculative_chunk<1>(ase::kSpeculativeChunk);
+    check_speculative_chunk<64>(8);   // 512-byte Step
+    check_speculative_chunk<256>(2);  // 2 KiB
+    check_speculative_chunk<1024>(0); // 8 KiB: sequential search
+}
+
+// Clamp with a certificate unless g_certify is off (the rounding of S + out
+// is re-checked, as a real kernel would)
+static bool g_certify = true;
+
+static bool project_clamp_certified(const double& S, const double& dS, double& out, bool& certified) {
+    if (!project_clamp(S, dS, out)) return false;
+    certified = g_certify && admissible_limit(S, out);
+    return true;
+}
+
+static bool project_to_outside(const double& S, const double&, double& out, bool& certified) {
+    out = 2.0 - S;     // lands on 2: inadmissible
+    certified = false; // an honest kernel does not certify it
+    return true;
+}
+
+static void test_certified_projection() {
+    ase::Dependencies<double,double> deps{&admissible_counted, &neutral_zero, nullptr, nullptr};
+    deps.project_step_certified = &project_clamp_certified;
+    const ase::Engine<double,double> eng({ase::Mode::Project}, deps);
+    const ase::Engine<double,double> ref({ase::Mode::Project},
+                                         {&admissible_limit, &neutral_zero, nullptr, &project_clamp});
+
+    for (double dS : {0.05, 0.5, 3.0, -7.0, std::numeric_limits<double>::quiet_NaN()}) {
+        for (bool certify : {true, false}) {
+            g_certify = certify;
+            g_eval_calls = 0;
+            const ase::EnforceOutcome<double> r = eng.enforce_outcome(0.9, dS);
+            const ase::EnforceOutcome<double> e = ref.enforce_outcome(0.9, dS);
+            assert(r.step == e.step && r.kind == e.kind);
+            // certified: the proposal is the only evaluation
+            const int expected = (r.kind == ase::Outcome::Projected && !certify) ? 2 : 1;
+            assert(g_eval_calls == expected);
+            (void)r;
+            (void)e;
+            (void)expected;
+        }
+    }
+
+    // Uncertified output is still checked: inadmissible => neutral
+    deps.project_step_certified = &project_to_outside;
+    deps.project_step = &project_clamp; // ignored when the certified hook is set
+    const ase::Engine<double,double> outside({ase::Mode::Project}, deps);
+    const ase::EnforceOutcome<double> rejected = outside.enforce_outcome(0.9, 3.0);
+    assert(rejected.is_neutral());
+    (void)rejected;
+
+    // Asynchronous: a certified projection needs no verdict for it
+    g_certify = true;
+    deps.project_step_certified = &project_clamp_certified;
+    const ase::Engine<double,double> async_eng({ase::Mode::Project}, deps);
+    ase::AsyncEnforcement<double,double> op;
+    async_eng.enforce_async(0.9, 3.0, op);
+    assert(!op.done());
+    async_eng.resume(op, ase::Verdict::Inadmissible); // the proposal
+    const double projected = ref.enforce(0.9, 3.0);
+    assert(op.done() && op.step() == projected && op.decision().kind == ase::Outcome::Projected);
+    (void)projected;
+    g_certify = false;
+    async_eng.enforce_async(0.9, 3.0, op);
+    async_eng.resume(op, ase::Verdict::Inadmissible);
+    assert(!op.done());
+    async_eng.resume(op, ase::Verdict::Admissible);
+    assert(op.done() && op.decision().kind == ase::Outcome::Projected);
+    g_certify = true;
+}
+
 int main() {
     test_pass_through();
     test_reject_to_neutral();
@@ -179,5 +1365,19 @@ int main() {
     test_nan_inf_fail_closed();
     test_determinism();
     test_project();
+    test_batch_matches_scalar();
+    test_batch_fail_closed();
+    test_enforce_into_matches_enforce();
+    test_scale_bisection();
+    test_split_phase_context();
+    test_solve_scale();
+    test_enforce_outcome();
+    test_lazy_scaled_admissibility();
+    test_scale_hint();
+    test_admissibility_stages();
+    test_cached_neutral();
+    test_speculative_scale();
+    test_speculative_stack_budget();
+    test_certified_projection();
     return 0;
 }
@@ -0,0 +1,183 @@
+// tests/test_device.cpp
+// Device enforcement (reference HostBackend): the fused summary follows the
+// documented fixed reduction tree bit for bit, DeviceEnforcer makes the same
+// decision as Engine over views with the same envelope (kind, k, attempts,
+// warm starts), rewrites ΔS in place to exactly the engine's step, and its
+// projection / neutral outputs are admissible.
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/device.hpp"
+#include "ase/views.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+using Vec = std::vector<double>;
+
+// Recursive statement of the documented order: groups of 256 slots,
+// halving strides, then the same over the group results
+static double ref_tree_sum(Vec level) {
+    if (level.empty()) return 0.0;
+    while (level.size() > 1) {
+        Vec next;
+        for (std::size_t g = 0; g < level.size(); g += 256) {
+            double slot[256];
+            for (std::size_t t = 0; t < 256; ++t) slot[t] = (g + t < level.size()) ? level[g + t] : 0.0;
+            for (std::size_t stride = 128; stride > 0; stride /= 2) {
+                for (std::size_t j = 0; j < stride; ++j) slot[j] = slot[j] + slot[j + stride];
+            }
+            next.push_back(slot[0]);
+        }
+        level = next;
+    }
+    return level[0];
+}
+
+static void test_reduction_order() {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    ase::HostBackend backend;
+    const ase::vec::BlockLimits lim;
+
+    for (std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{255}, std::size_t{256},
+                          std::size_t{257}, std::size_t{70000}}) {
+        Vec S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = u(rng);
+            dS[i] = u(rng);
+        }
+        const double k = 0.3;
+
+        Vec next_sq(n), cross(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double d = k * dS[i];
+            const double x = S[i] + d;
+            next_sq[i] = x * x;
+            cross[i] = S[i] * d;
+        }
+
+        ase::device::Summary s;
+        REQUIRE(backend.summarize(S.data(), dS.data(), k, n, lim, s));
+        REQUIRE(same_bits(s.next_sq, ref_tree_sum(next_sq)));
+        REQUIRE(same_bits(s.cross, ref_tree_sum(cross)));
+        REQUIRE(n == 0 || s.violation < 0.0);
+    }
+}
+
+static ase::vec::BlockLimits g_lim;
+
+// Engine hooks computing the verdict from the same fused summary
+static bool admissible_view(const ase::StateView& S, const ase::ScaledStepView& dS) {
+    if (dS.is_zero()) {
+        const Vec zero(S.size, 0.0);
+        return admissible_view(S, ase::ScaledStepView::of({zero.data(), S.size}));
+    }
+    ase::HostBackend b;
+    ase::device::Summary s;
+    return dS.size == S.size && b.summarize(S.data, dS.base, dS.k, S.size, g_lim, s) && ase::device::admits(s, g_lim);
+}
+
+static bool admissible_scaled(const ase::StateView& S, const ase::ScaledStepView& base, double k) {
+    return admissible_view(S, ase::ScaledStepView{base.base, base.size, base.k * k});
+}
+
+static void test_matches_engine() {
+    const std::size_t n = 3000;
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.step_linf = 0.05;
+    g_lim.sign_prefix = 16;
+
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+    };
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (const ase::Config& cfg : cfgs) {
+        ase::Dependencies<ase::StateView, ase::ScaledStepView> deps{
+            &admissible_view, &ase::neutral_view, &ase::scale_view, nullptr};
+        deps.is_admissible_scaled = &admissible_scaled;
+        const ase::Engine<ase::StateView, ase::ScaledStepView> eng(cfg, deps);
+        ase::DeviceEnforcer<ase::HostBackend> dev(cfg, g_lim);
+
+        ase::ScaleHint hint;
+        for (int trial = 0; trial < 150; ++trial) {
+            Vec S(n), dS(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                S[i] = 0.01 * u(rng) + 0.01;
+                dS[i] = ((trial % 3) ? 0.1 : 0.01) * u(rng);
+            }
+            if (trial % 23 == 0) dS[trial % n] = std::numeric_limits<double>::quiet_NaN();
+
+            const ase::EnforceOutcome<ase::ScaledStepView> ref =
+                eng.enforce_outcome({S.data(), n}, ase::ScaledStepView::of({dS.data(), n}), hint);
+            Vec expected(n);
+            REQUIRE(ase::materialize(ref.step, expected.data(), n));
+
+            Vec buf = dS; // stands in for the device buffer
+            const ase::Decision d = dev.enforce(S.data(), buf.data(), n, hint);
+            REQUIRE(d.kind == ref.kind && d.k == ref.k && d.attempts == ref.attempts);
+            REQUIRE(buf == expected);
+
+            hint.k = (d.kind == ase::Outcome::Scaled) ? d.k : 1.0;
+        }
+    }
+}
+
+static void test_project() {
+    const std::size_t n = 2000;
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.linf = 0.1;
+    g_lim.step_linf = 0.08;
+    g_lim.sign_prefix = 32;
+
+    ase::DeviceEnforcer<ase::HostBackend> dev({ase::Mode::Project}, g_lim);
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    int projected = 0;
+    for (int trial = 0; trial < 100; ++trial) {
+        Vec S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = 0.01 * u(rng) + 0.01;
+            dS[i] = 0.2 * u(rng);
+        }
+        if (trial == 7) dS[5] = std::numeric_limits<double>::infinity();
+
+        Vec buf = dS;
+        const ase::Decision d = dev.enforce(S.data(), buf.data(), n);
+        REQUIRE(d.kind == ase::Outcome::Projected || d.kind == ase::Outcome::Neutral);
+        REQUIRE(trial != 7 || d.is_neutral());
+        if (d.is_neutral()) {
+            for (double x : buf) REQUIRE(x == 0.0);
+            continue;
+        }
+        ++projected;
+        REQUIRE(admissible_view({S.data(), n}, ase::ScaledStepView::of({buf.data(), n})));
+    }
+    REQUIRE(projected > 90);
+}
+
+int main() {
+    test_reduction_order();
+    test_matches_engine();
+    test_project();
+    return 0;
+}
@@ -0,0 +1,111 @@
+// tests/test_device_cuda.cu
+// CUDA backend against the HostBackend reference: summaries, scaled and
+// clipped buffers, and full DeviceEnforcer decisions are bit-identical.
+// Built only with -DASE_WITH_CUDA=ON.
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ase/device.hpp"
+#include "ase/device_cuda.cuh"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool same_bits(const ase::device::Summary& a, const ase::device::Summary& b) {
+    return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+using Vec = std::vector<double>;
+
+// tests/test_device_cuda_unit2.cu (the header in a second translation unit)
+bool scale_in_second_unit(double* dS, double k, std::size_t n);
+
+struct DeviceBuffer final {
+    explicit DeviceBuffer(const Vec& host) : n(host.size()) {
+        REQUIRE(cudaMalloc(&ptr, n * sizeof(double) + 8) == cudaSuccess);
+        REQUIRE(cudaMemcpy(ptr, host.data(), n * sizeof(double), cudaMemcpyHostToDevice) == cudaSuccess);
+    }
+    ~DeviceBuffer() { cudaFree(ptr); }
+    DeviceBuffer(const DeviceBuffer&) = delete;
+    DeviceBuffer& operator=(const DeviceBuffer&) = delete;
+
+    Vec read() const {
+        Vec out(n);
+        REQUIRE(cudaMemcpy(out.data(), ptr, n * sizeof(double), cudaMemcpyDeviceToHost) == cudaSuccess);
+        return out;
+    }
+
+    double* ptr = nullptr;
+    std::size_t n;
+};
+
+int main() {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    ase::vec::BlockLimits lim;
+    lim.l2 = 1.0;
+    lim.linf = 0.1;
+    lim.step_linf = 0.05;
+    lim.sign_prefix = 64;
+
+    ase::HostBackend host;
+    ase::CudaBackend cuda;
+
+    for (std::size_t n : {std::size_t{1}, std::size_t{255}, std::size_t{257}, std::size_t{70000},
+                          std::size_t{1} << 20}) {
+        Vec S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = 0.02 * u(rng) + 0.02;
+            dS[i] = 0.1 * u(rng);
+        }
+        const DeviceBuffer dS_dev(dS), S_dev(S);
+
+        for (double k : {1.0, 0.5, 0.1234}) {
+            ase::device::Summary a, b;
+            REQUIRE(host.summarize(S.data(), dS.data(), k, n, lim, a));
+            REQUIRE(cuda.summarize(S_dev.ptr, dS_dev.ptr, k, n, lim, b));
+            REQUIRE(same_bits(a, b));
+        }
+
+        Vec clipped = dS;
+        REQUIRE(host.clip(S.data(), clipped.data(), n, lim));
+        REQUIRE(cuda.clip(S_dev.ptr, dS_dev.ptr, n, lim));
+        REQUIRE(dS_dev.read() == clipped);
+
+        REQUIRE(host.scale(clipped.data(), 0.75, n));
+        REQUIRE(scale_in_second_unit(dS_dev.ptr, 0.75, n));
+        REQUIRE(dS_dev.read() == clipped);
+    }
+
+    // Whole decisions, one enforcer per backend
+    const ase::Config cfgs[] = {
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+        {ase::Mode::Project},
+    };
+    for (const ase::Config& cfg : cfgs) {
+        ase::DeviceEnforcer<ase::HostBackend> ref(cfg, lim);
+        ase::DeviceEnforcer<ase::CudaBackend> dev(cfg, lim);
+        const std::size_t n = 100000;
+        for (int trial = 0; trial < 20; ++trial) {
+            Vec S(n), dS(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                S[i] = 0.002 * u(rng) + 0.002;
+                dS[i] = 0.2 * u(rng);
+            }
+            const DeviceBuffer S_dev(S), dS_dev(dS);
+
+            const ase::Decision a = ref.enforce(S.data(), dS.data(), n);
+            const ase::Decision b = dev.enforce(S_dev.ptr, dS_dev.ptr, n);
+            REQUIRE(a.kind == b.kind && a.k == b.k && a.attempts == b.attempts);
+            REQUIRE(dS_dev.read() == dS);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+// tests/test_device_cuda_unit2.cu
+// Second translation unit of test_device_cuda: ase/device_cuda.cuh is
+// included by two units of one program, which must link (no duplicate
+// kernel symbols).
+#include <cstddef>
+
+#include "ase/device_cuda.cuh"
+
+bool scale_in_second_unit(double* dS, double k, std::size_t n) {
+    ase::CudaBackend backend;
+    return backend.scale(dS, k, n);
+}
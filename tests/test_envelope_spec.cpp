@@ -0,0 +1,195 @@
+// tests/test_envelope_spec.cpp
+// EnvelopeSpec: the streaming derive-and-check pass gives exactly the same
+// answer as materializing the next state and checking it; malformed specs
+// admit nothing; it plugs into Engine as is_admissible.
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <random>
+
+#include "ase/ase.hpp"
+#include "ase/envelope_spec.hpp"
+#include "ase/vector_envelope.hpp"
+
+constexpr std::size_t N = 37; // not a multiple of the lane count
+
+using Vec = std::array<double, N>;
+
+struct State {
+    Vec theta{};
+    Vec m{};
+    Vec v{};
+    Vec ema{};
+};
+
+struct Env {
+    double R_theta = 1.0, R_m = 0.5, R_v = 0.1, R_ema = 1.0, R_gap = 0.3, R_dinf = 0.2;
+    std::size_t sign_k = 5;
+    double b1 = 0.9, b2 = 0.999, beta = 0.98;
+};
+
+static const Env g_env{};
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static ase::EnvelopeSpec<4> make_spec() {
+    ase::EnvelopeSpec<4> spec;
+    spec.transition(0, 1.0, 1.0)
+        .transition(1, g_env.b1, 1.0 - g_env.b1)
+        .transition(2, g_env.b2, 0.0, 1.0 - g_env.b2).clamp_nonneg(2)
+        .transition(3, g_env.beta, 0.0).feed(3, 0, 1.0 - g_env.beta)
+        .l2_ball(0, g_env.R_theta)
+        .l2_ball(1, g_env.R_m)
+        .l2_ball(2, g_env.R_v)
+        .l2_ball(3, g_env.R_ema)
+        .l2_gap(3, 0, g_env.R_gap)
+        .lower_bound(0, 0.0, g_env.sign_k)
+        .lower_bound(2, 0.0)
+        .step_linf(g_env.R_dinf);
+    return spec;
+}
+
+static const ase::EnvelopeSpec<4> g_spec = make_spec();
+
+static ase::EnvelopeSpec<4>::Channels channels(const State& s) {
+    return {s.theta.data(), s.m.data(), s.v.data(), s.ema.data()};
+}
+
+// ---- materialized reference ----
+
+static State derive_next(const State& S, const Vec& d) {
+    State n = S;
+    for (std::size_t i = 0; i < N; ++i) {
+        n.theta[i] = S.theta[i] + d[i];
+        n.m[i] = g_env.b1 * S.m[i] + (1.0 - g_env.b1) * d[i];
+        n.v[i] = g_env.b2 * S.v[i] + (1.0 - g_env.b2) * (d[i] * d[i]);
+        if (n.v[i] < 0.0) n.v[i] = 0.0;
+        n.ema[i] = g_env.beta * S.ema[i] + (1.0 - g_env.beta) * n.theta[i];
+    }
+    return n;
+}
+
+static bool state_valid(const State& s) {
+    if (!ase::vec::all_finite(s.theta) || !ase::vec::all_finite(s.m) ||
+        !ase::vec::all_finite(s.v) || !ase::vec::all_finite(s.ema)) return false;
+    if (!(ase::vec::l2_norm(s.theta) <= g_env.R_theta)) return false;
+    if (!(ase::vec::l2_norm(s.m) <= g_env.R_m)) return false;
+    if (!(ase::vec::l2_norm(s.v) <= g_env.R_v)) return false;
+    if (!(ase::vec::l2_norm(s.ema) <= g_env.R_ema)) return false;
+    if (!(ase::vec::l2_norm_diff(s.ema, s.theta) <= g_env.R_gap)) return false;
+    for (std::size_t i = 0; i < g_env.sign_k; ++i) if (s.theta[i] < 0.0) return false;
+    for (double x : s.v) if (x < 0.0) return false;
+    return true;
+}
+
+static bool ref_admits(const State& S, const Vec& d) {
+    for (double x : d) {
+        if (!std::isfinite(x) || std::fabs(x) > g_env.R_dinf) return false;
+    }
+    return state_valid(derive_next(S, d));
+}
+
+static State random_state(std::mt19937& rng) {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    State s;
+    for (std::size_t i = 0; i < N; ++i) {
+        s.theta[i] = 0.16 * u(rng) - 0.01;
+        s.m[i] = 0.1 * u(rng) - 0.05;
+        s.v[i] = 0.02 * u(rng);
+        s.ema[i] = s.theta[i] + 0.05 * (u(rng) - 0.5);
+    }
+    return s;
+}
+
+static void test_matches_materialized() {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    std::size_t admitted = 0;
+    std::size_t rejected = 0;
+    for (int trial = 0; trial < 4000; ++trial) {
+        const State S = random_state(rng);
+        const double scale = (trial % 4 == 0) ? 0.3 : 0.05;
+
+        Vec d{};
+        for (double& x : d) x = scale * u(rng);
+        if (trial % 50 == 0) d[trial % N] = std::numeric_limits<double>::quiet_NaN();
+        if (trial % 70 == 0) d[(trial / 70) % N] = std::numeric_limits<double>::infinity();
+
+        REQUIRE(g_spec.contains(channels(S), N) == state_valid(S));
+
+        const bool got = g_spec.admits(channels(S), d.data(), N);
+        REQUIRE(got == ref_admits(S, d));
+        (got ? admitted : rejected)++;
+
+        // Scaled candidates (what Scale mode evaluates)
+        for (double k : {0.5, 0.25, 0.125}) {
+            Vec c{};
+            for (std::size_t i = 0; i < N; ++i) c[i] = d[i] * k;
+            REQUIRE(g_spec.admits(channels(S), c.data(), N) == ref_admits(S, c));
+        }
+    }
+
+    // Both branches exercised
+    REQUIRE(admitted > 100);
+    REQUIRE(rejected > 100);
+}
+
+static void test_malformed_spec_fails_closed() {
+    State S{};
+    const Vec d{};
+
+    ase::EnvelopeSpec<2> ok;
+    REQUIRE(ok.valid());
+    REQUIRE(ok.admits({S.theta.data(), S.m.data()}, d.data(), N));
+
+    ase::EnvelopeSpec<2> bad_src;
+    bad_src.feed(0, 1, 0.5); // src must be an earlier channel
+    REQUIRE(!bad_src.valid());
+    REQUIRE(!bad_src.admits({S.theta.data(), S.m.data()}, d.data(), N));
+    REQUIRE(!bad_src.contains({S.theta.data(), S.m.data()}, N));
+
+    ase::EnvelopeSpec<2> bad_channel;
+    bad_channel.l2_ball(2, 1.0);
+    REQUIRE(!bad_channel.admits({S.theta.data(), S.m.data()}, d.data(), N));
+}
+
+static bool is_admissible(const State& S, const Vec& d) {
+    return g_spec.contains(channels(S), N) && g_spec.admits(channels(S), d.data(), N);
+}
+
+static Vec neutral_step() { return Vec{}; }
+
+static bool scale_step(const Vec& in, double k, Vec& out) {
+    return ase::vec::scale_into(in, k, out);
+}
+
+static void test_engine_integration() {
+    const ase::Dependencies<State, Vec> deps{&is_admissible, &neutral_step, &scale_step, nullptr};
+    const ase::Engine<State, Vec> eng({ase::Mode::Scale, 16, 0.5}, deps);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (int trial = 0; trial < 200; ++trial) {
+        State S = random_state(rng);
+        if (!state_valid(S)) continue;
+
+        Vec d{};
+        for (double& x : d) x = 0.5 * u(rng);
+
+        const Vec eff = eng.enforce(S, d);
+        REQUIRE(ref_admits(S, eff) || eff == neutral_step());
+    }
+}
+
+int main() {
+    test_matches_materialized();
+    test_malformed_spec_fails_closed();
+    test_engine_integration();
+    return 0;
+}
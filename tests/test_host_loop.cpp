@@ -0,0 +1,143 @@
+// tests/test_host_loop.cpp
+// HostLoop: sequential, fused and overlapped runs reproduce the plain
+// copy-per-tick loop bit for bit, including neutral ticks; state buffers
+// are reused, never reallocated; StaticEngine-style engines work too.
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/host_loop.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Vec = std::vector<double>;
+
+static bool admissible_ball(const Vec& S, const Vec& dS) {
+    if (S.size() != dS.size()) return false;
+    double sq = 0.0;
+    for (std::size_t i = 0; i < S.size(); ++i) sq += (S[i] + dS[i]) * (S[i] + dS[i]);
+    return std::isfinite(sq) && sq <= 1.0;
+}
+
+static Vec neutral_vec() { return Vec{}; }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) out[i] = k * in[i];
+    return true;
+}
+
+// Deterministic drift away from the origin with a tick-dependent wobble
+static void propose(const Vec& S, std::size_t t, Vec& out) {
+    out.resize(S.size());
+    for (std::size_t i = 0; i < S.size(); ++i) {
+        out[i] = 0.05 * S[i] + 1e-3 * std::sin(0.1 * static_cast<double>(t + i));
+    }
+    if (t % 17 == 5) out[t % S.size()] = NAN; // neutral tick
+}
+
+// ⊕ (empty step = neutral = no-op)
+static void apply(const Vec& S, const Vec& eff, Vec& next) {
+    next.resize(S.size());
+    for (std::size_t i = 0; i < S.size(); ++i) next[i] = eff.empty() ? S[i] : S[i] + eff[i];
+}
+
+static Vec initial_state(std::size_t n) {
+    Vec S(n);
+    for (std::size_t i = 0; i < n; ++i) S[i] = 0.5 / std::sqrt(static_cast<double>(n)) * std::cos(0.3 * i);
+    return S;
+}
+
+using Eng = ase::Engine<Vec, Vec>;
+
+// Reference: the copy-per-tick loop (s = derive_next(s, eff))
+static std::vector<Vec> reference(const Eng& eng, std::size_t n, std::size_t T, bool stale) {
+    std::vector<Vec> states{initial_state(n)};
+    Vec prev = states.back();
+    for (std::size_t t = 0; t < T; ++t) {
+        const Vec& S = states.back();
+        Vec dS;
+        propose((stale && t > 0) ? prev : S, t, dS);
+        const Vec eff = eng.enforce(S, dS);
+        Vec next;
+        apply(S, eff, next);
+        prev = S;
+        states.push_back(next);
+    }
+    return states;
+}
+
+static void test_runs_match_reference() {
+    const std::size_t n = 2048; // 16 KB state
+    const std::size_t T = 120;
+    const Eng eng({ase::Mode::Scale, 16, 0.5}, {&admissible_ball, &neutral_vec, &scale_vec, nullptr});
+
+    const std::vector<Vec> ref = reference(eng, n, T, false);
+    const std::vector<Vec> ref_stale = reference(eng, n, T, true);
+    REQUIRE(ref.back() != ref_stale.back()); // the two schedules really differ
+
+    // Sequential, split across two runs
+    {
+        ase::HostLoop<Eng, Vec, Vec> loop(eng, initial_state(n));
+        const double* a = loop.state().data();
+        loop.run(40, propose, apply);
+        const double* b = loop.state().data();
+        loop.run(T - 40, propose, apply);
+        REQUIRE(loop.ticks() == T && loop.state() == ref.back());
+        REQUIRE(loop.state().data() == a || loop.state().data() == b); // buffers reused
+    }
+
+    // Fused ⊕ + next proposal
+    {
+        std::size_t t = 0;
+        const auto apply_propose = [&t](const Vec& S, const Vec& eff, Vec& next, Vec& out) {
+            apply(S, eff, next);
+            propose(next, ++t, out);
+        };
+        ase::HostLoop<Eng, Vec, Vec> loop(eng, initial_state(n));
+        loop.run_fused(T, propose, apply_propose);
+        REQUIRE(loop.state() == ref.back());
+    }
+
+    // Overlapped: proposal t + 1 from S_t, generated during tick t
+    {
+        ase::HostLoop<Eng, Vec, Vec> loop(eng, initial_state(n));
+        loop.run_overlapped(T, propose, apply);
+        REQUIRE(loop.state() == ref_stale.back());
+
+        int decided = 0;
+        loop.run_overlapped(1, propose, [&](const Vec& S, const Vec& eff, Vec& next) {
+            ++decided;
+            apply(S, eff, next);
+        });
+        REQUIRE(decided == 1 && loop.ticks() == T + 1);
+        loop.run_overlapped(0, propose, apply);
+        REQUIRE(loop.ticks() == T + 1);
+    }
+}
+
+// Engine without enforce_into (StaticEngine-style)
+struct HalvingEngine {
+    double enforce(const double& S, const double& dS) const { return (std::fabs(S + dS) <= 1.0) ? dS : 0.5 * dS; }
+};
+
+static void test_other_engine() {
+    const HalvingEngine eng;
+    ase::HostLoop<HalvingEngine, double, double> loop(eng, 0.0);
+    loop.run(10, [](const double&, std::size_t, double& out) { out = 0.3; },
+             [](const double& S, const double& eff, double& next) { next = S + eff; });
+    double S = 0.0;
+    for (int t = 0; t < 10; ++t) S += eng.enforce(S, 0.3);
+    REQUIRE(loop.state() == S);
+}
+
+int main() {
+    test_runs_match_reference();
+    test_other_engine();
+    return 0;
+}
@@ -109,6 +109,25 @@ bool is_admissible(const State& S, const Step& dS) {
     return is_state_valid(next);
 }
 
+// Closed-form largest k with ||S + k*dS||2 <= R (quadratic in k).
+// The sign constraint is not solved for; the engine verifies the candidate.
+bool solve_scale(const State& S, const Step& dS, double& k_max) {
+    long double a = 0.0L, b = 0.0L, c = 0.0L;
+    for (std::size_t i = 0; i < N; ++i) {
+        a += (long double)dS[i] * (long double)dS[i];
+        b += (long double)S[i] * (long double)dS[i];
+        c += (long double)S[i] * (long double)S[i];
+    }
+    c -= (long double)g_env.R * (long double)g_env.R;
+    if (!(a > 0.0L) || c > 0.0L) return false;
+
+    const long double disc = b * b - a * c;
+    if (!(disc >= 0.0L)) return false;
+
+    k_max = (double)((-b + std::sqrt(disc)) / a) * (1.0 - 1e-9);
+    return is_finite(k_max);
+}
+
 bool project_step(const State& S, const Step& in, Step& out) {
     if (!is_state_valid(S)) return false;
     for (double x : in) if (!is_finite(x)) return false;
@@ -157,7 +176,7 @@ Step propose_step(const State& theta, std::mt19937& rng, double eta) {
     return d;
 }
 
-State run_enforced(ase::Mode mode) {
+State run_enforced(ase::Mode mode, bool use_solver = false) {
     // envelope
     g_env.R = 5.0;
     g_env.sign_preserve_k = 8;
@@ -179,6 +198,7 @@ State run_enforced(ase::Mode mode) {
     deps.neutral_step  = &neutral_step;
     deps.scale_step    = &scale_step;
     deps.project_step  = &project_step;
+    if (use_solver) deps.solve_scale = &solve_scale;
 
     ase::Engine<State, Step> engine(cfg, deps);
 
@@ -231,6 +251,18 @@ int main() {
         if (!is_state_valid(a1)) return 3;
     }
 
+    // Scale with closed-form solver: same envelope guarantees, repeatable
+    {
+        const State s1 = run_enforced(ase::Mode::Scale, true);
+        const State s2 = run_enforced(ase::Mode::Scale, true);
+
+        for (std::size_t i = 0; i < N; ++i) {
+            if (s1[i] != s2[i]) return 7;
+            if (!is_finite(s1[i])) return 8;
+        }
+        if (!is_state_valid(s1)) return 9;
+    }
+
     {
         const State p1 = run_enforced(ase::Mode::Project);
         const State p2 = run_enforced(ase::Mode::Project);
@@ -0,0 +1,176 @@
+// tests/test_numa.cpp
+// NUMA placement helpers: cpulists parse; the detected topology lists each
+// usable CPU once; ShardPool runs every shard exactly once, always on its
+// owner (also for make_shards), pinned where permitted; SoaShard fields are
+// aligned, zeroed and usable as EnvelopeSpec channels; sharded enforcement
+// matches the sequential one for any worker count.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // std::abort
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/envelope_spec.hpp"
+#include "ase/numa.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Vec = std::vector<double>;
+using Shard = ase::numa::SoaShard<2>; // {theta, v}
+
+static void test_topology() {
+    std::vector<unsigned> cpus;
+    REQUIRE(ase::numa::Topology::parse_cpulist("0-3,8,10-11\n", cpus));
+    REQUIRE((cpus == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    REQUIRE(ase::numa::Topology::parse_cpulist("5", cpus) && cpus == std::vector<unsigned>{5});
+    REQUIRE(!ase::numa::Topology::parse_cpulist("x", cpus));
+    REQUIRE(!ase::numa::Topology::parse_cpulist("3-1", cpus));
+
+    const ase::numa::Topology two{{{0, 1, 2}, {4, 5}}};
+    REQUIRE((two.interleaved_cpus() == std::vector<unsigned>{0, 4, 1, 5, 2}));
+    REQUIRE(two.node_of_cpu(5) == 1 && two.node_of_cpu(3) == 2 && two.cpu_count() == 5);
+
+    const ase::numa::Topology t = ase::numa::Topology::detect();
+    REQUIRE(t.node_count() >= 1 && t.cpu_count() >= 1);
+    std::vector<unsigned> all = t.interleaved_cpus();
+    REQUIRE(all.size() == t.cpu_count());
+    std::sort(all.begin(), all.end());
+    REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
+
+static void test_pool_ownership() {
+    for (std::size_t workers : {std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+        ase::numa::ShardPool pool(workers);
+        REQUIRE(pool.worker_count() == workers);
+
+        std::vector<std::thread::id> ids(workers);
+        pool.run([&](std::size_t w) { ids[w] = std::this_thread::get_id(); });
+
+        for (std::size_t w = 0; w < workers; ++w) {
+            REQUIRE(pool.node_of(w) < pool.topology().node_count());
+            if (pool.pinned(w)) {
+                int cpu = -1;
+                pool.run([&](std::size_t v) {
+                    if (v == w) cpu = ase::numa::current_cpu();
+                });
+                REQUIRE(cpu == pool.cpu_of(w));
+            }
+        }
+
+        const std::size_t count = 37;
+        std::vector<int> runs(count, 0);
+        std::vector<std::thread::id> ran_on(count);
+        for (int rep = 0; rep < 3; ++rep) {
+            pool.for_each_shard(count, [&](std::size_t s) {
+                ++runs[s];
+                ran_on[s] = std::this_thread::get_id();
+            });
+            for (std::size_t s = 0; s < count; ++s) REQUIRE(ran_on[s] == ids[pool.owner(s)]);
+        }
+        for (int r : runs) REQUIRE(r == 3);
+
+        // Constructed on the owner
+        std::vector<std::thread::id> made_on(count);
+        const auto shards = pool.make_shards(count, [&](std::size_t s) {
+            made_on[s] = std::this_thread::get_id();
+            return std::make_unique<Shard>(s + 1);
+        });
+        for (std::size_t s = 0; s < count; ++s) {
+            REQUIRE(shards[s] && shards[s]->size() == s + 1 && made_on[s] == ids[pool.owner(s)]);
+        }
+    }
+
+    // Unpinned pool
+    ase::numa::ShardPool loose(2, false);
+    REQUIRE(!loose.pinned(0) && !loose.pinned(1));
+}
+
+static void test_soa_shard() {
+    for (std::size_t n : {std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{1000}}) {
+        Shard shard(n);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(shard.field(0)) % Shard::kPage == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(shard.field(1)) % 64 == 0);
+        REQUIRE(shard.field(1) >= shard.field(0) + n);
+        for (std::size_t c = 0; c < 2; ++c) {
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(shard.field(c)[i] == 0.0);
+        }
+        const Shard::Channels ch = shard.channels();
+        REQUIRE(ch[0] == shard.field(0) && ch[1] == shard.field(1));
+
+        Shard moved(std::move(shard));
+        REQUIRE(moved.size() == n && moved.field(1) == ch[1]);
+    }
+}
+
+// theta_next = theta + dS (||.|| <= 1), v_next = 0.9 v + 0.1 dS^2 (>= 0)
+static const ase::EnvelopeSpec<2> kSpec = ase::EnvelopeSpec<2>{}
+                                              .transition(0, 1.0, 1.0)
+                                              .transition(1, 0.9, 0.0, 0.1)
+                                              .l2_ball(0, 1.0)
+                                              .lower_bound(1, 0.0);
+
+static bool admissible(const Shard& S, const Vec& dS) {
+    return dS.size() == S.size() && kSpec.admits(S.channels(), dS.data(), S.size());
+}
+
+static Vec neutral_vec() { return Vec{}; }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    return ase::vec::scale_into(in.data(), k, out.data(), in.size());
+}
+
+static void fill(Shard& shard, std::size_t s) {
+    for (std::size_t i = 0; i < shard.size(); ++i) {
+        shard.field(0)[i] = 0.5 / std::sqrt(static_cast<double>(shard.size())) * std::sin(0.1 * (i + s));
+        shard.field(1)[i] = 0.01 * static_cast<double>(i % 5);
+    }
+}
+
+static void test_sharded_enforcement() {
+    const ase::Engine<Shard, Vec> eng({ase::Mode::Scale, 16, 0.5}, {&admissible, &neutral_vec, &scale_vec, nullptr});
+    const std::size_t count = 24, n = 512;
+
+    std::vector<Vec> proposed(count, Vec(n));
+    for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t i = 0; i < n; ++i) proposed[s][i] = (s % 3 ? 0.2 : 0.001) * std::cos(0.3 * (i + s));
+    }
+
+    // Sequential reference
+    std::vector<Vec> ref(count);
+    for (std::size_t s = 0; s < count; ++s) {
+        Shard S(n);
+        fill(S, s);
+        ref[s] = eng.enforce(S, proposed[s]);
+    }
+
+    for (std::size_t workers : {std::size_t{1}, std::size_t{4}}) {
+        ase::numa::ShardPool pool(workers);
+        const auto shards = pool.make_shards(count, [n](std::size_t s) {
+            auto shard = std::make_unique<Shard>(n);
+            fill(*shard, s);
+            return shard;
+        });
+        std::vector<ase::Scratch<Vec>> scratch(workers);
+        std::vector<Vec> out(count);
+        pool.for_each_shard(count, [&](std::size_t s) {
+            eng.enforce_into(*shards[s], proposed[s], out[s], scratch[pool.owner(s)]);
+        });
+        REQUIRE(out == ref);
+    }
+}
+
+int main() {
+    test_topology();
+    test_pool_ownership();
+    test_soa_shard();
+    test_sharded_enforcement();
+    return 0;
+}
@@ -0,0 +1,145 @@
+// tests/test_parallel.cpp
+// ParallelEnforcer: out[i] == enforce(S[i], proposed[i]) for every thread
+// count and chunk size; Decision records match; StaticEngine works too;
+// the pool is reusable across calls.
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/parallel.hpp"
+#include "ase/static_engine.hpp"
+
+static bool is_finite(double x) { return std::isfinite(x); }
+
+static bool admissible_limit(const double& S, const double& dS) {
+    if (!is_finite(S) || !is_finite(dS)) return false;
+    const double next = S + dS;
+    if (!is_finite(next)) return false;
+    return std::fabs(next) <= 1.0;
+}
+
+static double neutral_zero() { return 0.0; }
+
+static bool scale_mul(const double& in, double k, double& out) {
+    if (!is_finite(in) || !is_finite(k)) return false;
+    out = in * k;
+    return is_finite(out);
+}
+
+struct ScalarPolicy {
+    static bool is_admissible(const double& S, const double& dS) { return admissible_limit(S, dS); }
+    static double neutral_step() { return neutral_zero(); }
+    static bool scale_step(const double& in, double k, double& out) { return scale_mul(in, k, out); }
+};
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool same(double a, double b) {
+    return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+// Deterministic mix of pass-through, scaled and neutral pairs
+static void make_inputs(std::size_t n, std::vector<double>& S, std::vector<double>& dS) {
+    S.resize(n);
+    dS.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        S[i]  = static_cast<double>(i % 21) * 0.1 - 1.0;
+        dS[i] = static_cast<double>((i * 7) % 13) * 0.25 - 1.5;
+        if (i % 97 == 0) dS[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+static void test_matches_serial() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, nullptr
+    };
+    const ase::Engine<double, double> eng(cfg, deps);
+
+    const std::size_t sizes[] = {1, 63, 64, 65, 1000, 10007};
+    const std::size_t threads[] = {1, 2, 3, 4, 7};
+    const std::size_t chunks[] = {1, 16, 64, 5000};
+
+    for (std::size_t n : sizes) {
+        std::vector<double> S, dS;
+        make_inputs(n, S, dS);
+
+        std::vector<double> ref(n);
+        std::vector<ase::Decision> ref_dec(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const ase::EnforceOutcome<double> r = eng.enforce_outcome(S[i], dS[i]);
+            ref[i] = r.step;
+            ref_dec[i] = {r.kind, r.k, r.attempts};
+        }
+
+        for (std::size_t t : threads) {
+            for (std::size_t c : chunks) {
+                ase::ParallelEnforcer pool(t, c);
+                REQUIRE(pool.thread_count() == t);
+
+                std::vector<double> out(n, 99.0);
+                std::vector<ase::Decision> dec(n);
+                pool.enforce(eng, S.data(), dS.data(), out.data(), n, dec.data());
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    REQUIRE(same(out[i], ref[i]));
+                    REQUIRE(dec[i].kind == ref_dec[i].kind);
+                    REQUIRE(dec[i].k == ref_dec[i].k);
+                    REQUIRE(dec[i].attempts == ref_dec[i].attempts);
+                }
+            }
+        }
+    }
+}
+
+static void test_pool_reuse_and_aliasing() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, nullptr
+    };
+    const ase::Engine<double, double> eng(cfg, deps);
+
+    ase::ParallelEnforcer pool(4, 32);
+
+    std::vector<double> S, dS;
+    make_inputs(4096, S, dS);
+
+    for (int round = 0; round < 50; ++round) {
+        std::vector<double> io = dS; // out aliases proposed
+        pool.enforce(eng, S.data(), io.data(), io.data(), io.size());
+        for (std::size_t i = 0; i < io.size(); ++i) {
+            REQUIRE(same(io[i], eng.enforce(S[i], dS[i])));
+        }
+    }
+
+    // Empty range is a no-op
+    pool.enforce(eng, S.data(), dS.data(), static_cast<double*>(nullptr), 0);
+}
+
+static void test_static_engine() {
+    const ase::StaticEngine<double, double, ScalarPolicy> eng({ase::Mode::Scale, 16, 0.5});
+
+    std::vector<double> S, dS;
+    make_inputs(3000, S, dS);
+
+    ase::ParallelEnforcer pool(3, 50);
+    std::vector<double> out(S.size());
+    pool.enforce(eng, S.data(), dS.data(), out.data(), out.size());
+
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        REQUIRE(same(out[i], eng.enforce(S[i], dS[i])));
+    }
+}
+
+int main() {
+    test_matches_serial();
+    test_pool_reuse_and_aliasing();
+    test_static_engine();
+    return 0;
+}
@@ -0,0 +1,355 @@
+// tests/test_perf_bounds.cpp
+// Performance tier, deterministic part (Auto-Test Suite §7): for trivially
+// copyable steps (a scalar and std::array<double, 256>) no entry point
+// allocates, in any mode or outcome, with stats or a tracer attached; and
+// every mode stays within its hook-call budget over adversarial proposals:
+//   Reject   : 1 evaluation
+//   Scale    : <= 1 + A evaluations, <= A transforms (A = max_scale_attempts,
+//              one more of each with solve_scale), attempts == transforms
+//   Project  : <= 2 evaluations, <= 1 projection (1 evaluation if certified)
+//   neutral_step is called at construction only.
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort, std::malloc, std::free
+#include <limits>
+#include <new>
+
+#include "ase/ase.hpp"
+#include "ase/projection.hpp"
+#include "ase/static_engine.hpp"
+#include "ase/stats.hpp"
+#include "ase/trace.hpp"
+#include "ase/vector_envelope.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+// ----------------------------
+// Allocation counter (replaces the global operator new / delete)
+// ----------------------------
+static std::atomic<std::size_t> g_allocations{0};
+
+void* operator new(std::size_t n) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <class Fn>
+static std::size_t allocations(Fn&& fn) {
+    const std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    fn();
+    return g_allocations.load(std::memory_order_relaxed) - before;
+}
+
+volatile double g_sink = 0.0;
+int* volatile g_pointer = nullptr;
+
+// ----------------------------
+// Hook-call counters
+// ----------------------------
+struct Calls final {
+    std::size_t admissible = 0;
+    std::size_t neutral = 0;
+    std::size_t scale = 0;
+    std::size_t project = 0;
+    std::size_t solve = 0;
+};
+
+static Calls g_calls;
+
+// ----------------------------
+// Scalar envelope: |S + dS| <= 1
+// ----------------------------
+namespace scalar {
+
+bool is_admissible(const double& S, const double& dS) {
+    ++g_calls.admissible;
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    return std::fabs(S + dS) <= 1.0;
+}
+
+double neutral_step() {
+    ++g_calls.neutral;
+    return 0.0;
+}
+
+bool scale_step(const double& in, double k, double& out) {
+    ++g_calls.scale;
+    out = in * k;
+    return std::isfinite(out);
+}
+
+bool project_step(const double& S, const double& in, double& out) {
+    ++g_calls.project;
+    if (!std::isfinite(S) || !std::isfinite(in)) return false;
+    out = std::fmin(1.0, std::fmax(-1.0, S + in)) - S;
+    return std::isfinite(out);
+}
+
+bool solve_scale(const double& S, const double& dS, double& k) {
+    ++g_calls.solve;
+    if (!std::isfinite(S) || !std::isfinite(dS) || dS == 0.0) return false;
+    k = ((dS > 0.0 ? 1.0 : -1.0) - S) / dS;
+    return k > 0.0 && k < 1.0;
+}
+
+} // namespace scalar
+
+// ----------------------------
+// N = 256 envelope: ||S + dS||2 <= 5, S[i] + dS[i] >= 0 for i < 8
+// ----------------------------
+namespace array256 {
+
+constexpr std::size_t N = 256;
+using Vec = std::array<double, N>;
+
+const ase::proj::SignPrefix kPrefix{8, 0.0};
+const ase::proj::L2Ball kBall{5.0};
+double g_work[4 * N];
+const auto kSet = ase::proj::intersect(kPrefix, kBall, g_work);
+
+bool is_admissible(const Vec& S, const Vec& dS) {
+    ++g_calls.admissible;
+    return kSet.admits(S.data(), dS.data(), N);
+}
+
+Vec neutral_step() {
+    ++g_calls.neutral;
+    return Vec{};
+}
+
+bool scale_step(const Vec& in, double k, Vec& out) {
+    ++g_calls.scale;
+    return ase::vec::scale_into(in.data(), k, out.data(), N);
+}
+
+// Sign prefix only: the engine has to verify the output
+bool project_step(const Vec& S, const Vec& in, Vec& out) {
+    ++g_calls.project;
+    bool certified = false;
+    return kPrefix.project(S.data(), in.data(), out.data(), N, certified);
+}
+
+bool project_certified(const Vec& S, const Vec& in, Vec& out, bool& certified) {
+    ++g_calls.project;
+    return kSet.project(S.data(), in.data(), out.data(), N, certified);
+}
+
+Vec state(double r, double phase) {
+    Vec S{};
+    for (std::size_t i = 0; i < N; ++i) S[i] = r / 16.0 * std::fabs(std::sin(0.37 * static_cast<double>(i) + phase));
+    return S;
+}
+
+Vec step(double a, double phase) {
+    Vec dS{};
+    for (std::size_t i = 0; i < N; ++i) dS[i] = a * std::cos(0.11 * static_cast<double>(i) + phase);
+    return dS;
+}
+
+} // namespace array256
+
+static const ase::Config kConfigs[] = {
+    {ase::Mode::Reject},
+    {ase::Mode::Scale, 16, 0.5},
+    {ase::Mode::Scale, 3, 0.5},
+    {ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection, 1e-3},
+    {ase::Mode::Scale, 7, 0.5, ase::ScaleSearch::Bisection, 0.0},
+    {ase::Mode::Project},
+};
+
+static const double kScalars[] = {
+    0.0, 1e-300, 0.25, 0.5, 0.9, 1.0, 1.5, 3.0, 1e6, 1e300, -0.5, -1.0, -2.0, -1e300,
+    std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+    std::numeric_limits<double>::quiet_NaN(),
+};
+
+// One enforcement's hook calls against its mode's budget
+static void require_budget(const ase::Config& cfg, const Calls& c, std::size_t attempts, bool solver,
+                           bool certified) {
+    const std::size_t extra = solver ? 1 : 0;
+    REQUIRE(c.neutral == 0);
+    REQUIRE(c.solve <= extra);
+    switch (cfg.mode) {
+        case ase::Mode::Reject:
+            REQUIRE(c.admissible == 1 && c.scale == 0 && c.project == 0);
+            break;
+        case ase::Mode::Scale:
+            REQUIRE(c.admissible <= 1 + cfg.max_scale_attempts + extra);
+            REQUIRE(c.scale <= cfg.max_scale_attempts + extra);
+            REQUIRE(c.scale == attempts && c.project == 0);
+            break;
+        case ase::Mode::Project:
+            REQUIRE(c.admissible <= (certified ? 1u : 2u) && c.project <= 1 && c.scale == 0);
+            break;
+    }
+}
+
+// ----------------------------
+// Predicate-call bounds
+// ----------------------------
+static void test_scalar_call_bounds() {
+    for (bool solver : {false, true}) {
+        ase::Dependencies<double, double> deps{&scalar::is_admissible, &scalar::neutral_step, &scalar::scale_step,
+                                               &scalar::project_step};
+        if (solver) deps.solve_scale = &scalar::solve_scale;
+
+        for (const ase::Config& cfg : kConfigs) {
+            g_calls = Calls{};
+            const ase::Engine<double, double> eng(cfg, deps);
+            REQUIRE(g_calls.neutral == 1);
+
+            for (double S : kScalars) {
+                for (double dS : kScalars) {
+                    for (double hint : {1.0, 0.3, 0.01}) {
+                        g_calls = Calls{};
+                        const auto r = eng.enforce_outcome(S, dS, ase::ScaleHint{hint});
+                        require_budget(cfg, g_calls, r.attempts, solver, false);
+                        g_sink = r.step;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void test_array_call_bounds() {
+    using array256::Vec;
+    for (bool certified : {false, true}) {
+        ase::Dependencies<Vec, Vec> deps{&array256::is_admissible, &array256::neutral_step,
+                                         &array256::scale_step, &array256::project_step};
+        if (certified) deps.project_step_certified = &array256::project_certified;
+
+        for (const ase::Config& cfg : kConfigs) {
+            const ase::Engine<Vec, Vec> eng(cfg, deps);
+            ase::Scratch<Vec> scratch;
+            Vec out{};
+
+            for (double r : {0.0, 10.0, 70.0}) {
+                for (double a : {0.0, 0.01, 0.2, 1.0, 50.0, 1e300}) {
+                    const Vec S = array256::state(r, a);
+                    const Vec dS = array256::step(a, r);
+                    g_calls = Calls{};
+                    ase::Decision d;
+                    const bool derived = eng.enforce_into(S, dS, out, scratch, d);
+                    require_budget(cfg, g_calls, d.attempts, false, certified);
+                    if (derived) REQUIRE(array256::kSet.admits(S.data(), out.data(), array256::N));
+                }
+            }
+        }
+    }
+}
+
+// enforce_batch: the per-element budget, summed
+static void test_batch_call_bounds() {
+    const ase::Dependencies<double, double> deps{&scalar::is_admissible, &scalar::neutral_step, &scalar::scale_step,
+                                                 &scalar::project_step};
+    constexpr std::size_t n = sizeof(kScalars) / sizeof(kScalars[0]);
+    double S[n];
+    double out[n];
+    for (std::size_t i = 0; i < n; ++i) S[i] = 0.9;
+
+    for (const ase::Config& cfg : kConfigs) {
+        const ase::Engine<double, double> eng(cfg, deps);
+        g_calls = Calls{};
+        eng.enforce_batch(S, kScalars, out, n);
+        REQUIRE(g_calls.neutral == 0);
+        switch (cfg.mode) {
+            case ase::Mode::Reject:  REQUIRE(g_calls.admissible == n); break;
+            case ase::Mode::Scale:   REQUIRE(g_calls.admissible <= n * (1 + cfg.max_scale_attempts)); break;
+            case ase::Mode::Project: REQUIRE(g_calls.admissible <= 2 * n && g_calls.project <= n); break;
+        }
+    }
+}
+
+// ----------------------------
+// Zero allocations per enforcement
+// ----------------------------
+template <class Eng, class State, class Step>
+static void require_no_allocations(const Eng& eng, const State& S, const Step& dS) {
+    ase::Scratch<Step> scratch;
+    Step out{};
+    Step batch_out[2];
+    const State batch_S[2] = {S, S};
+    const Step batch_dS[2] = {dS, dS};
+
+    REQUIRE(allocations([&] {
+        const Step a = eng.enforce(S, dS);
+        const Step b = eng.enforce(S, dS, ase::ScaleHint{0.3});
+        const auto r = eng.enforce_outcome(S, dS);
+        eng.enforce_into(S, dS, out, scratch);
+        eng.enforce_batch(batch_S, batch_dS, batch_out, 2);
+        g_sink = static_cast<double>(sizeof(a) + sizeof(b) + r.attempts);
+    }) == 0);
+}
+
+static void test_scalar_allocations() {
+    const ase::Dependencies<double, double> deps{&scalar::is_admissible, &scalar::neutral_step, &scalar::scale_step,
+                                                 &scalar::project_step};
+    ase::ShardedStats<2> stats;
+    ase::TraceRing<1024> ring;
+
+    for (const ase::Config& cfg : kConfigs) {
+        const ase::Engine<double, double> plain(cfg, deps);
+        const ase::Engine<double, double, ase::NoContext, ase::ShardedStats<2>> counted(cfg, deps, &stats);
+        const ase::Engine<double, double, ase::NoContext, ase::NullStats, ase::TraceRing<1024>> traced(
+            cfg, deps, nullptr, &ring);
+
+        // pass-through, scaled / projected, neutral
+        for (double dS : {0.05, 0.5, std::numeric_limits<double>::quiet_NaN()}) {
+            require_no_allocations(plain, 0.9, dS);
+            require_no_allocations(counted, 0.9, dS);
+            require_no_allocations(traced, 0.9, dS);
+        }
+    }
+
+    const auto hooks = ase::make_hooks(
+        [](const double& S, const double& dS) { return std::fabs(S + dS) <= 1.0; },
+        [] { return 0.0; },
+        [](const double& in, double k, double& out) { out = in * k; return true; });
+    const ase::StaticEngine<double, double, decltype(hooks)> fixed({ase::Mode::Scale, 16, 0.5}, hooks);
+    REQUIRE(allocations([&] { g_sink = fixed.enforce(0.9, 0.5) + fixed.enforce(0.0, 0.5); }) == 0);
+}
+
+static void test_array_allocations() {
+    using array256::Vec;
+    ase::Dependencies<Vec, Vec> deps{&array256::is_admissible, &array256::neutral_step, &array256::scale_step,
+                                     &array256::project_step};
+    const Vec S = array256::state(10.0, 0.0);
+
+    for (bool certified : {false, true}) {
+        deps.project_step_certified = certified ? &array256::project_certified : nullptr;
+        for (const ase::Config& cfg : kConfigs) {
+            const ase::Engine<Vec, Vec> eng(cfg, deps);
+            for (double a : {0.01, 1.0, std::numeric_limits<double>::quiet_NaN()}) {
+                require_no_allocations(eng, S, array256::step(a, 0.0));
+            }
+        }
+    }
+}
+
+// The counter itself sees allocations
+static void test_counter_live() {
+    REQUIRE(allocations([] {
+        g_pointer = new int(1);
+        delete g_pointer;
+    }) == 1);
+}
+
+int main() {
+    test_counter_live();
+    test_scalar_call_bounds();
+    test_array_call_bounds();
+    test_batch_call_bounds();
+    test_scalar_allocations();
+    test_array_allocations();
+    return 0;
+}
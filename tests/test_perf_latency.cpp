@@ -0,0 +1,271 @@
+// tests/test_perf_latency.cpp
+// Performance tier, timing part (Auto-Test Suite §7.1): enforce latency of
+// the scalar and N = 256 envelopes, per mode and outcome, against the
+// stored baselines in tests/perf_baselines.txt. A case fails when its best
+// batch average exceeds
+//   max(baseline * tolerance, baseline + floor_ns) * ASE_PERF_SLACK
+// (tolerance / floor_ns from the baseline file; ASE_PERF_SLACK from the
+// environment, default 1, e.g. 10 under sanitizers). The best of several
+// batches is robust to preemption; a slower hot path moves every batch.
+//
+// Usage: test_perf_latency <baselines>            check
+//        test_perf_latency <baselines> --record   print measured baselines
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/projection.hpp"
+#include "ase/vector_envelope.hpp"
+
+namespace {
+
+volatile double g_sink = 0.0;
+
+// ----------------------------
+// scalar: |S + dS| <= 1 (scalar_demo)
+// ----------------------------
+namespace scalar {
+
+bool is_admissible(const double& S, const double& dS) {
+    if (!std::isfinite(S) || !std::isfinite(dS)) return false;
+    return std::fabs(S + dS) <= 1.0;
+}
+
+double neutral_step() { return 0.0; }
+
+bool scale_step(const double& in, double k, double& out) {
+    out = in * k;
+    return std::isfinite(out);
+}
+
+bool project_step(const double& S, const double& in, double& out) {
+    if (!std::isfinite(S) || !std::isfinite(in)) return false;
+    out = std::fmin(1.0, std::fmax(-1.0, S + in)) - S;
+    return std::isfinite(out);
+}
+
+const ase::Dependencies<double, double> kDeps{&is_admissible, &neutral_step, &scale_step, &project_step};
+
+} // namespace scalar
+
+// ----------------------------
+// array256: ||S + dS||2 <= 5, S[i] + dS[i] >= 0 for i < 8
+// ----------------------------
+namespace array256 {
+
+constexpr std::size_t N = 256;
+using Vec = std::array<double, N>;
+
+const ase::proj::SignPrefix kPrefix{8, 0.0};
+const ase::proj::L2Ball kBall{5.0};
+double g_work[4 * N];
+const auto kSet = ase::proj::intersect(kPrefix, kBall, g_work);
+
+bool is_admissible(const Vec& S, const Vec& dS) {
+    return kSet.admits(S.data(), dS.data(), N);
+}
+
+Vec neutral_step() { return Vec{}; }
+
+bool scale_step(const Vec& in, double k, Vec& out) {
+    return ase::vec::scale_into(in.data(), k, out.data(), N);
+}
+
+bool project_certified(const Vec& S, const Vec& in, Vec& out, bool& certified) {
+    return kSet.project(S.data(), in.data(), out.data(), N, certified);
+}
+
+ase::Dependencies<Vec, Vec> deps() {
+    ase::Dependencies<Vec, Vec> d{&is_admissible, &neutral_step, &scale_step, nullptr};
+    d.project_step_certified = &project_certified;
+    return d;
+}
+
+Vec state() {
+    Vec S{};
+    for (std::size_t i = 0; i < N; ++i) S[i] = 0.2 * std::fabs(std::sin(0.37 * static_cast<double>(i)));
+    return S;
+}
+
+Vec step(double a) {
+    Vec dS{};
+    for (std::size_t i = 0; i < N; ++i) dS[i] = a * std::cos(0.11 * static_cast<double>(i));
+    return dS;
+}
+
+} // namespace array256
+
+// Best batch average, ns per enforcement
+template <class Fn>
+double measure(Fn&& fn, std::size_t batch) {
+    constexpr int kBatches = 31;
+    for (std::size_t i = 0; i < batch; ++i) fn(); // warm-up
+
+    double best = 1e300;
+    for (int b = 0; b < kBatches; ++b) {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < batch; ++i) fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(batch);
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+struct Case final {
+    const char* name;
+    double ns;
+};
+
+// Inputs reloaded through volatiles, so no call is hoisted out of the loop
+template <class Eng>
+double time_enforce(const Eng& eng, double S, double dS, std::size_t batch) {
+    volatile double vS = S;
+    volatile double vdS = dS;
+    return measure([&] {
+        const double s = vS;
+        const double d = vdS;
+        g_sink = eng.enforce(s, d);
+    }, batch);
+}
+
+template <class Eng, class State, class Step>
+double time_enforce_into(const Eng& eng, const State& S, const Step& dS, std::size_t batch) {
+    ase::Scratch<Step> scratch;
+    Step out{};
+    return measure([&] {
+        eng.enforce_into(S, dS, out, scratch);
+        g_sink = out[0];
+    }, batch);
+}
+
+std::vector<Case> run_cases() {
+    std::vector<Case> cases;
+
+    {
+        const ase::Engine<double, double> reject({ase::Mode::Reject}, scalar::kDeps);
+        const ase::Engine<double, double> scale({ase::Mode::Scale, 16, 0.5}, scalar::kDeps);
+        const ase::Engine<double, double> project({ase::Mode::Project}, scalar::kDeps);
+        constexpr std::size_t kBatch = 20000;
+        const double nan = std::nan("");
+
+        cases.push_back({"scalar.reject.pass_through", time_enforce(reject, 0.9, 0.05, kBatch)});
+        cases.push_back({"scalar.reject.neutral", time_enforce(reject, 0.9, 0.5, kBatch)});
+        cases.push_back({"scalar.scale.scaled", time_enforce(scale, 0.9, 0.5, kBatch)});
+        cases.push_back({"scalar.scale.neutral", time_enforce(scale, 0.9, nan, kBatch)});
+        cases.push_back({"scalar.project.projected", time_enforce(project, 0.9, 0.5, kBatch)});
+    }
+
+    {
+        using array256::Vec;
+        const auto deps = array256::deps();
+        const ase::Engine<Vec, Vec> reject({ase::Mode::Reject}, deps);
+        const ase::Engine<Vec, Vec> scale({ase::Mode::Scale, 16, 0.5}, deps);
+        const ase::Engine<Vec, Vec> project({ase::Mode::Project}, deps);
+        const Vec S = array256::state();
+        const Vec small = array256::step(0.01);
+        const Vec big = array256::step(1.0);
+        constexpr std::size_t kBatch = 2000;
+
+        cases.push_back({"array256.reject.pass_through", time_enforce_into(reject, S, small, kBatch)});
+        cases.push_back({"array256.reject.neutral", time_enforce_into(reject, S, big, kBatch)});
+        cases.push_back({"array256.scale.scaled", time_enforce_into(scale, S, big, kBatch)});
+        cases.push_back({"array256.project.certified", time_enforce_into(project, S, big, kBatch)});
+    }
+    return cases;
+}
+
+// ----------------------------
+// Baseline file: "name ns" lines, "tolerance x", "floor_ns x", # comments
+// ----------------------------
+struct Baselines final {
+    double tolerance = 2.0;
+    double floor_ns = 0.0;
+    std::vector<std::string> names;
+    std::vector<double> ns;
+
+    const double* find(const char* name) const {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) return &ns[i];
+        }
+        return nullptr;
+    }
+};
+
+bool load(const char* path, Baselines& out) {
+    std::FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+
+    char line[256];
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof line, f)) {
+        char name[128];
+        double value = 0.0;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (std::sscanf(line, "%127s %lf", name, &value) != 2 || !(value > 0.0)) {
+            ok = false;
+        } else if (std::strcmp(name, "tolerance") == 0) {
+            out.tolerance = value;
+        } else if (std::strcmp(name, "floor_ns") == 0) {
+            out.floor_ns = value;
+        } else {
+            out.names.emplace_back(name);
+            out.ns.push_back(value);
+        }
+    }
+    std::fclose(f);
+    return ok;
+}
+
+double env_slack() {
+    const char* s = std::getenv("ASE_PERF_SLACK");
+    if (!s) return 1.0;
+    const double v = std::strtod(s, nullptr);
+    return v >= 1.0 ? v : 1.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <baselines> [--record]\n", argv[0]);
+        return 2;
+    }
+    const bool record = argc > 2 && std::strcmp(argv[2], "--record") == 0;
+
+    Baselines base;
+    if (!record && !load(argv[1], base)) {
+        std::fprintf(stderr, "cannot read baselines: %s\n", argv[1]);
+        return 1;
+    }
+
+    const std::vector<Case> measured = run_cases();
+    if (record) {
+        for (const Case& c : measured) std::printf("%-32s %.1f\n", c.name, c.ns);
+        return 0;
+    }
+
+    const double slack = env_slack();
+    int failures = 0;
+    for (const Case& c : measured) {
+        const double* ref = base.find(c.name);
+        if (!ref) {
+            std::printf("FAIL %-32s %8.1f ns  (no baseline)\n", c.name, c.ns);
+            ++failures;
+            continue;
+        }
+        const double budget = std::fmax(*ref * base.tolerance, *ref + base.floor_ns) * slack;
+        const bool ok = c.ns <= budget;
+        std::printf("%s %-32s %8.1f ns  (baseline %.1f, budget %.1f)\n", ok ? "ok  " : "FAIL", c.name, c.ns, *ref,
+                    budget);
+        if (!ok) ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
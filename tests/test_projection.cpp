@@ -0,0 +1,282 @@
+// tests/test_projection.cpp
+// Projection kernels: outputs are certified members of their set, match
+// the closed-form projection, leave members unchanged, fail closed on
+// non-finite input; Dykstra intersections certify; Project mode with a
+// certified kernel evaluates the predicate once (the proposal only).
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <random>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/projection.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Vec = std::vector<double>;
+
+static Vec random_vec(std::mt19937& rng, std::size_t n, double scale) {
+    std::normal_distribution<double> g(0.0, 1.0);
+    Vec v(n);
+    for (double& x : v) x = scale * g(rng);
+    return v;
+}
+
+static double dist(const Vec& a, const Vec& b) {
+    double s = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) s += (a[i] - b[i]) * (a[i] - b[i]);
+    return std::sqrt(s);
+}
+
+static Vec next_of(const Vec& S, const Vec& dS) {
+    Vec x(S.size());
+    for (std::size_t i = 0; i < S.size(); ++i) x[i] = S[i] + dS[i];
+    return x;
+}
+
+template <class Set>
+static void require_certified(const Set& set, const Vec& S, const Vec& in, Vec& out) {
+    bool certified = false;
+    out.assign(in.size(), 0.0);
+    REQUIRE(set.project(S.data(), in.data(), out.data(), in.size(), certified));
+    REQUIRE(certified && set.admits(S.data(), out.data(), out.size()));
+}
+
+static void test_l2_ball() {
+    std::mt19937 rng(7);
+    const ase::proj::L2Ball ball{1.0};
+    Vec out;
+    int boundary = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        const std::size_t n = 1 + rng() % 300;
+        const Vec S = random_vec(rng, n, 0.3 / std::sqrt(static_cast<double>(n)));
+        const Vec in = random_vec(rng, n, (trial % 3 == 0 ? 0.01 : 2.0) / std::sqrt(static_cast<double>(n)));
+        require_certified(ball, S, in, out);
+
+        if (ball.admits(S.data(), in.data(), n)) {
+            REQUIRE(out == in);
+            continue;
+        }
+        // Radial: next = c · (S + in), on the sphere
+        const Vec y = next_of(S, in);
+        const Vec x = next_of(S, out);
+        const double c = 1.0 / std::sqrt(ase::vec::sum_squares(y.data(), n));
+        for (std::size_t i = 0; i < n; ++i) REQUIRE(std::fabs(x[i] - c * y[i]) <= 1e-12);
+        REQUIRE(std::fabs(ase::vec::l2_norm(x.data(), n) - 1.0) <= 1e-12);
+        ++boundary;
+    }
+    REQUIRE(boundary > 100);
+
+    // R = 0: next is exactly the origin
+    const ase::proj::L2Ball point{0.0};
+    const Vec S{0.1, -0.2, 0.3};
+    require_certified(point, S, Vec{1.0, 2.0, 3.0}, out);
+    REQUIRE(next_of(S, out) == Vec(3, 0.0));
+
+    bool certified = true;
+    const Vec bad{NAN, 0.0, 0.0};
+    REQUIRE(!ball.project(S.data(), bad.data(), out.data(), 3, certified) && !certified);
+    REQUIRE(!ase::proj::L2Ball{-1.0}.project(S.data(), S.data(), out.data(), 3, certified));
+}
+
+static void test_boxes() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    Vec out;
+    for (int trial = 0; trial < 200; ++trial) {
+        const std::size_t n = 1 + rng() % 100;
+        Vec lo(n), hi(n), S(n), in(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            lo[i] = -0.5 + 0.1 * u(rng);
+            hi[i] = 0.5 + 0.1 * u(rng);
+            if (i % 7 == 3) hi[i] = HUGE_VAL;
+            S[i] = 0.3 * u(rng) + 1e-17 * (trial % 5); // awkward roundings
+            in[i] = 1.5 * u(rng);
+        }
+
+        const ase::proj::Box box{lo.data(), hi.data()};
+        require_certified(box, S, in, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double v = S[i] + in[i];
+            const double x = S[i] + out[i];
+            if (lo[i] <= v && v <= hi[i]) REQUIRE(out[i] == in[i]);
+            else REQUIRE(std::fabs(x - (v < lo[i] ? lo[i] : hi[i])) <= 1e-15);
+        }
+
+        const ase::proj::LinfBall linf{0.25};
+        require_certified(linf, S, in, out);
+        REQUIRE(ase::vec::linf_norm(next_of(S, out).data(), n) <= 0.25);
+    }
+
+    // Empty box, non-finite input
+    const Vec lo{1.0}, hi{0.0}, S{0.0}, in{0.5}, nan{NAN};
+    bool certified = true;
+    out.assign(1, 0.0);
+    REQUIRE(!ase::proj::Box{lo.data(), hi.data()}.project(S.data(), in.data(), out.data(), 1, certified));
+    REQUIRE(!ase::proj::LinfBall{1.0}.project(S.data(), nan.data(), out.data(), 1, certified));
+}
+
+static void test_sign_prefix() {
+    std::mt19937 rng(13);
+    Vec out;
+    for (int trial = 0; trial < 100; ++trial) {
+        const std::size_t n = 8 + rng() % 64;
+        const std::size_t k = rng() % (n + 1);
+        const Vec S = random_vec(rng, n, 0.1);
+        const Vec in = random_vec(rng, n, 0.5);
+        const double eps = (trial % 2) ? 1e-3 : 0.0;
+
+        const ase::proj::SignPrefix sp{k, eps};
+        require_certified(sp, S, in, out);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double v = S[i] + in[i];
+            if (i >= k || v >= -eps) REQUIRE(out[i] == in[i]);
+            else REQUIRE(std::fabs(S[i] + out[i] + eps) <= 1e-15);
+        }
+    }
+    const Vec S(4, 0.0);
+    bool certified = true;
+    out.assign(4, 0.0);
+    REQUIRE(!ase::proj::SignPrefix{5}.project(S.data(), S.data(), out.data(), 4, certified));
+    REQUIRE(!ase::proj::SignPrefix{5}.admits(S.data(), S.data(), 4));
+}
+
+static void test_simplex() {
+    std::mt19937 rng(17);
+    Vec out, work;
+    for (int trial = 0; trial < 200; ++trial) {
+        const std::size_t n = 1 + rng() % 200;
+        work.resize(n);
+        const Vec S = random_vec(rng, n, 0.1);
+        const Vec in = random_vec(rng, n, 1.0);
+        const double total = 1.0 + (trial % 3);
+
+        const ase::proj::Simplex simplex{total, 1e-12 * static_cast<double>(n), work.data()};
+        require_certified(simplex, S, in, out);
+
+        // KKT of the projection: x = max(y - τ, 0) for one τ
+        const Vec y = next_of(S, in);
+        const Vec x = next_of(S, out);
+        double tau = NAN;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (x[i] > 1e-9) tau = y[i] - x[i];
+        }
+        REQUIRE(std::isfinite(tau));
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(x[i] >= 0.0);
+            if (x[i] > 1e-9) REQUIRE(std::fabs(y[i] - x[i] - tau) <= 1e-9);
+            else REQUIRE(y[i] <= tau + 1e-9);
+        }
+    }
+
+    // A member is its own projection (up to the threshold's rounding)
+    const Vec S{0.25, 0.25, 0.25, 0.25}, in{0.1, -0.1, 0.05, -0.05};
+    work.resize(4);
+    const ase::proj::Simplex simplex{1.0, 1e-12, work.data()};
+    require_certified(simplex, S, in, out);
+    REQUIRE(dist(out, in) <= 1e-15);
+
+    bool certified = true;
+    REQUIRE(!ase::proj::Simplex{1.0, 0.0, nullptr}.project(S.data(), in.data(), out.data(), 4, certified));
+    REQUIRE(!ase::proj::Simplex{0.0, 0.0, work.data()}.project(S.data(), in.data(), out.data(), 4, certified));
+}
+
+static void test_dykstra() {
+    std::mt19937 rng(19);
+    Vec out, work;
+    for (int trial = 0; trial < 100; ++trial) {
+        const std::size_t n = 4 + rng() % 100;
+        work.resize(4 * n);
+        const Vec S = random_vec(rng, n, 0.1 / std::sqrt(static_cast<double>(n)));
+        const Vec in = random_vec(rng, n, 3.0 / std::sqrt(static_cast<double>(n)));
+        const std::size_t k = n / 2;
+
+        // v >= 0 on a prefix, norm-bounded: clamp then shrink, exact
+        const auto set = ase::proj::intersect(ase::proj::SignPrefix{k}, ase::proj::L2Ball{1.0}, work.data());
+        require_certified(set, S, in, out);
+
+        Vec clamped = next_of(S, in);
+        for (std::size_t i = 0; i < k; ++i) clamped[i] = clamped[i] < 0.0 ? 0.0 : clamped[i];
+        const double nrm = ase::vec::l2_norm(clamped.data(), n);
+        if (nrm > 1.0) {
+            for (double& c : clamped) c /= nrm;
+        }
+        REQUIRE(dist(next_of(S, out), clamped) <= 1e-9);
+    }
+
+    // Box ∩ ball, nested with a sign prefix: certified after a few rounds
+    const std::size_t n = 16;
+    Vec lo(n, -0.2), hi(n, 0.6), inner(4 * n);
+    work.resize(4 * n);
+    const auto box_ball = ase::proj::intersect(ase::proj::Box{lo.data(), hi.data()}, ase::proj::L2Ball{0.8},
+                                               inner.data(), 64);
+    const auto set = ase::proj::intersect(ase::proj::SignPrefix{4}, box_ball, work.data(), 64);
+    const Vec S(n, 0.0);
+    Vec in(n);
+    for (std::size_t i = 0; i < n; ++i) in[i] = (i % 2 ? 1.0 : -1.0) * (0.1 + 0.05 * static_cast<double>(i));
+    require_certified(set, S, in, out);
+
+    // Far outside: the box, then a radial shrink, certify in one round
+    bool certified = false;
+    const auto one = ase::proj::intersect(ase::proj::Box{lo.data(), hi.data()}, ase::proj::L2Ball{0.8},
+                                          work.data(), 1);
+    const Vec corner(n, 5.0);
+    REQUIRE(one.project(S.data(), corner.data(), out.data(), n, certified) && certified);
+
+    // Empty intersection: an output, never a certificate
+    const Vec far_lo(n, 0.5), far_hi(n, 0.6);
+    const auto empty = ase::proj::intersect(ase::proj::Box{far_lo.data(), far_hi.data()}, ase::proj::L2Ball{0.8},
+                                            work.data());
+    REQUIRE(empty.project(S.data(), corner.data(), out.data(), n, certified) && !certified);
+    REQUIRE(!ase::proj::intersect(ase::proj::L2Ball{1.0}, ase::proj::L2Ball{1.0}, nullptr)
+                 .project(S.data(), corner.data(), out.data(), n, certified));
+}
+
+// Engine wiring: the kernel's set is the admissible set
+static int g_admissible_calls = 0;
+static const ase::proj::L2Ball kBall{1.0};
+
+static bool ball_admissible(const Vec& S, const Vec& dS) {
+    ++g_admissible_calls;
+    return S.size() == dS.size() && kBall.admits(S.data(), dS.data(), S.size());
+}
+
+static Vec neutral_vec() { return Vec{}; }
+
+static bool ball_project(const Vec& S, const Vec& in, Vec& out, bool& certified) {
+    if (S.size() != in.size()) return false;
+    out.resize(in.size());
+    return kBall.project(S.data(), in.data(), out.data(), in.size(), certified);
+}
+
+static void test_engine_certified() {
+    ase::Dependencies<Vec, Vec> deps;
+    deps.is_admissible = &ball_admissible;
+    deps.neutral_step = &neutral_vec;
+    deps.project_step_certified = &ball_project;
+    const ase::Engine<Vec, Vec> eng({ase::Mode::Project}, deps);
+
+    std::mt19937 rng(23);
+    for (int trial = 0; trial < 50; ++trial) {
+        const Vec S = random_vec(rng, 256, 0.02);
+        const Vec in = random_vec(rng, 256, 0.5);
+        g_admissible_calls = 0;
+        const ase::EnforceOutcome<Vec> r = eng.enforce_outcome(S, in);
+        REQUIRE(r.kind == ase::Outcome::Projected && kBall.admits(S.data(), r.step.data(), 256));
+        REQUIRE(g_admissible_calls == 1); // the proposal only
+    }
+}
+
+int main() {
+    test_l2_ball();
+    test_boxes();
+    test_sign_prefix();
+    test_simplex();
+    test_dykstra();
+    test_engine_certified();
+    return 0;
+}
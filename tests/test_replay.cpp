@@ -0,0 +1,256 @@
+// tests/test_replay.cpp
+// Replay log: the content hash is fixed and sensitive to every byte;
+// recorded decisions read back exactly; the ring keeps the newest records,
+// reopening continues it, and a file that is not a log of that capacity is
+// refused and left intact; concurrent appends lose nothing; verify re-runs
+// Engine and flags changed inputs and changed decisions.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib> // std::abort
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/replay.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Vec = std::vector<double>;
+
+static std::uint64_t hash_vec(const Vec& v) { return ase::replay::hash_doubles(v.data(), v.size()); }
+
+static bool admissible_ball(const Vec& S, const Vec& dS) {
+    if (S.size() != dS.size()) return false;
+    double sq = 0.0;
+    for (std::size_t i = 0; i < S.size(); ++i) sq += (S[i] + dS[i]) * (S[i] + dS[i]);
+    return std::isfinite(sq) && sq <= 1.0;
+}
+
+static Vec neutral_vec() { return Vec{}; }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) out[i] = k * in[i];
+    return true;
+}
+
+// Inputs of call t, reproducible from (seed, t)
+static void inputs(std::uint32_t t, Vec& S, Vec& dS) {
+    std::mt19937 rng(1000 + t);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    S.resize(64);
+    dS.resize(64);
+    for (double& x : S) x = 0.1 * u(rng);
+    for (double& x : dS) x = (t % 4 == 0 ? 0.01 : 0.3) * u(rng);
+    if (t % 13 == 7) dS[3] = NAN;
+}
+
+static void test_hash() {
+    unsigned char buf[100];
+    for (int i = 0; i < 100; ++i) buf[i] = static_cast<unsigned char>(i * 7 + 1);
+
+    std::vector<std::uint64_t> seen;
+    for (std::size_t len = 0; len <= 100; ++len) {
+        const std::uint64_t h = ase::replay::hash_bytes(buf, len);
+        REQUIRE(h == ase::replay::hash_bytes(buf, len));
+        for (std::uint64_t o : seen) REQUIRE(o != h);
+        seen.push_back(h);
+    }
+    for (std::size_t i = 0; i < 100; ++i) {
+        const std::uint64_t h = ase::replay::hash_bytes(buf, 100);
+        buf[i] ^= 1;
+        REQUIRE(ase::replay::hash_bytes(buf, 100) != h);
+        buf[i] ^= 1;
+    }
+    // -0.0 and 0.0 differ in bits, so in hash
+    const double z[2] = {0.0, -0.0};
+    REQUIRE(ase::replay::hash_doubles(z, 1) != ase::replay::hash_doubles(z + 1, 1));
+}
+
+static void test_record_and_verify(const char* path) {
+    using Eng = ase::Engine<Vec, Vec>;
+    const Eng eng({ase::Mode::Scale, 16, 0.5}, {&admissible_ball, &neutral_vec, &scale_vec, nullptr});
+
+    const std::uint32_t calls = 300;
+    std::vector<ase::EnforceOutcome<Vec>> expected;
+    {
+        ase::ReplayRecorder rec;
+        REQUIRE(rec.open(path, 1024));
+        ase::ScaleHint hint;
+        Vec S, dS;
+        for (std::uint32_t t = 0; t < calls; ++t) {
+            inputs(t, S, dS);
+            const ase::EnforceOutcome<Vec> r = eng.enforce_outcome(S, dS, hint);
+            rec.record(hash_vec(S), hash_vec(dS), r, hash_vec(r.step), hint, t);
+            expected.push_back(r);
+            hint.k = r.kind == ase::Outcome::Scaled ? r.k : 1.0;
+        }
+        REQUIRE(rec.recorded() == calls);
+    }
+
+    ase::ReplayLog log;
+    REQUIRE(log.open(path));
+    REQUIRE(log.capacity() == 1024 && log.first() == 0 && log.end() == calls);
+    int scaled = 0;
+    for (std::uint64_t i = 0; i < calls; ++i) {
+        ase::replay::Record r;
+        REQUIRE(log.read(i, r));
+        REQUIRE(r.seq == i && r.tag == i);
+        REQUIRE(r.kind == expected[i].kind && r.k == expected[i].k && r.attempts == expected[i].attempts);
+        scaled += (r.kind == ase::Outcome::Scaled);
+    }
+    REQUIRE(scaled > 100);
+    ase::replay::Record none;
+    REQUIRE(!log.read(calls, none));
+
+    const auto source = [](const ase::replay::Record& r, Vec& S, Vec& dS) {
+        inputs(r.tag, S, dS);
+        return true;
+    };
+    const ase::replay::VerifyReport ok =
+        ase::replay::verify<Vec, Vec>(log, eng, log.first(), log.end(), source, hash_vec, hash_vec);
+    REQUIRE(ok.ok() && ok.checked == calls && ok.skipped == 0);
+
+    // A different engine (Geometric -> Bisection) is caught
+    const Eng other({ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection}, {&admissible_ball, &neutral_vec, &scale_vec, nullptr});
+    const ase::replay::VerifyReport bad =
+        ase::replay::verify<Vec, Vec>(log, other, log.first(), log.end(), source, hash_vec, hash_vec);
+    REQUIRE(!bad.ok() && bad.decision_mismatches > 0 && bad.input_mismatches == 0);
+
+    // Wrong reproduced inputs are reported as such; missing ones skipped
+    const auto shifted = [](const ase::replay::Record& r, Vec& S, Vec& dS) {
+        if (r.tag == 5) return false;
+        inputs(r.tag == 9 ? 10 : r.tag, S, dS);
+        return true;
+    };
+    const ase::replay::VerifyReport in =
+        ase::replay::verify<Vec, Vec>(log, eng, log.first(), log.end(), shifted, hash_vec, hash_vec);
+    REQUIRE(in.input_mismatches == 1 && in.first_mismatch == 9 && in.skipped == 1 && in.decision_mismatches == 0);
+}
+
+// Whole file content ("" if unreadable)
+static std::string slurp(const char* path) {
+    std::string out;
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) return out;
+    char buf[4096];
+    std::size_t got = 0;
+    while ((got = std::fread(buf, 1, sizeof buf, f)) > 0) out.append(buf, got);
+    std::fclose(f);
+    return out;
+}
+
+static void test_ring_and_reopen(const char* path) {
+    const ase::Decision d{ase::Outcome::Scaled, 0.25, 3};
+    std::remove(path); // fresh: created by open
+    {
+        ase::ReplayRecorder rec;
+        REQUIRE(!rec.open(path, 6)); // not a power of two
+        REQUIRE(rec.open(path, 8));
+        for (std::uint32_t t = 0; t < 20; ++t) rec.record(t, t + 1, d, 0, {}, t);
+    }
+    {
+        ase::ReplayLog log;
+        REQUIRE(log.open(path));
+        REQUIRE(log.first() == 12 && log.end() == 20);
+        ase::replay::Record r;
+        REQUIRE(!log.read(11, r));
+        REQUIRE(log.read(12, r) && r.tag == 12 && r.state_hash == 12 && r.step_hash == 13);
+        REQUIRE(r.kind == ase::Outcome::Scaled && r.k == 0.25 && r.attempts == 3 && r.hint == 1.0);
+    }
+
+    // Same capacity continues after the last record; another one is refused
+    {
+        ase::ReplayRecorder rec;
+        REQUIRE(rec.open(path, 8));
+        REQUIRE(rec.recorded() == 20);
+        rec.record(99, 99, d, 0, {}, 99);
+    }
+    {
+        ase::ReplayLog log;
+        ase::replay::Record r;
+        REQUIRE(log.open(path) && log.end() == 21 && log.read(20, r) && r.tag == 99);
+    }
+    {
+        const std::string before = slurp(path);
+        ase::ReplayRecorder rec;
+        REQUIRE(!rec.open(path, 16) && !rec.is_open());
+        REQUIRE(slurp(path) == before);
+        ase::ReplayLog log;
+        ase::replay::Record r;
+        REQUIRE(log.open(path) && log.end() == 21 && log.read(20, r) && r.tag == 99);
+    }
+    {
+        std::remove(path); // starting over is the host's decision
+        ase::ReplayRecorder rec;
+        REQUIRE(rec.open(path, 16));
+        REQUIRE(rec.recorded() == 0);
+    }
+
+    // Not a log: refused for reading and writing, and left intact
+    std::FILE* f = std::fopen(path, "wb");
+    REQUIRE(f && std::fputs("not a replay log", f) >= 0);
+    std::fclose(f);
+    ase::ReplayLog log;
+    REQUIRE(!log.open(path));
+    REQUIRE(!log.open("/nonexistent/ase/replay.log"));
+    ase::ReplayRecorder unrelated;
+    REQUIRE(!unrelated.open(path, 8) && !unrelated.open(path, 1));
+    REQUIRE(slurp(path) == "not a replay log");
+    std::remove(path);
+
+    // Unopened recorder: record is a no-op
+    ase::ReplayRecorder closed;
+    closed.record(1, 2, d);
+    REQUIRE(closed.recorded() == 0);
+}
+
+static void test_concurrent_appends(const char* path) {
+    std::remove(path);
+    ase::ReplayRecorder rec;
+    REQUIRE(rec.open(path, 1 << 15));
+    const std::uint32_t threads = 4, per = 5000;
+    std::vector<std::thread> pool;
+    for (std::uint32_t w = 0; w < threads; ++w) {
+        pool.emplace_back([&rec, w] {
+            for (std::uint32_t i = 0; i < per; ++i) {
+                rec.record(w, i, ase::Decision{ase::Outcome::PassThrough, 1.0, 0}, 0, {}, w * per + i);
+            }
+        });
+    }
+    for (std::thread& t : pool) t.join();
+    REQUIRE(rec.recorded() == threads * per);
+
+    ase::ReplayLog log;
+    REQUIRE(log.open(path));
+    std::vector<bool> seen(threads * per, false);
+    for (std::uint64_t i = log.first(); i < log.end(); ++i) {
+        ase::replay::Record r;
+        REQUIRE(log.read(i, r));
+        REQUIRE(r.tag == r.state_hash * per + r.step_hash && !seen[r.tag]);
+        seen[r.tag] = true;
+    }
+}
+
+int main() {
+    test_hash();
+#if defined(ASE_HAS_MMAP)
+    char path[] = "/tmp/ase_replay_XXXXXX";
+    const int fd = ::mkstemp(path);
+    REQUIRE(fd >= 0);
+    ::close(fd);
+
+    test_record_and_verify(path);
+    test_ring_and_reopen(path);
+    test_concurrent_appends(path);
+    std::remove(path);
+#endif
+    return 0;
+}
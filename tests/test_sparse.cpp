@@ -0,0 +1,274 @@
+// tests/test_sparse.cpp
+// Sparse steps: the O(nnz) envelope check (cached ||S||^2 plus touched
+// coordinates) agrees with the dense blocked check, Scale mode over sparse
+// views accepts the same k as over dense views, the closed-form L2 limit and
+// the sparse projection yield admissible steps, and apply_step keeps the
+// cached norm current, charges its drift and refreshes it on schedule.
+// Malformed index lists fail closed.
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/sparse.hpp"
+#include "ase/vector_envelope.hpp"
+#include "ase/views.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Vec = std::vector<double>;
+
+static ase::vec::BlockLimits g_lim;
+
+static bool admissible_sparse(const ase::SparseStateView& S, const ase::SparseStepView& dS) {
+    return ase::next_sparse_within(S, dS, g_lim);
+}
+
+static bool admissible_sparse_step(const ase::SparseStateView& S, const ase::SparseStep& dS) {
+    return ase::next_sparse_within(S, dS, g_lim);
+}
+
+static bool solve_sparse(const ase::SparseStateView& S, const ase::SparseStepView& dS, double& k) {
+    return ase::sparse_l2_scale_limit(S, dS, g_lim.l2, k);
+}
+
+static bool project_sparse(const ase::SparseStateView& S, const ase::SparseStep& in, ase::SparseStep& out) {
+    return ase::project_sparse(S, in, g_lim, out);
+}
+
+static bool admissible_dense(const ase::StateView& S, const ase::ScaledStepView& dS) {
+    return ase::next_within_blocked(S, dS, g_lim);
+}
+
+// nnz distinct sorted indices in [0, n)
+static ase::SparseStep random_step(std::mt19937& rng, std::size_t n, std::size_t nnz, double scale) {
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    ase::SparseStep s;
+    s.size = n;
+    const std::size_t stride = n / nnz;
+    for (std::size_t j = 0; j < nnz; ++j) {
+        s.index.push_back(j * stride + rng() % stride);
+        s.value.push_back(scale * u(rng));
+    }
+    return s;
+}
+
+static Vec densify(const ase::SparseStep& s) {
+    Vec d(s.size, 0.0);
+    for (std::size_t j = 0; j < s.nnz(); ++j) d[s.index[j]] = s.value[j];
+    return d;
+}
+
+static Vec random_state(std::mt19937& rng, std::size_t n) {
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    Vec S(n);
+    for (double& x : S) x = 0.01 * u(rng) + 0.01;
+    return S;
+}
+
+static void set_limits() {
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.linf = 0.3;
+    g_lim.step_linf = 0.25;
+    g_lim.sign_prefix = 64;
+}
+
+static void test_matches_dense_check() {
+    set_limits();
+    const std::size_t n = 4000;
+    std::mt19937 rng(3);
+
+    int accepted = 0;
+    for (int trial = 0; trial < 400; ++trial) {
+        const Vec S = random_state(rng, n);
+        const ase::SparseStep dS = random_step(rng, n, 40, (trial % 2) ? 0.3 : 0.1);
+        const Vec dense = densify(dS);
+
+        // Skip the rounding band around the L2 boundary
+        Vec next(n);
+        ase::vec::add_into(S.data(), dense.data(), next.data(), n);
+        if (std::fabs(ase::vec::l2_norm(next.data(), n) - g_lim.l2) < 1e-9) continue;
+
+        const ase::SparseStateView sv = ase::SparseStateView::of(S.data(), n);
+        const bool sparse = ase::next_sparse_within(sv, dS, g_lim);
+        REQUIRE(sparse == ase::vec::next_within_blocked(S.data(), dense.data(), n, g_lim));
+        accepted += sparse;
+    }
+    REQUIRE(accepted > 20 && accepted < 380);
+}
+
+static void test_malformed_fail_closed() {
+    set_limits();
+    const Vec S(100, 0.0);
+    const ase::SparseStateView sv = ase::SparseStateView::of(S.data(), S.size());
+
+    ase::SparseStep ok;
+    ok.size = 100;
+    ok.index = {3, 7};
+    ok.value = {0.1, 0.1};
+    REQUIRE(ase::next_sparse_within(sv, ok, g_lim));
+
+    ase::SparseStep dup = ok;
+    dup.index = {7, 7};
+    REQUIRE(!ase::next_sparse_within(sv, dup, g_lim));
+
+    ase::SparseStep unsorted = ok;
+    unsorted.index = {7, 3};
+    REQUIRE(!ase::next_sparse_within(sv, unsorted, g_lim));
+
+    ase::SparseStep outside = ok;
+    outside.index = {3, 100};
+    REQUIRE(!ase::next_sparse_within(sv, outside, g_lim));
+
+    ase::SparseStep ragged = ok;
+    ragged.value.push_back(0.1);
+    REQUIRE(!ase::next_sparse_within(sv, ragged, g_lim));
+
+    ase::SparseStep wrong_size = ok;
+    wrong_size.size = 99;
+    REQUIRE(!ase::next_sparse_within(sv, wrong_size, g_lim));
+
+    ase::SparseStep nan = ok;
+    nan.value[1] = std::numeric_limits<double>::quiet_NaN();
+    REQUIRE(!ase::next_sparse_within(sv, nan, g_lim));
+
+    Vec state = S;
+    double sum_sq = sv.sum_sq;
+    REQUIRE(!ase::apply_step(unsorted, state.data(), state.size(), &sum_sq));
+    REQUIRE(state == S && sum_sq == 0.0); // nothing written
+
+    // Zero step of any size
+    REQUIRE(ase::next_sparse_within(sv, ase::neutral_sparse(), g_lim));
+    REQUIRE(ase::neutral_sparse_step() == ase::SparseStep{});
+    REQUIRE(ase::neutral_sparse() == (ase::SparseStepView{ok.index.data(), ok.value.data(), 2, 100, 0.0}));
+}
+
+static void test_scale_matches_dense_views() {
+    set_limits();
+    const std::size_t n = 4000;
+    std::mt19937 rng(7);
+
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    ase::Dependencies<ase::SparseStateView, ase::SparseStepView> deps{
+        &admissible_sparse, &ase::neutral_sparse, &ase::scale_sparse, nullptr};
+    const ase::Engine<ase::SparseStateView, ase::SparseStepView> sparse(cfg, deps);
+    deps.solve_scale = &solve_sparse;
+    const ase::Engine<ase::SparseStateView, ase::SparseStepView> solved(cfg, deps);
+    const ase::Engine<ase::StateView, ase::ScaledStepView> dense(
+        cfg, {&admissible_dense, &ase::neutral_view, &ase::scale_view, nullptr});
+
+    int scaled = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        const Vec S = random_state(rng, n);
+        const ase::SparseStep dS = random_step(rng, n, 40, 0.4);
+        const Vec d = densify(dS);
+        const ase::SparseStateView sv = ase::SparseStateView::of(S.data(), n);
+
+        const ase::EnforceOutcome<ase::SparseStepView> a = sparse.enforce_outcome(sv, ase::SparseStepView::of(dS));
+        const ase::EnforceOutcome<ase::ScaledStepView> b =
+            dense.enforce_outcome({S.data(), n}, ase::ScaledStepView::of({d.data(), n}));
+        REQUIRE(a.kind == b.kind && a.k == b.k && a.attempts == b.attempts);
+        REQUIRE(a.step.is_zero() || (a.step.index == dS.index.data() && a.step.k == b.step.k));
+        scaled += (a.kind == ase::Outcome::Scaled);
+
+        // Closed-form limit: admissible, at least the geometric k
+        const ase::EnforceOutcome<ase::SparseStepView> c = solved.enforce_outcome(sv, ase::SparseStepView::of(dS));
+        REQUIRE(c.kind == a.kind);
+        REQUIRE(c.step.is_zero() || admissible_sparse(sv, c.step));
+        REQUIRE(c.kind != ase::Outcome::Scaled || c.k >= a.k);
+    }
+    REQUIRE(scaled > 20);
+}
+
+static void test_project_and_apply() {
+    set_limits();
+    const std::size_t n = 4000;
+    std::mt19937 rng(9);
+
+    const ase::Engine<ase::SparseStateView, ase::SparseStep> eng(
+        {ase::Mode::Project},
+        {&admissible_sparse_step, &ase::neutral_sparse_step, &ase::scale_sparse_step, &project_sparse});
+
+    Vec S = random_state(rng, n);
+    double sum_sq = ase::vec::sum_squares(S.data(), n);
+    int projected = 0;
+    for (int t = 0; t < 300; ++t) {
+        const ase::SparseStep dS = random_step(rng, n, 25, 0.5);
+        const ase::SparseStateView sv{S.data(), n, sum_sq};
+
+        const ase::EnforceOutcome<ase::SparseStep> r = eng.enforce_outcome(sv, dS);
+        REQUIRE(r.kind != ase::Outcome::Neutral);
+        REQUIRE(r.step.index == dS.index); // sparsity pattern kept
+        REQUIRE(admissible_sparse_step(sv, r.step));
+        projected += (r.kind == ase::Outcome::Projected);
+
+        REQUIRE(ase::apply_step(r.step, S.data(), n, &sum_sq));
+    }
+    REQUIRE(projected > 100);
+
+    // Incremental norm stays in step with a full recomputation
+    const double exact = ase::vec::sum_squares(S.data(), n);
+    REQUIRE(std::fabs(sum_sq - exact) <= 1e-12 * exact);
+    REQUIRE(ase::vec::within_blocked(S.data(), n, g_lim));
+}
+
+// The L2 test is conservative in the cached norm's drift; the view overload
+// of apply_step grows the drift bound and recomputes the cache on schedule
+static void test_drift_and_refresh() {
+    set_limits();
+    const std::size_t n = 4000;
+
+    // ||S|| == l2 exactly: rounding of the cache cannot be ruled out
+    Vec edge(n, 0.0);
+    for (std::size_t i = 0; i < 16; ++i) edge[i] = 0.25;
+    const ase::SparseStateView ev = ase::SparseStateView::of(edge.data(), n);
+    REQUIRE(ev.sum_sq == 1.0 && ev.sum_sq_err > 0.0);
+    REQUIRE(!ase::next_sparse_within(ev, ase::neutral_sparse(), g_lim));
+    g_lim.l2 = 1.0 + 1e-9;
+    REQUIRE(ase::next_sparse_within(ev, ase::neutral_sparse(), g_lim));
+    set_limits();
+
+    // A drift bound as large as the ball rejects what a fresh cache admits
+    std::mt19937 rng(11);
+    Vec S = random_state(rng, n);
+    const ase::SparseStep small = random_step(rng, n, 20, 0.01);
+    ase::SparseStateView sv = ase::SparseStateView::of(S.data(), n);
+    REQUIRE(ase::next_sparse_within(sv, small, g_lim));
+    ase::SparseStateView drifted = sv;
+    drifted.sum_sq_err = 1.0;
+    REQUIRE(!ase::next_sparse_within(drifted, small, g_lim));
+
+    ase::SparseStep back = small;
+    for (double& v : back.value) v = -v;
+    Vec other = S;
+    REQUIRE(!ase::apply_step(small, other.data(), sv)); // not the view's storage
+    REQUIRE(sv.applies == 0);
+
+    for (std::size_t t = 1; t < ase::kSparseRefreshApplies; ++t) {
+        const double err = sv.sum_sq_err;
+        REQUIRE(ase::apply_step((t % 2) ? small : back, S.data(), sv));
+        REQUIRE(sv.applies == t && sv.sum_sq_err > err);
+        REQUIRE(std::fabs(sv.sum_sq - ase::vec::sum_squares(S.data(), n)) <= sv.sum_sq_err +
+                ase::vec::sum_squares_err(sv.sum_sq, n));
+    }
+    REQUIRE(ase::apply_step(small, S.data(), sv));
+    REQUIRE(sv.applies == 0);
+    REQUIRE(sv.sum_sq == ase::vec::sum_squares(S.data(), n));
+    REQUIRE(sv.sum_sq_err == ase::vec::sum_squares_err(sv.sum_sq, n));
+}
+
+int main() {
+    test_matches_dense_check();
+    test_malformed_fail_closed();
+    test_scale_matches_dense_views();
+    test_project_and_apply();
+    test_drift_and_refresh();
+    return 0;
+}
@@ -0,0 +1,186 @@
+// tests/test_static_engine.cpp
+// StaticEngine (compile-time hooks) must be output-identical to Engine
+// (function-pointer hooks) for the same Config, and fail closed the same way;
+// a compile-time StaticConfig gives the same outputs as its runtime Config.
+#include <cmath>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <ratio>
+
+#include "ase/ase.hpp"
+#include "ase/static_engine.hpp"
+
+static bool is_finite(double x) { return std::isfinite(x); }
+
+static bool admissible_limit(const double& S, const double& dS) {
+    if (!is_finite(S) || !is_finite(dS)) return false;
+    const double next = S + dS;
+    if (!is_finite(next)) return false;
+    return std::fabs(next) <= 1.0;
+}
+
+static double neutral_zero() { return 0.0; }
+
+static bool scale_mul(const double& in, double k, double& out) {
+    if (!is_finite(in) || !is_finite(k)) return false;
+    out = in * k;
+    return is_finite(out);
+}
+
+static bool project_clamp(const double& S, const double& dS, double& out) {
+    if (!is_finite(S) || !is_finite(dS)) return false;
+    double next = S + dS;
+    if (!is_finite(next)) return false;
+    if (next >  1.0) next =  1.0;
+    if (next < -1.0) next = -1.0;
+    out = next - S;
+    return is_finite(out);
+}
+
+struct ScalarPolicy {
+    static bool is_admissible(const double& S, const double& dS) { return admissible_limit(S, dS); }
+    static double neutral_step() { return neutral_zero(); }
+    static bool scale_step(const double& in, double k, double& out) { return scale_mul(in, k, out); }
+    static bool project_step(const double& S, const double& dS, double& out) { return project_clamp(S, dS, out); }
+};
+
+// Only mandatory hooks: Scale/Project must fail closed to neutral.
+struct RejectOnlyPolicy {
+    static bool is_admissible(const double& S, const double& dS) { return admissible_limit(S, dS); }
+    static double neutral_step() { return neutral_zero(); }
+};
+
+struct ThrowingPolicy {
+    static bool is_admissible(const double&, const double&) { throw 1; }
+    static double neutral_step() { return neutral_zero(); }
+    static bool scale_step(const double& in, double k, double& out) { return scale_mul(in, k, out); }
+};
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool same(double a, double b) {
+    return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+static const double kInputs[] = {
+    -2.0, -1.0, -0.9, -0.5, -0.1, 0.0, 0.1, 0.5, 0.9, 1.0, 2.0, 1e300,
+    std::numeric_limits<double>::infinity(),
+    std::numeric_limits<double>::quiet_NaN()
+};
+
+static void test_matches_function_pointer_engine() {
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 4, 1.0},
+        {ase::Mode::Scale, 0, 0.5},
+        {ase::Mode::Scale, 16, 0.5, ase::ScaleSearch::Bisection, 1e-3},
+        {ase::Mode::Scale, 5, 0.5, ase::ScaleSearch::Bisection, 0.0},
+        {ase::Mode::Project},
+    };
+
+    ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, &project_clamp
+    };
+
+    for (const ase::Config& cfg : cfgs) {
+        const ase::Engine<double, double> ref(cfg, deps);
+        const ase::StaticEngine<double, double, ScalarPolicy> eng(cfg);
+
+        for (double S : kInputs) {
+            for (double dS : kInputs) {
+                REQUIRE(same(eng.enforce(S, dS), ref.enforce(S, dS)));
+            }
+        }
+    }
+}
+
+static void test_lambda_hooks() {
+    const auto hooks = ase::make_hooks(
+        [](const double& S, const double& dS) { return admissible_limit(S, dS); },
+        [] { return 0.0; },
+        [](const double& in, double k, double& out) { return scale_mul(in, k, out); });
+
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::StaticEngine<double, double, decltype(hooks)> eng(cfg, hooks);
+
+    const double eff = eng.enforce(0.9, 0.5);
+    REQUIRE(eff == 0.0625);
+    REQUIRE(admissible_limit(0.9, eff));
+
+    // No project hook bound => Project mode fails closed
+    const ase::StaticEngine<double, double, decltype(hooks)> proj({ase::Mode::Project}, hooks);
+    REQUIRE(proj.enforce(0.9, 0.5) == 0.0);
+    REQUIRE(proj.enforce(0.0, 0.5) == 0.5);
+}
+
+static void test_missing_optional_hooks_fail_closed() {
+    const ase::StaticEngine<double, double, RejectOnlyPolicy> scale({ase::Mode::Scale, 16, 0.5});
+    const ase::StaticEngine<double, double, RejectOnlyPolicy> proj({ase::Mode::Project});
+
+    REQUIRE(scale.enforce(0.9, 0.5) == 0.0);
+    REQUIRE(proj.enforce(0.9, 0.5) == 0.0);
+    REQUIRE(scale.enforce(0.0, 0.5) == 0.5);
+}
+
+static void test_exception_fail_closed() {
+    const ase::StaticEngine<double, double, ThrowingPolicy> eng({ase::Mode::Scale, 16, 0.5});
+    REQUIRE(eng.enforce(0.0, 0.5) == 0.0);
+}
+
+using Geometric16 = ase::StaticConfig<ase::Mode::Scale, 16>;
+static_assert(Geometric16::scale_factor == 0.5 && Geometric16::scale_tolerance == 1e-3, "defaults of Config");
+static_assert(Geometric16::scale_grid()[0] == 1.0 && Geometric16::scale_grid()[4] == 0.0625, "k = f^j");
+static_assert(ase::StaticConfig<ase::Mode::Project>::config().mode == ase::Mode::Project, "runtime equivalent");
+
+template <class Cfg>
+static void require_matches_runtime() {
+    const ase::StaticEngine<double, double, ScalarPolicy, Cfg> eng;
+    const ase::StaticEngine<double, double, ScalarPolicy> ref(Cfg::config());
+    for (double S : kInputs) {
+        for (double dS : kInputs) {
+            REQUIRE(same(eng.enforce(S, dS), ref.enforce(S, dS)));
+        }
+    }
+}
+
+static void test_static_config() {
+    using ase::Mode;
+    using ase::ScaleSearch;
+    require_matches_runtime<ase::StaticConfig<Mode::Reject>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 16>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 4, std::ratio<1>>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 0>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 40, std::ratio<3, 4>>>(); // not unrolled
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 16, std::ratio<1, 2>, ScaleSearch::Bisection>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Scale, 5, std::ratio<1, 2>, ScaleSearch::Bisection, std::ratio<0>>>();
+    require_matches_runtime<ase::StaticConfig<Mode::Project>>();
+
+    // Grid values are those of the runtime search, bit for bit
+    using Cfg = ase::StaticConfig<Mode::Scale, 40, std::ratio<9, 10>>;
+    double k = 1.0;
+    for (double g : Cfg::scale_grid()) {
+        REQUIRE(g == k);
+        k *= Cfg::scale_factor;
+    }
+
+    // No stored Config; missing hooks still fail closed
+    const ase::StaticEngine<double, double, RejectOnlyPolicy, Geometric16> scale;
+    const ase::StaticEngine<double, double, ThrowingPolicy, Geometric16> throwing;
+    static_assert(sizeof(scale) == sizeof(RejectOnlyPolicy), "StaticConfig is not stored");
+    REQUIRE(scale.enforce(0.9, 0.5) == 0.0);
+    REQUIRE(scale.enforce(0.0, 0.5) == 0.5);
+    REQUIRE(throwing.enforce(0.0, 0.5) == 0.0);
+}
+
+int main() {
+    test_matches_function_pointer_engine();
+    test_lambda_hooks();
+    test_missing_optional_hooks_fail_closed();
+    test_exception_fail_closed();
+    test_static_config();
+    return 0;
+}
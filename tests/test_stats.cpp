@@ -0,0 +1,173 @@
+// tests/test_stats.cpp
+// Enforcement telemetry: per-outcome counters, scale-attempt histogram,
+// hook-failure counts; outputs identical with and without a stats sink;
+// per-thread shards aggregate exactly under concurrency.
+#include <cmath>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/stats.hpp"
+
+static bool is_finite(double x) { return std::isfinite(x); }
+
+static bool admissible_limit(const double& S, const double& dS) {
+    if (!is_finite(S) || !is_finite(dS)) return false;
+    const double next = S + dS;
+    if (!is_finite(next)) return false;
+    return std::fabs(next) <= 1.0;
+}
+
+static bool admissible_throws(const double& S, const double& dS) {
+    if (dS > 0.7) throw 1;
+    return admissible_limit(S, dS);
+}
+
+static double neutral_zero() { return 0.0; }
+
+static bool scale_mul(const double& in, double k, double& out) {
+    if (!is_finite(in) || !is_finite(k)) return false;
+    out = in * k;
+    return is_finite(out);
+}
+
+static bool project_fails(const double&, const double&, double&) {
+    return false;
+}
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+using Stats = ase::ShardedStats<>;
+using StatsEngine = ase::Engine<double, double, ase::NoContext, Stats>;
+
+static void test_outcome_counters_and_histogram() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, nullptr
+    };
+
+    Stats stats;
+    const StatsEngine eng(cfg, deps, &stats);
+
+    REQUIRE(eng.enforce(0.0, 0.2) == 0.2);      // pass-through
+    REQUIRE(eng.enforce(0.9, 0.5) == 0.0625);   // scaled after 4 attempts (k = 1, .5, .25, .125)
+    REQUIRE(eng.enforce(0.0, std::numeric_limits<double>::quiet_NaN()) == 0.0); // neutral, transform failure
+
+    const ase::StatsSnapshot snap = stats.snapshot();
+    REQUIRE(snap.pass_through == 1);
+    REQUIRE(snap.scaled == 1);
+    REQUIRE(snap.neutral == 1);
+    REQUIRE(snap.projected == 0);
+    REQUIRE(snap.total() == 3);
+    REQUIRE(snap.scale_attempts[4] == 1);
+    REQUIRE(snap.scale_attempts[1] == 1); // NaN: scale_step fails on the first attempt
+    REQUIRE(snap.transform_failures == 1);
+    REQUIRE(snap.hook_exceptions == 0);
+}
+
+static void test_hook_failures() {
+    Stats stats;
+
+    // Exception from the predicate
+    const ase::Dependencies<double, double> throwing{
+        &admissible_throws, &neutral_zero, &scale_mul, nullptr
+    };
+    const StatsEngine a({ase::Mode::Scale, 16, 0.5}, throwing, &stats);
+    REQUIRE(a.enforce(0.0, 0.9) == 0.0);
+
+    // Projection reports no output
+    const ase::Dependencies<double, double> bad_project{
+        &admissible_limit, &neutral_zero, nullptr, &project_fails
+    };
+    const StatsEngine b({ase::Mode::Project}, bad_project, &stats);
+    REQUIRE(b.enforce(0.9, 0.5) == 0.0);
+
+    // Critical hook missing
+    const ase::Dependencies<double, double> missing{};
+    const StatsEngine c({ase::Mode::Reject}, missing, &stats);
+    REQUIRE(c.enforce(0.0, 0.1) == 0.0);
+
+    const ase::StatsSnapshot snap = stats.snapshot();
+    REQUIRE(snap.hook_exceptions == 1);
+    REQUIRE(snap.transform_failures == 1);
+    REQUIRE(snap.missing_hooks == 1);
+    REQUIRE(snap.neutral == 3);
+}
+
+static void test_outputs_unchanged_and_all_entry_points() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, nullptr
+    };
+
+    Stats stats;
+    const ase::Engine<double, double> plain(cfg, deps);
+    const StatsEngine counted(cfg, deps, &stats);
+    const StatsEngine no_sink(cfg, deps); // null sink pointer => no counting
+
+    const double inputs[] = {-0.9, 0.0, 0.2, 0.5, 0.9, 1.5};
+    double S[6];
+    double dS[6];
+    std::size_t n = 0;
+    for (double a : inputs) {
+        for (double b : inputs) {
+            REQUIRE(counted.enforce(a, b) == plain.enforce(a, b));
+            REQUIRE(no_sink.enforce(a, b) == plain.enforce(a, b));
+        }
+        S[n] = a;
+        dS[n] = 0.5;
+        ++n;
+    }
+
+    ase::Scratch<double> scratch;
+    double out = 0.0;
+    counted.enforce_into(0.9, 0.5, out, scratch);
+
+    double batch[6];
+    counted.enforce_batch(S, dS, batch, n);
+
+    REQUIRE(stats.snapshot().total() == 36 + 1 + 6);
+}
+
+static void test_concurrent_shards() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{
+        &admissible_limit, &neutral_zero, &scale_mul, nullptr
+    };
+
+    // Fewer shards than threads: shared shards must still count exactly
+    ase::ShardedStats<2> stats;
+    const ase::Engine<double, double, ase::NoContext, ase::ShardedStats<2>> eng(cfg, deps, &stats);
+
+    constexpr int kThreads = 4;
+    constexpr int kCalls = 5000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&eng] {
+            for (int i = 0; i < kCalls; ++i) {
+                (void)eng.enforce(0.0, 0.2); // pass-through
+                (void)eng.enforce(0.9, 0.5); // scaled
+            }
+        });
+    }
+    for (std::thread& th : threads) th.join();
+
+    const ase::StatsSnapshot snap = stats.snapshot();
+    REQUIRE(snap.pass_through == static_cast<std::uint64_t>(kThreads) * kCalls);
+    REQUIRE(snap.scaled == static_cast<std::uint64_t>(kThreads) * kCalls);
+    REQUIRE(snap.scale_attempts[4] == static_cast<std::uint64_t>(kThreads) * kCalls);
+}
+
+int main() {
+    test_outcome_counters_and_histogram();
+    test_hook_failures();
+    test_outputs_unchanged_and_all_entry_points();
+    test_concurrent_shards();
+    return 0;
+}
@@ -0,0 +1,222 @@
+// tests/test_trace.cpp
+// Hook-call tracing: every hook call is bracketed begin/end with its attempt
+// index (also when the hook throws); outputs identical with and without a
+// tracer; a trace-free Engine keeps its layout; TraceRing records
+// concurrently, keeps the newest events and writes Chrome trace JSON.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/trace.hpp"
+
+static bool is_finite(double x) { return std::isfinite(x); }
+
+static bool admissible_limit(const double& S, const double& dS) {
+    if (!is_finite(S) || !is_finite(dS)) return false;
+    const double next = S + dS;
+    if (!is_finite(next)) return false;
+    return std::fabs(next) <= 1.0;
+}
+
+static bool admissible_throws(const double& S, const double& dS) {
+    if (dS > 0.7) throw 1;
+    return admissible_limit(S, dS);
+}
+
+static double neutral_zero() { return 0.0; }
+
+static bool scale_mul(const double& in, double k, double& out) {
+    if (!is_finite(in) || !is_finite(k)) return false;
+    out = in * k;
+    return is_finite(out);
+}
+
+static bool project_clamp(const double& S, const double& in, double& out) {
+    const double next = std::fmin(1.0, std::fmax(-1.0, S + in));
+    out = next - S;
+    return is_finite(out);
+}
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+struct RecordingTracer;
+
+// NullTracer adds no state: a real tracer costs exactly its pointer
+static_assert(sizeof(ase::Engine<double, double, ase::NoContext, ase::NullStats, RecordingTracer>) ==
+                  sizeof(ase::Engine<double, double>) + sizeof(RecordingTracer*),
+              "NullTracer must not add state");
+
+struct Call {
+    ase::Hook hook;
+    bool begin;
+    std::size_t attempt;
+};
+
+struct RecordingTracer {
+    std::vector<Call> calls;
+
+    void on_hook_begin(ase::Hook h, std::size_t attempt) noexcept { calls.push_back({h, true, attempt}); }
+    void on_hook_end(ase::Hook h, std::size_t attempt) noexcept { calls.push_back({h, false, attempt}); }
+
+    // Every begin is closed by the matching end before the next call starts
+    bool balanced() const {
+        if (calls.size() % 2 != 0) return false;
+        for (std::size_t i = 0; i < calls.size(); i += 2) {
+            const Call& b = calls[i];
+            const Call& e = calls[i + 1];
+            if (!b.begin || e.begin || b.hook != e.hook || b.attempt != e.attempt) return false;
+        }
+        return true;
+    }
+};
+
+using TracedEngine = ase::Engine<double, double, ase::NoContext, ase::NullStats, RecordingTracer>;
+
+static void test_scale_sequence() {
+    const ase::Config cfg{ase::Mode::Scale, 16, 0.5};
+    const ase::Dependencies<double, double> deps{&admissible_limit, &neutral_zero, &scale_mul, nullptr};
+
+    RecordingTracer tr;
+    const TracedEngine eng(cfg, deps, nullptr, &tr);
+    const ase::Engine<double, double> plain(cfg, deps);
+
+    // The neutral step is built once, at construction
+    REQUIRE(tr.calls.size() == 2 && tr.calls[0].hook == ase::Hook::NeutralStep);
+    tr.calls.clear();
+
+    // proposal, then candidates k = 1, .5, .25, .125
+    REQUIRE(eng.enforce(0.9, 0.5) == plain.enforce(0.9, 0.5));
+    REQUIRE(tr.balanced());
+
+    const ase::Hook seq[] = {ase::Hook::IsAdmissible, ase::Hook::ScaleStep, ase::Hook::IsAdmissible,
+                             ase::Hook::ScaleStep, ase::Hook::IsAdmissible, ase::Hook::ScaleStep,
+                             ase::Hook::IsAdmissible, ase::Hook::ScaleStep, ase::Hook::IsAdmissible};
+    const std::size_t attempt[] = {0, 1, 1, 2, 2, 3, 3, 4, 4};
+    REQUIRE(tr.calls.size() == 2 * 9);
+    for (std::size_t i = 0; i < 9; ++i) {
+        REQUIRE(tr.calls[2 * i].hook == seq[i]);
+        REQUIRE(tr.calls[2 * i].attempt == attempt[i]);
+    }
+
+    // Neutral outcome: the cached neutral step, no further hook call
+    tr.calls.clear();
+    REQUIRE(eng.enforce(0.0, std::numeric_limits<double>::quiet_NaN()) == 0.0);
+    REQUIRE(tr.balanced() && !tr.calls.empty());
+    for (const Call& c : tr.calls) REQUIRE(c.hook != ase::Hook::NeutralStep);
+
+    // No tracer attached => nothing recorded, same outputs
+    tr.calls.clear();
+    const TracedEngine detached(cfg, deps);
+    for (double d : {0.1, 0.5, 2.0, -3.0}) {
+        REQUIRE(detached.enforce(0.9, d) == plain.enforce(0.9, d));
+    }
+    REQUIRE(tr.calls.empty());
+}
+
+static void test_project_and_throw() {
+    RecordingTracer tr;
+
+    const TracedEngine proj({ase::Mode::Project},
+                            {&admissible_limit, &neutral_zero, nullptr, &project_clamp}, nullptr, &tr);
+    tr.calls.clear();
+    REQUIRE(proj.enforce(0.5, 1.0) == 0.5);
+    REQUIRE(tr.balanced());
+    REQUIRE(tr.calls.size() == 2 * 3); // predicate, project_step, predicate
+    REQUIRE(tr.calls[2].hook == ase::Hook::ProjectStep);
+
+    // A throwing predicate still gets its end event
+    const TracedEngine thr({ase::Mode::Scale, 16, 0.5},
+                           {&admissible_throws, &neutral_zero, &scale_mul, nullptr}, nullptr, &tr);
+    tr.calls.clear();
+    REQUIRE(thr.enforce(0.0, 0.9) == 0.0);
+    REQUIRE(tr.balanced());
+    REQUIRE(tr.calls.size() == 2 && tr.calls[0].hook == ase::Hook::IsAdmissible);
+}
+
+using Ring = ase::TraceRing<1024>;
+using RingEngine = ase::Engine<double, double, ase::NoContext, ase::NullStats, Ring>;
+
+static Ring g_ring;
+
+static void test_ring_concurrent() {
+    const RingEngine eng({ase::Mode::Reject}, {&admissible_limit, &neutral_zero, nullptr, nullptr},
+                         nullptr, &g_ring);
+    g_ring.clear(); // drop the construction-time neutral_step call
+
+    constexpr int kThreads = 4;
+    constexpr int kCalls = 100; // pass-through => one hook call => 2 events
+    std::vector<std::thread> pool;
+    for (int t = 0; t < kThreads; ++t) {
+        pool.emplace_back([&] {
+            for (int i = 0; i < kCalls; ++i) REQUIRE(eng.enforce(0.0, 0.1) == 0.1);
+        });
+    }
+    for (std::thread& th : pool) th.join();
+
+    REQUIRE(g_ring.recorded() == 2u * kThreads * kCalls);
+
+    std::vector<ase::trace::Event> ev(1024);
+    const std::size_t n = g_ring.snapshot(ev.data(), ev.size());
+    REQUIRE(n == 2u * kThreads * kCalls);
+
+    // Per thread: alternating begin / end with non-decreasing timestamps
+    std::vector<int> depth(64, 0);
+    std::vector<std::uint64_t> last(64, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const ase::trace::Event& e = ev[i];
+        REQUIRE(e.thread < 64 && e.hook == ase::Hook::IsAdmissible && e.attempt == 0);
+        REQUIRE(e.ticks >= last[e.thread]);
+        last[e.thread] = e.ticks;
+        depth[e.thread] += (e.phase == ase::trace::Phase::Begin) ? 1 : -1;
+        REQUIRE(depth[e.thread] == 0 || depth[e.thread] == 1);
+    }
+}
+
+static void test_ring_overwrite_and_json() {
+    const RingEngine eng({ase::Mode::Scale, 16, 0.5}, {&admissible_limit, &neutral_zero, &scale_mul, nullptr},
+                         nullptr, &g_ring);
+    g_ring.clear();
+
+    for (int i = 0; i < 1000; ++i) eng.enforce(0.9, 0.5); // 18 events each
+    REQUIRE(g_ring.recorded() == 18000u);
+
+    std::vector<ase::trace::Event> ev(2048);
+    REQUIRE(g_ring.snapshot(ev.data(), ev.size()) == 1024); // newest Capacity kept
+
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    REQUIRE(g_ring.write_chrome_json(f));
+
+    std::rewind(f);
+    std::string json;
+    char buf[4096];
+    for (std::size_t r; (r = std::fread(buf, 1, sizeof buf, f)) > 0;) json.append(buf, r);
+    std::fclose(f);
+
+    const auto count = [&](const char* needle) {
+        std::size_t c = 0;
+        for (std::size_t p = json.find(needle); p != std::string::npos; p = json.find(needle, p + 1)) ++c;
+        return c;
+    };
+    REQUIRE(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+    REQUIRE(json.size() > 4 && json.compare(json.size() - 4, 4, "\n]}\n") == 0);
+    REQUIRE(count("\"ph\":") == 1024);
+    REQUIRE(count("\"ph\":\"B\"") == 512 && count("\"ph\":\"E\"") == 512);
+    REQUIRE(count("\"name\":\"scale_step\"") > 0);
+}
+
+int main() {
+    test_scale_sequence();
+    test_project_and_throw();
+    test_ring_concurrent();
+    test_ring_overwrite_and_json();
+    return 0;
+}
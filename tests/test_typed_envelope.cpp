@@ -0,0 +1,270 @@
+// tests/test_typed_envelope.cpp
+// Typed envelope kernels: fp32 / bf16 / fixed16 elements widen exactly,
+// narrowing rounds as documented, membership tests are conservative against
+// an extended-precision reference (never admit a state outside the limits,
+// yet admit one just inside), the §8.4 tolerance shrinks the limits, and an
+// Engine over fp32 steps emits only admissible steps.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/typed_envelope.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+namespace typed = ase::vec::typed;
+using ase::vec::bf16;
+using Fx = ase::vec::fixed16<12>;
+
+template <class T>
+static T narrow(double v) {
+    T out{};
+    REQUIRE(ase::vec::Numeric<T>::narrow(v, out));
+    return out;
+}
+
+template <class T>
+static long double wide(T x) {
+    return static_cast<long double>(ase::vec::Numeric<T>::widen(x));
+}
+
+// Extended-precision ||S + k·dS||2 (compensated in long double)
+template <class TS, class TD>
+static long double ref_next_norm(const TS* S, const TD* dS, long double k, std::size_t n) {
+    long double s = 0.0L, c = 0.0L;
+    for (std::size_t i = 0; i < n; ++i) {
+        const long double v = wide(S[i]) + k * wide(dS[i]);
+        const long double x = v * v;
+        const long double t = s + x;
+        c += (std::fabs(s) >= std::fabs(x)) ? (s - t) + x : (x - t) + s;
+        s = t;
+    }
+    return std::sqrt(s + c);
+}
+
+// |S[i] + k·dS[i]|, or the larger magnitude the host stores: the step as
+// scale_into builds it in TD, then the state as axpy_into writes it in TS
+template <class TS, class TD>
+static std::vector<long double> ref_stored_abs(const TS* S, const TD* dS, double k, std::size_t n) {
+    std::vector<long double> out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double d = static_cast<double>(wide(narrow<TD>(k * ase::vec::Numeric<TD>::widen(dS[i]))));
+        const long double x = wide(narrow<TS>(ase::vec::Numeric<TS>::widen(S[i]) + d));
+        out[i] = std::fmax(std::fabs(wide(S[i]) + static_cast<long double>(k) * wide(dS[i])), std::fabs(x));
+    }
+    return out;
+}
+
+static long double ref_norm(const std::vector<long double>& a) {
+    long double s = 0.0L;
+    for (long double v : a) s += v * v;
+    return std::sqrt(s);
+}
+
+static void test_conversions() {
+    REQUIRE(bf16::from_float(1.0f).bits == 0x3F80);
+    REQUIRE(bf16::from_float(1.0f + 0x1p-8f).bits == 0x3F80);        // tie => even
+    REQUIRE(bf16::from_float(1.0f + 3 * 0x1p-8f).bits == 0x3F82);    // tie => even
+    REQUIRE(bf16::from_float(1.0f + 0x1p-8f + 0x1p-20f).bits == 0x3F81);
+    REQUIRE(std::isnan(bf16::from_float(std::numeric_limits<float>::quiet_NaN()).to_float()));
+    REQUIRE(bf16::from_float(-2.5f).to_float() == -2.5f);
+
+    bf16 b;
+    REQUIRE(!ase::vec::Numeric<bf16>::narrow(1e39, b)); // overflows binary32
+    float fl;
+    REQUIRE(!ase::vec::Numeric<float>::narrow(std::numeric_limits<double>::infinity(), fl));
+
+    REQUIRE(narrow<Fx>(1.5).raw == 6144);
+    REQUIRE(narrow<Fx>(1.5 / 4096).raw == 2);   // half away from zero
+    REQUIRE(narrow<Fx>(-1.5 / 4096).raw == -2);
+    REQUIRE(ase::vec::Numeric<Fx>::widen(narrow<Fx>(-7.25)) == -7.25);
+    Fx f;
+    REQUIRE(!ase::vec::Numeric<Fx>::narrow(8.0, f)); // outside [-8, 8)
+    REQUIRE(!ase::vec::Numeric<Fx>::narrow(std::numeric_limits<double>::quiet_NaN(), f));
+}
+
+template <class T>
+static void check_conservative(std::uint32_t seed) {
+    const std::size_t n = 1000;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    for (int trial = 0; trial < 50; ++trial) {
+        std::vector<T> S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = narrow<T>(0.05 * u(rng));
+            dS[i] = narrow<T>(0.02 * u(rng));
+        }
+        const double R = static_cast<double>(ref_next_norm(S.data(), dS.data(), 1.0L, n));
+
+        ase::vec::BlockLimits lim;
+        lim.l2 = R * (1.0 - 1e-13); // exact next state is outside
+        REQUIRE(!typed::next_within(S.data(), dS.data(), n, lim));
+
+        // inside by far more than the rounding, stored next state included
+        const double Rs = static_cast<double>(ref_norm(ref_stored_abs(S.data(), dS.data(), 1.0, n)));
+        lim.l2 = Rs * (1.0 + 1e-9);
+        REQUIRE(typed::next_within(S.data(), dS.data(), n, lim));
+
+        // Explicit tolerance shrinks the ball
+        REQUIRE(!typed::next_within(S.data(), dS.data(), n, lim, 1e-6));
+        REQUIRE(typed::next_within(S.data(), dS.data(), n, ase::vec::BlockLimits{}, 1e-6));
+
+        // Scaled candidate without building it
+        const double k = 0.375;
+        const double Rk = static_cast<double>(ref_next_norm(S.data(), dS.data(), k, n));
+        lim.l2 = Rk * (1.0 - 1e-13);
+        REQUIRE(!typed::next_scaled_within(S.data(), dS.data(), k, n, lim));
+        lim.l2 = static_cast<double>(ref_norm(ref_stored_abs(S.data(), dS.data(), k, n))) * (1.0 + 1e-9);
+        REQUIRE(typed::next_scaled_within(S.data(), dS.data(), k, n, lim));
+
+        // L∞ at the largest |S + dS|
+        long double m = 0.0L;
+        for (std::size_t i = 0; i < n; ++i) m = std::fmax(m, std::fabs(wide(S[i]) + wide(dS[i])));
+        ase::vec::BlockLimits box;
+        box.linf = static_cast<double>(m) * (1.0 - 1e-13);
+        REQUIRE(!typed::next_within(S.data(), dS.data(), n, box));
+        long double ms = 0.0L;
+        for (long double v : ref_stored_abs(S.data(), dS.data(), 1.0, n)) ms = std::fmax(ms, v);
+        box.linf = static_cast<double>(ms) * (1.0 + 1e-9);
+        REQUIRE(typed::next_within(S.data(), dS.data(), n, box));
+    }
+
+    // Sum of squares matches the extended reference closely
+    std::vector<T> x(n);
+    for (std::size_t i = 0; i < n; ++i) x[i] = narrow<T>(u(rng));
+    const long double ref = ref_next_norm(x.data(), x.data(), 0.0L, n);
+    REQUIRE(std::fabs(std::sqrt(typed::sum_squares(x.data(), n)) - static_cast<double>(ref)) <= 1e-15 * ref);
+}
+
+static void test_non_finite_and_mixed_types() {
+    std::vector<float> S(64, 0.0f), dS(64, 0.01f);
+    REQUIRE(typed::next_within(S.data(), dS.data(), 64, ase::vec::BlockLimits{}));
+    dS[17] = std::numeric_limits<float>::infinity();
+    REQUIRE(!typed::next_within(S.data(), dS.data(), 64, ase::vec::BlockLimits{}));
+    REQUIRE(!typed::all_finite(dS.data(), 64));
+
+    // fp32 state with bf16 / fixed16 steps
+    std::vector<bf16> b(64, bf16::from_float(0.25f));
+    std::vector<Fx> q(64, narrow<Fx>(0.25));
+    ase::vec::BlockLimits lim;
+    lim.l2 = 2.0 + 1e-9; // ||0.25 · 1_64|| = 2
+    REQUIRE(typed::next_within(S.data(), b.data(), 64, lim));
+    REQUIRE(typed::next_within(S.data(), q.data(), 64, lim));
+    lim.l2 = 2.0;        // exactly on the boundary: rounding cannot be ruled out
+    REQUIRE(!typed::next_within(S.data(), q.data(), 64, lim, 1e-12));
+
+    // Sign prefix, conservatively
+    ase::vec::BlockLimits sign;
+    sign.sign_prefix = 8;
+    std::vector<float> neg(64, 0.0f);
+    REQUIRE(typed::next_within(S.data(), neg.data(), 64, sign));
+    neg[3] = -1e-30f;
+    REQUIRE(!typed::next_within(S.data(), neg.data(), 64, sign));
+
+    // Bad tolerance fails closed
+    REQUIRE(!typed::next_within(S.data(), q.data(), 64, ase::vec::BlockLimits{}, -1.0));
+    REQUIRE(!typed::next_within(S.data(), q.data(), 64, ase::vec::BlockLimits{}, 1.0));
+}
+
+// bf16 at the boundary: S + k·base is inside, but the step scale_into
+// builds and the state axpy_into stores round outside
+static void test_bf16_stored_boundary() {
+    const std::size_t n = 64;
+    const double k = 0.6;
+    std::vector<bf16> S(n, bf16::from_float(1.0f));
+    std::vector<bf16> base(n, bf16::from_float(0x1p-7f));
+    // exact step 0.0046875 -> bf16 0.00469971; next 1.0046875 -> bf16 1.0078125
+
+    ase::vec::BlockLimits box;
+    box.linf = 1.005;
+    REQUIRE(!typed::next_scaled_within(S.data(), base.data(), k, n, box));
+    ase::vec::BlockLimits ball;
+    ball.l2 = 8.0 * 1.005; // ||1.005 · 1_64||
+    REQUIRE(!typed::next_scaled_within(S.data(), base.data(), k, n, ball));
+    ase::vec::BlockLimits step;
+    step.step_linf = 0.00469;
+    REQUIRE(!typed::next_scaled_within(S.data(), base.data(), k, n, step));
+
+    // Just above the stored values: admitted, and what the host stores
+    // really is inside
+    box.linf = 1.0078125 * (1.0 + 1e-12);
+    ball.l2 = 8.0 * box.linf;
+    step.step_linf = 0.0046997070312500 * (1.0 + 1e-12);
+    REQUIRE(typed::next_scaled_within(S.data(), base.data(), k, n, box));
+    REQUIRE(typed::next_scaled_within(S.data(), base.data(), k, n, ball));
+    REQUIRE(typed::next_scaled_within(S.data(), base.data(), k, n, step));
+
+    std::vector<bf16> dS(n);
+    REQUIRE(typed::scale_into(base.data(), k, dS.data(), n));
+    REQUIRE(typed::axpy_into(S.data(), 1.0, dS.data(), n));
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(wide(dS[i]) <= step.step_linf);
+        REQUIRE(wide(S[i]) <= box.linf);
+    }
+    REQUIRE(ref_next_norm(S.data(), S.data(), 0.0L, n) <= ball.l2);
+}
+
+// Engine over fp32 steps: only admissible steps leave the engine
+using F32 = std::vector<float>;
+
+static ase::vec::BlockLimits g_lim;
+
+static bool admissible_f32(const F32& S, const F32& dS) {
+    return S.size() == dS.size() && typed::next_within(S.data(), dS.data(), S.size(), g_lim, 1e-9);
+}
+
+static F32 neutral_f32() { return F32{}; }
+
+static bool scale_f32(const F32& in, double k, F32& out) {
+    out.resize(in.size());
+    return typed::scale_into(in.data(), k, out.data(), in.size());
+}
+
+static void test_engine_fp32() {
+    const std::size_t n = 512;
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.step_linf = 0.1;
+
+    const ase::Engine<F32, F32> eng({ase::Mode::Scale, 16, 0.5}, {&admissible_f32, &neutral_f32, &scale_f32, nullptr});
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    int scaled = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        F32 S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = static_cast<float>(0.04 * u(rng));
+            dS[i] = static_cast<float>(0.3 * u(rng));
+        }
+
+        const ase::EnforceOutcome<F32> r = eng.enforce_outcome(S, dS);
+        scaled += (r.kind == ase::Outcome::Scaled);
+        if (r.is_neutral()) continue;
+
+        REQUIRE(ref_next_norm(S.data(), r.step.data(), 1.0L, n) <= 1.0L);
+        for (float d : r.step) REQUIRE(std::fabs(d) <= 0.1f);
+    }
+    REQUIRE(scaled > 100);
+}
+
+int main() {
+    test_conversions();
+    check_conservative<float>(1);
+    check_conservative<bf16>(2);
+    check_conservative<Fx>(3);
+    check_conservative<double>(4);
+    test_non_finite_and_mixed_types();
+    test_bf16_stored_boundary();
+    test_engine_fp32();
+    return 0;
+}
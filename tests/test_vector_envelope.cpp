@@ -0,0 +1,307 @@
+// tests/test_vector_envelope.cpp
+// Vector envelope kernels: membership tests agree with plain scalar loops,
+// reductions are bit-identical to the fixed 8-lane reference order (so every
+// ISA gives the same bits), non-finite input never passes a check.
+// Built twice: native ISA and ASE_VEC_SCALAR.
+#include <cmath>
+#include <cstddef>
+#include <cstdlib> // std::abort
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ase/vector_envelope.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static bool same_bits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Reference for the documented reduction order: lane i % 8, fixed tree
+static double ref_sum_squares(const double* x, std::size_t n) {
+    double l[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (std::size_t i = 0; i < n; ++i) l[i % 8] = l[i % 8] + x[i] * x[i];
+    return ((l[0] + l[4]) + (l[2] + l[6])) + ((l[1] + l[5]) + (l[3] + l[7]));
+}
+
+static bool ref_all_finite(const double* x, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) if (!std::isfinite(x[i])) return false;
+    return true;
+}
+
+static double ref_linf(const double* x, std::size_t n) {
+    double m = 0.0;
+    for (std::size_t i = 0; i < n; ++i) m = std::fmax(m, std::fabs(x[i]));
+    return m;
+}
+
+static bool ref_in_box(const double* x, const double* lo, const double* hi, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(x[i]) || x[i] < lo[i] || x[i] > hi[i]) return false;
+    }
+    return true;
+}
+
+static bool ref_sign_prefix(const double* x, std::size_t k, double eps) {
+    for (std::size_t i = 0; i < k; ++i) {
+        if (!std::isfinite(x[i]) || x[i] < -eps) return false;
+    }
+    return true;
+}
+
+static std::vector<double> random_vec(std::mt19937& rng, std::size_t n, double scale) {
+    std::normal_distribution<double> nd(0.0, scale);
+    std::vector<double> v(n);
+    for (double& x : v) x = nd(rng);
+    return v;
+}
+
+static void test_reductions_match_reference_order() {
+    std::mt19937 rng(12345);
+    for (std::size_t n = 0; n <= 70; ++n) {
+        const std::vector<double> x = random_vec(rng, n, 3.0);
+        const std::vector<double> y = random_vec(rng, n, 3.0);
+
+        REQUIRE(same_bits(ase::vec::sum_squares(x.data(), n), ref_sum_squares(x.data(), n)));
+        REQUIRE(same_bits(ase::vec::l2_norm(x.data(), n), std::sqrt(ref_sum_squares(x.data(), n))));
+
+        std::vector<double> d(n);
+        for (std::size_t i = 0; i < n; ++i) d[i] = x[i] - y[i];
+        REQUIRE(same_bits(ase::vec::l2_norm_diff(x.data(), y.data(), n),
+                          std::sqrt(ref_sum_squares(d.data(), n))));
+
+        REQUIRE(ase::vec::linf_norm(x.data(), n) == ref_linf(x.data(), n));
+        REQUIRE(ase::vec::all_finite(x.data(), n) == ref_all_finite(x.data(), n));
+    }
+
+    const std::vector<double> big = random_vec(rng, 100003, 1.0);
+    REQUIRE(same_bits(ase::vec::sum_squares(big.data(), big.size()),
+                      ref_sum_squares(big.data(), big.size())));
+}
+
+static void test_non_finite_never_admissible() {
+    const double bad[] = {
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity()
+    };
+
+    for (std::size_t n = 1; n <= 33; ++n) {
+        for (std::size_t pos = 0; pos < n; ++pos) {
+            for (double b : bad) {
+                std::vector<double> x(n, 0.1);
+                x[pos] = b;
+                const std::vector<double> lo(n, -1e300);
+                const std::vector<double> hi(n, 1e300);
+                const std::vector<double> zero(n, 0.0);
+
+                REQUIRE(!ase::vec::all_finite(x.data(), n));
+                REQUIRE(!ase::vec::in_l2_ball(x.data(), n, 1e300));
+                REQUIRE(!ase::vec::in_linf_ball(x.data(), n, 1e300));
+                REQUIRE(std::isnan(ase::vec::linf_norm(x.data(), n)));
+                REQUIRE(!ase::vec::in_box(x.data(), lo.data(), hi.data(), n));
+                REQUIRE(!ase::vec::sign_prefix_nonneg(x.data(), n, 1e300));
+
+                // Non-finite in either S or ΔS
+                REQUIRE(!ase::vec::next_in_l2_ball(x.data(), zero.data(), n, 1e300));
+                REQUIRE(!ase::vec::next_in_l2_ball(zero.data(), x.data(), n, 1e300));
+                REQUIRE(!ase::vec::next_in_linf_ball(zero.data(), x.data(), n, 1e300));
+                REQUIRE(!ase::vec::next_in_box(x.data(), zero.data(), lo.data(), hi.data(), n));
+                REQUIRE(!ase::vec::next_sign_prefix_nonneg(zero.data(), x.data(), n, 1e300));
+
+                std::vector<double> out(n);
+                REQUIRE(!ase::vec::scale_into(x.data(), 0.5, out.data(), n));
+                REQUIRE(!ase::vec::add_into(x.data(), zero.data(), out.data(), n));
+            }
+        }
+    }
+
+    // Overflow of the sum of squares of finite values
+    const std::vector<double> huge(9, 1e200);
+    REQUIRE(ase::vec::all_finite(huge.data(), huge.size()));
+    REQUIRE(!ase::vec::in_l2_ball(huge.data(), huge.size(), 1e300));
+
+    // Finite inputs whose sum overflows
+    std::vector<double> out(9);
+    const std::vector<double> big(9, 1.7e308);
+    REQUIRE(!ase::vec::add_into(big.data(), big.data(), out.data(), 9));
+    REQUIRE(!ase::vec::scale_into(big.data(), 2.0, out.data(), 9));
+    REQUIRE(!ase::vec::scale_into(big.data(), std::numeric_limits<double>::quiet_NaN(), out.data(), 9));
+}
+
+static void test_membership_matches_scalar_loops() {
+    std::mt19937 rng(777);
+    std::uniform_real_distribution<double> ud(-1.0, 1.0);
+
+    for (int trial = 0; trial < 400; ++trial) {
+        const std::size_t n = 1 + static_cast<std::size_t>(trial % 45);
+        std::vector<double> S(n), dS(n), next(n), lo(n), hi(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = ud(rng);
+            dS[i] = 0.3 * ud(rng);
+            next[i] = S[i] + dS[i];
+            lo[i] = -0.9 + 0.1 * ud(rng);
+            hi[i] = 0.9 + 0.1 * ud(rng);
+        }
+        if (trial % 3 == 0) hi[n / 2] = next[n / 2];  // boundary is inside
+        if (trial % 5 == 0) lo[n - 1] = next[n - 1];
+
+        const double R = 0.2 + 0.1 * static_cast<double>(trial % 40);
+        const std::size_t k = static_cast<std::size_t>(trial) % (n + 1);
+        const double eps = (trial % 2) ? 0.0 : 0.05;
+
+        REQUIRE(ase::vec::in_l2_ball(next.data(), n, R) ==
+                (std::sqrt(ref_sum_squares(next.data(), n)) <= R));
+        REQUIRE(ase::vec::in_linf_ball(next.data(), n, R) == (ref_linf(next.data(), n) <= R));
+        REQUIRE(ase::vec::in_box(next.data(), lo.data(), hi.data(), n) ==
+                ref_in_box(next.data(), lo.data(), hi.data(), n));
+        REQUIRE(ase::vec::sign_prefix_nonneg(next.data(), k, eps) == ref_sign_prefix(next.data(), k, eps));
+
+        // Fused next-state variants agree with the materialized next state
+        REQUIRE(ase::vec::next_in_l2_ball(S.data(), dS.data(), n, R) ==
+                ase::vec::in_l2_ball(next.data(), n, R));
+        REQUIRE(ase::vec::next_in_linf_ball(S.data(), dS.data(), n, R) ==
+                ase::vec::in_linf_ball(next.data(), n, R));
+        REQUIRE(ase::vec::next_in_box(S.data(), dS.data(), lo.data(), hi.data(), n) ==
+                ase::vec::in_box(next.data(), lo.data(), hi.data(), n));
+        REQUIRE(ase::vec::next_sign_prefix_nonneg(S.data(), dS.data(), k, eps) ==
+                ase::vec::sign_prefix_nonneg(next.data(), k, eps));
+
+        std::vector<double> out(n);
+        REQUIRE(ase::vec::add_into(S.data(), dS.data(), out.data(), n));
+        for (std::size_t i = 0; i < n; ++i) REQUIRE(same_bits(out[i], next[i]));
+
+        // In place
+        REQUIRE(ase::vec::scale_into(dS.data(), 0.25, dS.data(), n));
+        REQUIRE(ase::vec::add_into(S.data(), dS.data(), out.data(), n));
+        for (std::size_t i = 0; i < n; ++i) REQUIRE(same_bits(out[i], S[i] + dS[i]));
+    }
+}
+
+static void test_array_overloads() {
+    std::array<double, 12> a{};
+    std::array<double, 12> b{};
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = 0.5 * static_cast<double>(i);
+        b[i] = -0.25 * static_cast<double>(i);
+    }
+
+    std::array<double, 12> c{};
+    REQUIRE(ase::vec::add_into(a, b, c));
+    REQUIRE(ase::vec::scale_into(c, 2.0, c));
+    REQUIRE(same_bits(ase::vec::l2_norm_diff(a, b), ase::vec::l2_norm_diff(a.data(), b.data(), a.size())));
+    REQUIRE(ase::vec::all_finite(c));
+    REQUIRE(ase::vec::linf_norm(c) == 5.5);
+    REQUIRE(same_bits(ase::vec::l2_norm(c), std::sqrt(ref_sum_squares(c.data(), c.size()))));
+}
+
+static bool ref_within(const double* x, const double* dS, std::size_t n, const ase::vec::BlockLimits& lim) {
+    if (!std::isfinite(ref_sum_squares(x, n))) return false;
+    if (!(std::sqrt(ref_sum_squares(x, n)) <= lim.l2)) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::fabs(x[i]) > lim.linf) return false;
+        if (dS && std::fabs(dS[i]) > lim.step_linf) return false;
+        if (i < lim.sign_prefix && x[i] < lim.sign_floor) return false;
+    }
+    return true;
+}
+
+static void test_blocked_matches_unblocked() {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> ud(-1.0, 1.0);
+
+    const std::size_t blocks[] = {1, 8, 13, 64, 4096};
+    for (int trial = 0; trial < 300; ++trial) {
+        const std::size_t n = static_cast<std::size_t>(trial * 7 % 300);
+        std::vector<double> S(n), dS(n), next(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = 0.1 * ud(rng) + 0.05;
+            dS[i] = 0.05 * ud(rng);
+            next[i] = S[i] + dS[i];
+        }
+        if (n > 0 && trial % 11 == 0) dS[trial % n] = std::numeric_limits<double>::quiet_NaN();
+        if (n > 0 && trial % 11 == 0) next[trial % n] = S[trial % n] + dS[trial % n];
+
+        ase::vec::BlockLimits lim;
+        lim.l2 = 0.02 * static_cast<double>(trial % 60);
+        lim.linf = (trial % 3) ? HUGE_VAL : 0.15;
+        lim.step_linf = (trial % 5) ? HUGE_VAL : 0.04;
+        lim.sign_prefix = static_cast<std::size_t>(trial % 20);
+        lim.sign_floor = (trial % 2) ? 0.0 : -0.01;
+
+        const bool want_x = ref_within(next.data(), nullptr, n, lim);
+        const bool want_next = ref_within(next.data(), dS.data(), n, lim);
+        for (std::size_t b : blocks) {
+            REQUIRE(ase::vec::within_blocked(next.data(), n, lim, b) == want_x);
+            REQUIRE(ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, b) == want_next);
+        }
+    }
+
+    // Radius exactly at the norm: the blocked norm has the same bits as l2_norm
+    std::vector<double> x(100003);
+    for (double& v : x) v = ud(rng);
+    ase::vec::BlockLimits lim;
+    lim.l2 = ase::vec::l2_norm(x.data(), x.size());
+    REQUIRE(ase::vec::within_blocked(x.data(), x.size(), lim, 1000));
+    lim.l2 = std::nextafter(lim.l2, 0.0);
+    REQUIRE(!ase::vec::within_blocked(x.data(), x.size(), lim, 1000));
+}
+
+static void test_blocked_early_exit() {
+    const std::size_t n = std::size_t(1) << 20;
+    std::vector<double> S(n, 1e-4);
+    std::vector<double> dS(n, 1e-5);
+
+    ase::vec::BlockLimits lim;
+    lim.l2 = 1.0;
+    lim.linf = 0.5;
+    lim.sign_prefix = 8;
+
+    std::size_t scanned = 0;
+    REQUIRE(ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == n);
+
+    // Inf inside the sign prefix (e.g. dS[0] = inf injection): no norm work at all
+    dS[0] = std::numeric_limits<double>::infinity();
+    REQUIRE(!ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == 0);
+    dS[0] = 1e-5;
+
+    // NaN in the first block stops after one block
+    dS[100] = std::numeric_limits<double>::quiet_NaN();
+    REQUIRE(!ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == 4096);
+    dS[100] = 1e-5;
+
+    // Sign prefix violated: no norm work at all
+    dS[3] = -1.0;
+    REQUIRE(!ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == 0);
+    dS[3] = 1e-5;
+
+    // L∞ violation in the third block
+    dS[2 * 4096 + 17] = 0.9;
+    REQUIRE(!ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == 3 * 4096);
+    dS[2 * 4096 + 17] = 1e-5;
+
+    // Partial L2 norm already above the radius
+    for (std::size_t i = 0; i < 4096; ++i) S[i] = 0.4;
+    REQUIRE(!ase::vec::next_within_blocked(S.data(), dS.data(), n, lim, 4096, &scanned));
+    REQUIRE(scanned == 4096);
+}
+
+int main() {
+    test_reductions_match_reference_order();
+    test_non_finite_never_admissible();
+    test_membership_matches_scalar_loops();
+    test_array_overloads();
+    test_blocked_matches_unblocked();
+    test_blocked_early_exit();
+    return 0;
+}
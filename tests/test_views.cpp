@@ -0,0 +1,244 @@
+// tests/test_views.cpp
+// Zero-copy views: Engine<StateView, ScaledStepView> gives the same effective
+// step as a copying std::vector engine, scaling is lazy (k only), the step is
+// materialized once on apply, and views work over mmap'd files.
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib> // std::abort
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "ase/ase.hpp"
+#include "ase/mapped_file.hpp"
+#include "ase/vector_envelope.hpp"
+#include "ase/views.hpp"
+
+// Always-on check (works in Release; unlike assert it is NOT compiled out)
+static void REQUIRE(bool cond) {
+    if (!cond) std::abort();
+}
+
+static_assert(std::is_trivially_copyable<ase::ScaledStepView>::value, "views must be cheap to copy");
+static_assert(std::is_trivially_copyable<ase::StateView>::value, "views must be cheap to copy");
+
+static ase::vec::BlockLimits g_lim;
+
+// View hooks
+static bool admissible_view(const ase::StateView& S, const ase::ScaledStepView& dS) {
+    return ase::next_within_blocked(S, dS, g_lim);
+}
+
+// Copying reference hooks
+using Vec = std::vector<double>;
+
+static bool admissible_vec(const Vec& S, const Vec& dS) {
+    return dS.size() == S.size() && ase::vec::next_within_blocked(S.data(), dS.data(), S.size(), g_lim);
+}
+
+static Vec g_zero;
+
+static Vec neutral_vec() { return g_zero; }
+
+static bool scale_vec(const Vec& in, double k, Vec& out) {
+    out.resize(in.size());
+    return ase::vec::scale_into(in.data(), k, out.data(), in.size());
+}
+
+static void test_matches_copying_engine() {
+    const std::size_t n = 1000;
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.step_linf = 0.05;
+    g_lim.sign_prefix = 4;
+    g_zero.assign(n, 0.0);
+
+    const ase::Config cfgs[] = {
+        {ase::Mode::Reject},
+        {ase::Mode::Scale, 16, 0.5},
+        {ase::Mode::Scale, 20, 0.5, ase::ScaleSearch::Bisection, 1e-4},
+    };
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+
+    for (const ase::Config& cfg : cfgs) {
+        const ase::Engine<ase::StateView, ase::ScaledStepView> views(
+            cfg, {&admissible_view, &ase::neutral_view, &ase::scale_view, nullptr});
+        const ase::Engine<Vec, Vec> copies(cfg, {&admissible_vec, &neutral_vec, &scale_vec, nullptr});
+
+        for (int trial = 0; trial < 200; ++trial) {
+            Vec S(n), dS(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                S[i] = 0.02 * u(rng) + 0.02;
+                dS[i] = ((trial % 3) ? 0.2 : 0.01) * u(rng);
+            }
+            if (trial % 17 == 0) dS[trial % n] = std::numeric_limits<double>::quiet_NaN();
+
+            const ase::ScaledStepView eff =
+                views.enforce({S.data(), n}, ase::ScaledStepView::of({dS.data(), n}));
+            const Vec ref = copies.enforce(S, dS);
+
+            REQUIRE(eff.is_zero() || eff.base == dS.data()); // still a view of the proposal
+
+            Vec got(n);
+            REQUIRE(ase::materialize(eff, got.data(), n));
+            REQUIRE(got == ref);
+
+            // Applying in place equals S + materialized step
+            Vec applied = S;
+            REQUIRE(ase::apply_step(eff, applied.data(), n));
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(applied[i] == (eff.is_zero() ? S[i] : S[i] + eff.k * dS[i]));
+            }
+        }
+    }
+}
+
+static int g_vec_scale_calls = 0;
+
+static bool scale_vec_counted(const Vec& in, double k, Vec& out) {
+    ++g_vec_scale_calls;
+    return scale_vec(in, k, out);
+}
+
+static bool admissible_vec_scaled(const Vec& S, const Vec& base, double k) {
+    return base.size() == S.size() &&
+           ase::vec::next_scaled_within_blocked(S.data(), base.data(), k, S.size(), g_lim);
+}
+
+// Lazy Scale mode on a vector Step: same result, one materialization
+static void test_lazy_scaled_vector() {
+    const std::size_t n = 777;
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0;
+    g_lim.step_linf = 0.05;
+    g_zero.assign(n, 0.0);
+
+    ase::Dependencies<Vec, Vec> deps{&admissible_vec, &neutral_vec, &scale_vec_counted, nullptr};
+    const ase::Engine<Vec, Vec> eager({ase::Mode::Scale, 16, 0.5}, deps);
+    deps.is_admissible_scaled = &admissible_vec_scaled;
+    const ase::Engine<Vec, Vec> lazy({ase::Mode::Scale, 16, 0.5}, deps);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (int trial = 0; trial < 100; ++trial) {
+        Vec S(n), dS(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            S[i] = 0.03 * u(rng);
+            dS[i] = 0.3 * u(rng);
+        }
+
+        g_vec_scale_calls = 0;
+        const ase::EnforceOutcome<Vec> a = eager.enforce_outcome(S, dS);
+        const int eager_calls = g_vec_scale_calls;
+
+        g_vec_scale_calls = 0;
+        const ase::EnforceOutcome<Vec> b = lazy.enforce_outcome(S, dS);
+        REQUIRE(a.step == b.step && a.kind == b.kind && a.k == b.k && a.attempts == b.attempts);
+        REQUIRE(g_vec_scale_calls <= 1);
+        REQUIRE(a.kind != ase::Outcome::Scaled || eager_calls == a.attempts);
+    }
+}
+
+static void test_view_hooks() {
+    const double base[3] = {1.0, -2.0, 4.0};
+    const ase::ScaledStepView v = ase::ScaledStepView::of({base, 3});
+
+    ase::ScaledStepView h{};
+    REQUIRE(ase::scale_view(v, 0.5, h));
+    REQUIRE(h.base == base && h.k == 0.5 && h[1] == -1.0);
+    REQUIRE(ase::scale_view(h, 0.5, h));
+    REQUIRE(h.k == 0.25);
+    REQUIRE(!ase::scale_view(v, std::numeric_limits<double>::infinity(), h));
+
+    // Zero step: base never read, equal regardless of base/size
+    const ase::ScaledStepView z = ase::neutral_view();
+    REQUIRE(z.is_zero() && z[2] == 0.0);
+    REQUIRE(z == (ase::ScaledStepView{base, 3, 0.0}));
+    REQUIRE(z != v);
+
+    double state[3] = {1.0, 2.0, 3.0};
+    REQUIRE(ase::apply_step(z, state, 3));
+    REQUIRE(state[0] == 1.0 && state[2] == 3.0);
+    REQUIRE(!ase::apply_step(v, state, 2)); // size mismatch, untouched
+    REQUIRE(state[0] == 1.0);
+
+    double out[3] = {9.0, 9.0, 9.0};
+    REQUIRE(ase::materialize(z, out, 3));
+    REQUIRE(out[0] == 0.0 && out[1] == 0.0 && out[2] == 0.0);
+}
+
+static void test_mapped_file() {
+    const std::size_t n = 5000;
+    char path_s[] = "/tmp/ase_views_state_XXXXXX";
+    char path_d[] = "/tmp/ase_views_step_XXXXXX";
+
+#if defined(ASE_HAS_MMAP)
+    const int fd_s = ::mkstemp(path_s);
+    const int fd_d = ::mkstemp(path_d);
+    REQUIRE(fd_s >= 0 && fd_d >= 0);
+    ::close(fd_s);
+    ::close(fd_d);
+
+    {
+        Vec S(n, 0.001), dS(n, 0.02);
+        std::FILE* f = std::fopen(path_s, "wb");
+        REQUIRE(f && std::fwrite(S.data(), sizeof(double), n, f) == n);
+        std::fclose(f);
+        f = std::fopen(path_d, "wb");
+        REQUIRE(f && std::fwrite(dS.data(), sizeof(double), n, f) == n);
+        std::fclose(f);
+    }
+
+    ase::MappedFile state;
+    ase::MappedFile step;
+    REQUIRE(state.open(path_s, ase::MappedFile::Access::ReadWrite));
+    REQUIRE(step.open(path_d));
+    REQUIRE(state.size() == n && step.size() == n);
+    REQUIRE(step.mutable_data() == nullptr);
+
+    g_lim = ase::vec::BlockLimits{};
+    g_lim.l2 = 1.0; // ||S + dS|| ≈ 1.49 => must scale
+
+    const ase::Engine<ase::StateView, ase::ScaledStepView> eng(
+        {ase::Mode::Scale, 16, 0.5}, {&admissible_view, &ase::neutral_view, &ase::scale_view, nullptr});
+
+    const ase::ScaledStepView eff = eng.enforce(state.state_view(), ase::ScaledStepView::of(step.step_view()));
+    REQUIRE(eff.k == 0.5);
+    REQUIRE(eff.base == step.data());
+
+    // S ⊕ ΔS' written straight into the mapped parameter file
+    REQUIRE(ase::apply_step(eff, state.mutable_data(), state.size()));
+    state.close();
+
+    ase::MappedFile reread;
+    REQUIRE(reread.open(path_s));
+    REQUIRE(reread.data()[0] == 0.001 + 0.5 * 0.02);
+    REQUIRE(ase::vec::l2_norm(reread.data(), reread.size()) <= 1.0);
+
+    ase::MappedFile moved = std::move(reread);
+    REQUIRE(moved.is_open() && !reread.is_open());
+    REQUIRE(reread.state_view().size == 0);
+
+    std::remove(path_s);
+    std::remove(path_d);
+
+    ase::MappedFile missing;
+    REQUIRE(!missing.open("/nonexistent/ase/params.f64"));
+#else
+    (void)n;
+    (void)path_s;
+    (void)path_d;
+#endif
+}
+
+int main() {
+    test_matches_copying_engine();
+    test_lazy_scaled_vector();
+    test_view_hooks();
+    test_mapped_file();
+    return 0;
+}